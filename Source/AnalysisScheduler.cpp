@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    AnalysisScheduler.cpp
+    Created: 19 Oct 2026 6:14:51pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "AnalysisScheduler.h"
+
+//==============================================================================
+class AnalysisScheduler::Worker  : public juce::Thread
+{
+public:
+    Worker (AnalysisScheduler& s, int index)
+        : juce::Thread("Imagination analysis " + juce::String(index)), scheduler(s)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            Priority priority = Priority::hidden;
+            int msUntilNextDue = 0;
+
+            if (auto* client = scheduler.takeNextDueClient(priority, msUntilNextDue))
+            {
+                client->runAnalysis(priority);
+                scheduler.finishedRunning(*client, priority);
+            }
+            else
+            {
+                wait(juce::jlimit(1, 50, msUntilNextDue));
+            }
+        }
+    }
+
+private:
+    AnalysisScheduler& scheduler;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+AnalysisScheduler::AnalysisScheduler()
+{
+    const int numWorkers = juce::jlimit(1, 4, juce::SystemStats::getNumCpus() / 2);
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add(new Worker(*this, i + 1))->startThread();
+}
+
+AnalysisScheduler::~AnalysisScheduler()
+{
+    for (auto* worker : workers)
+        worker->signalThreadShouldExit();
+
+    for (auto* worker : workers)
+        worker->stopThread(1000);
+
+    jassert(clients.isEmpty());
+}
+
+int AnalysisScheduler::getIntervalMs (Priority priority)
+{
+    switch (priority)
+    {
+        case Priority::focused: return 33;
+        case Priority::visible: return 33;
+        case Priority::hidden:  return 250;
+    }
+
+    return 250;
+}
+
+void AnalysisScheduler::addClient (Client& client)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        client.nextDueMs = juce::Time::getMillisecondCounter();
+        client.isRunning = false;
+        clients.addIfNotAlreadyThere(&client);
+    }
+
+    for (auto* worker : workers)
+        worker->notify();
+}
+
+void AnalysisScheduler::removeClient (Client& client)
+{
+    for (;;)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+
+            if (! client.isRunning)
+            {
+                clients.removeFirstMatchingValue(&client);
+                return;
+            }
+        }
+
+        jobFinished.wait(5);
+    }
+}
+
+AnalysisScheduler::Client* AnalysisScheduler::takeNextDueClient (Priority& priorityToRun, int& msUntilNextDue)
+{
+    const juce::ScopedLock sl(lock);
+    const auto now = juce::Time::getMillisecondCounter();
+
+    Client* best = nullptr;
+    msUntilNextDue = 50;
+
+    for (auto* client : clients)
+    {
+        if (client->isRunning)
+            continue;
+
+        const auto msUntilDue = static_cast<int>(client->nextDueMs - now);
+
+        if (msUntilDue > 0)
+        {
+            msUntilNextDue = juce::jmin(msUntilNextDue, msUntilDue);
+            continue;
+        }
+
+        // Highest priority first, then whoever has been waiting longest
+        if (best == nullptr
+             || client->getPriority() > best->getPriority()
+             || (client->getPriority() == best->getPriority() && static_cast<int>(client->nextDueMs - best->nextDueMs) < 0))
+            best = client;
+    }
+
+    if (best != nullptr)
+    {
+        best->isRunning = true;
+        priorityToRun = best->getPriority();
+    }
+
+    return best;
+}
+
+void AnalysisScheduler::finishedRunning (Client& client, Priority priorityRun)
+{
+    // Hidden runs are already the cheap ones, so only visible runs are
+    // stretched. Either way the client must not wait so long that its input
+    // overflows, which at high sample rates is sooner than the usual interval.
+    int intervalMs = getIntervalMs(priorityRun);
+
+    if (priorityRun != Priority::hidden)
+        intervalMs *= juce::jmax(1, client.getIntervalMultiplier());
+
+    intervalMs = juce::jlimit(1, juce::jmax(1, client.getMaximumIntervalMs()), intervalMs);
+
+    {
+        const juce::ScopedLock sl(lock);
+        client.isRunning = false;
+        client.nextDueMs = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(intervalMs);
+    }
+
+    jobFinished.signal();
+}
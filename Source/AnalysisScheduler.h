@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    AnalysisScheduler.h
+    Created: 19 Oct 2026 6:14:51pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <limits>
+
+//==============================================================================
+/*
+    One pool of analysis threads shared by every editor in the process, held
+    through juce::SharedResourcePointer<AnalysisScheduler>.
+
+    Editors register a Client and keep its priority up to date. Whenever a
+    worker is free it runs the highest-priority client that is due. Hidden
+    clients are due far less often than visible ones, so analysis cost
+    follows the number of meters on screen rather than the number of
+    instances.
+*/
+class AnalysisScheduler
+{
+public:
+    enum class Priority
+    {
+        hidden  = 0,
+        visible = 1,
+        focused = 2
+    };
+
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        // Called on a worker thread, never concurrently with itself
+        virtual void runAnalysis (Priority priority) = 0;
+
+        // How many times the usual interval to wait before the next visible
+        // or focused run. Called from a worker thread after each run.
+        virtual int getIntervalMultiplier() const noexcept { return 1; }
+
+        // The longest the client can go between runs without losing input,
+        // e.g. before its FIFO fills. Caps every interval, hidden included.
+        virtual int getMaximumIntervalMs() const noexcept { return std::numeric_limits<int>::max(); }
+
+        void setPriority (Priority newPriority) noexcept   { priority.store(static_cast<int>(newPriority), std::memory_order_relaxed); }
+        Priority getPriority() const noexcept              { return static_cast<Priority>(priority.load(std::memory_order_relaxed)); }
+
+    private:
+        friend class AnalysisScheduler;
+
+        std::atomic<int> priority { static_cast<int>(Priority::visible) };
+
+        // Guarded by the scheduler's lock
+        juce::uint32 nextDueMs = 0;
+        bool isRunning = false;
+    };
+
+    AnalysisScheduler();
+    ~AnalysisScheduler();
+
+    void addClient (Client&);
+
+    // Blocks until any job already running for this client has finished
+    void removeClient (Client&);
+
+    static int getIntervalMs (Priority);
+
+private:
+    class Worker;
+
+    Client* takeNextDueClient (Priority& priorityToRun, int& msUntilNextDue);
+    void finishedRunning (Client&, Priority priorityRun);
+
+    juce::CriticalSection lock;
+    juce::Array<Client*> clients;
+    juce::WaitableEvent jobFinished;
+    juce::OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisScheduler)
+};
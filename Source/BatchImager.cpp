@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    BatchImager.cpp
+    Created: 20 Oct 2026 8:21:40pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "BatchImager.h"
+
+//==============================================================================
+BatchImager::BatchImager (const std::vector<Configuration>& configurations)
+    : numConfigurations(static_cast<int>(configurations.size()))
+{
+    groups.resize(static_cast<size_t>((numConfigurations + numLanes - 1) / numLanes));
+
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+        auto& group = groups[g];
+        group.firstConfiguration = static_cast<int>(g) * numLanes;
+        group.numUsed = juce::jmin(numLanes, numConfigurations - group.firstConfiguration);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const auto& configuration = configurations[static_cast<size_t>(group.firstConfiguration + juce::jmin(lane, group.numUsed - 1))];
+
+            // The gains come before the stereo stage and are linear, so they fold into the matrix
+            const auto m = StereoImager::getMatrix(configuration.settings);
+            const auto gain = static_cast<double>(configuration.gain);
+
+            group.m00[lane] = static_cast<float>(m[0] * gain);
+            group.m01[lane] = static_cast<float>(m[1] * gain);
+            group.m10[lane] = static_cast<float>(m[2] * gain);
+            group.m11[lane] = static_cast<float>(m[3] * gain);
+            group.exciter[lane] = configuration.settings.exciterAmount;
+        }
+    }
+}
+
+BatchImager::~BatchImager()
+{
+}
+
+bool BatchImager::hasUnsupportedStages (const StereoImagerSettings& settings) noexcept
+{
+    return settings.widthGuard || settings.transientSplit;
+}
+
+void BatchImager::process (const float* left, const float* right, int numSamples,
+                           std::vector<juce::AudioBuffer<float>>& outputs)
+{
+    jassert(static_cast<int>(outputs.size()) >= numConfigurations);
+
+    for (const auto& group : groups)
+        processGroup(group, left, right, numSamples, outputs);
+}
+
+void BatchImager::processGroup (const Group& group, const float* left, const float* right, int numSamples,
+                                std::vector<juce::AudioBuffer<float>>& outputs)
+{
+    // Spare lanes repeat the last configuration, so they can write over it
+    // and keep the stores a fixed width
+    float* outLeft[numLanes];
+    float* outRight[numLanes];
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto& output = outputs[static_cast<size_t>(group.firstConfiguration + juce::jmin(lane, group.numUsed - 1))];
+        outLeft[lane] = output.getWritePointer(0);
+        outRight[lane] = output.getWritePointer(1);
+    }
+
+    int i = 0;
+
+   #if JUCE_USE_SIMD
+    const auto m00 = Lanes::fromRawArray(group.m00);
+    const auto m01 = Lanes::fromRawArray(group.m01);
+    const auto m10 = Lanes::fromRawArray(group.m10);
+    const auto m11 = Lanes::fromRawArray(group.m11);
+    const auto exciter = Lanes::fromRawArray(group.exciter);
+
+    // A block of samples gives one register per sample, lanes across; a
+    // transpose turns that into one run of samples per lane, which is
+    // stored straight to that configuration's output
+    for (; i + numLanes <= numSamples; i += numLanes)
+    {
+        Lanes blockLeft[numLanes], blockRight[numLanes];
+
+        for (int k = 0; k < numLanes; ++k)
+        {
+            const auto l = Lanes::expand(left[i + k]);
+            const auto r = Lanes::expand(right[i + k]);
+
+            blockLeft[k] = m00 * l + m01 * r;
+            blockRight[k] = m10 * l + m11 * r;
+            blockLeft[k] = blockLeft[k] + exciter * blockLeft[k] * blockLeft[k];
+            blockRight[k] = blockRight[k] + exciter * blockRight[k] * blockRight[k];
+        }
+
+        storeTransposed(blockLeft, outLeft, i);
+        storeTransposed(blockRight, outRight, i);
+    }
+   #endif
+
+    // The tail, or everything without SIMD, one configuration at a time
+    for (int lane = 0; lane < group.numUsed; ++lane)
+    {
+        for (int n = i; n < numSamples; ++n)
+        {
+            const float l = left[n];
+            const float r = right[n];
+            const float sampleLeft = group.m00[lane] * l + group.m01[lane] * r;
+            const float sampleRight = group.m10[lane] * l + group.m11[lane] * r;
+            outLeft[lane][n] = sampleLeft + group.exciter[lane] * sampleLeft * sampleLeft;
+            outRight[lane][n] = sampleRight + group.exciter[lane] * sampleRight * sampleRight;
+        }
+    }
+}
+
+#if JUCE_USE_SIMD
+namespace
+{
+    // One overload per native register, picked by its type rather than by
+    // the instruction set macros: an AVX2 build still defines
+    // JUCE_USE_SSE_INTRINSICS but has eight lanes, not four
+   #if JUCE_USE_SSE_INTRINSICS
+    [[maybe_unused]] void storeRows (__m128 (&rows)[4], float* const* lanes, int offset) noexcept
+    {
+        _MM_TRANSPOSE4_PS (rows[0], rows[1], rows[2], rows[3]);
+
+        for (int lane = 0; lane < 4; ++lane)
+            _mm_storeu_ps(lanes[lane] + offset, rows[lane]);
+    }
+   #endif
+
+   #if JUCE_USE_SSE_INTRINSICS && defined (__AVX__)
+    [[maybe_unused]] void storeRows (__m256 (&rows)[8], float* const* lanes, int offset) noexcept
+    {
+        // Pairs, then quads within each 128-bit half, then swap the halves
+        __m256 pairs[8], quads[8];
+
+        for (int k = 0; k < 8; k += 2)
+        {
+            pairs[k] = _mm256_unpacklo_ps(rows[k], rows[k + 1]);
+            pairs[k + 1] = _mm256_unpackhi_ps(rows[k], rows[k + 1]);
+        }
+
+        for (int k = 0; k < 8; k += 4)
+        {
+            quads[k] = _mm256_shuffle_ps(pairs[k], pairs[k + 2], _MM_SHUFFLE (1, 0, 1, 0));
+            quads[k + 1] = _mm256_shuffle_ps(pairs[k], pairs[k + 2], _MM_SHUFFLE (3, 2, 3, 2));
+            quads[k + 2] = _mm256_shuffle_ps(pairs[k + 1], pairs[k + 3], _MM_SHUFFLE (1, 0, 1, 0));
+            quads[k + 3] = _mm256_shuffle_ps(pairs[k + 1], pairs[k + 3], _MM_SHUFFLE (3, 2, 3, 2));
+        }
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            _mm256_storeu_ps(lanes[lane] + offset, _mm256_permute2f128_ps(quads[lane], quads[lane + 4], 0x20));
+            _mm256_storeu_ps(lanes[lane + 4] + offset, _mm256_permute2f128_ps(quads[lane], quads[lane + 4], 0x31));
+        }
+    }
+   #endif
+
+   #if JUCE_USE_ARM_NEON
+    [[maybe_unused]] void storeRows (float32x4_t (&rows)[4], float* const* lanes, int offset) noexcept
+    {
+        // Interleave pairs of samples, then take matching halves of the pairs
+        const auto first = vtrnq_f32(rows[0], rows[1]);
+        const auto second = vtrnq_f32(rows[2], rows[3]);
+
+        vst1q_f32(lanes[0] + offset, vcombine_f32(vget_low_f32(first.val[0]), vget_low_f32(second.val[0])));
+        vst1q_f32(lanes[1] + offset, vcombine_f32(vget_low_f32(first.val[1]), vget_low_f32(second.val[1])));
+        vst1q_f32(lanes[2] + offset, vcombine_f32(vget_high_f32(first.val[0]), vget_high_f32(second.val[0])));
+        vst1q_f32(lanes[3] + offset, vcombine_f32(vget_high_f32(first.val[1]), vget_high_f32(second.val[1])));
+    }
+   #endif
+
+    // Any other register: element by element
+    template <typename Register, size_t numRows>
+    void storeRows (Register (&rows)[numRows], float* const* lanes, int offset) noexcept
+    {
+        for (size_t k = 0; k < numRows; ++k)
+            for (size_t lane = 0; lane < numRows; ++lane)
+                lanes[lane][offset + static_cast<int>(k)] = juce::dsp::SIMDRegister<float> (rows[k]).get(lane);
+    }
+}
+
+void BatchImager::storeTransposed (const Lanes (&block)[numLanes], float* const* lanes, int offset) noexcept
+{
+    Lanes::vSIMDType rows[numLanes];
+
+    for (int k = 0; k < numLanes; ++k)
+        rows[k] = block[k].value;
+
+    storeRows(rows, lanes, offset);
+}
+#endif
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    BatchImager.h
+    Created: 20 Oct 2026 8:21:40pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "StereoImager.h"
+
+//==============================================================================
+/*
+    Renders one stereo signal through many imager configurations at once,
+    for preset auditioning and dataset builds.
+
+    Configurations are packed structure-of-arrays, one per SIMD lane: each
+    input sample is broadcast to every lane, and one multiply-add pass runs
+    the gain, the stereo matrix and the exciter for as many configurations
+    as the register holds. Every few samples the registers are transposed,
+    so each lane is stored to its own output as a contiguous run.
+
+    Only the stateless chain is covered (the gains, width, balance,
+    mid/side, crossfeed and exciter at constant settings), which matches
+    processBlock in its realtime configuration. The width guard, the
+    transient split and binaural mode keep state between samples and are
+    ignored here; hasUnsupportedStages() says when a configuration used them.
+*/
+class BatchImager
+{
+public:
+    struct Configuration
+    {
+        StereoImagerSettings settings;
+        float gain = 1.0f;   // input and output gain combined, linear
+    };
+
+    explicit BatchImager (const std::vector<Configuration>& configurations);
+    ~BatchImager();
+
+    int getNumConfigurations() const noexcept { return numConfigurations; }
+
+    static bool hasUnsupportedStages (const StereoImagerSettings& settings) noexcept;
+
+    // outputs[i] receives configuration i and needs two channels of at
+    // least numSamples
+    void process (const float* left, const float* right, int numSamples,
+                  std::vector<juce::AudioBuffer<float>>& outputs);
+
+   #if JUCE_USE_SIMD
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = static_cast<int>(Lanes::SIMDNumElements);
+   #else
+    static constexpr int numLanes = 4;
+   #endif
+
+private:
+    // One lane per configuration; lanes past the last configuration are copies of it
+    struct alignas (64) Group
+    {
+        float m00[numLanes], m01[numLanes], m10[numLanes], m11[numLanes];
+        float exciter[numLanes];
+        int firstConfiguration = 0;
+        int numUsed = 0;
+    };
+
+    void processGroup (const Group& group, const float* left, const float* right, int numSamples,
+                       std::vector<juce::AudioBuffer<float>>& outputs);
+
+   #if JUCE_USE_SIMD
+    // block[k] holds sample offset + k for every lane; writes numLanes
+    // samples to each of lanes[0 .. numLanes - 1], unaligned
+    static void storeTransposed (const Lanes (&block)[numLanes], float* const* lanes, int offset) noexcept;
+   #endif
+
+    int numConfigurations = 0;
+    std::vector<Group> groups;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchImager)
+};
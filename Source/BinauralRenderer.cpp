@@ -0,0 +1,487 @@
+/*
+  ==============================================================================
+
+    BinauralRenderer.cpp
+    Created: 20 Oct 2026 1:06:44pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "BinauralRenderer.h"
+
+#include <cmath>
+
+namespace
+{
+    constexpr double headRadius = 0.0875;     // metres
+    constexpr double speedOfSound = 343.0;    // metres per second
+    constexpr int sincHalfLength = 16;
+
+    // Every response is scaled so a centred mono source comes out at unity
+    // at low frequencies, where ipsi- and contralateral paths sum in phase
+    constexpr double responseGain = 0.5;
+
+    // One ear's response to a source `angle` radians off that ear's axis:
+    // Brown & Duda's one-pole, one-zero head shadow after the spherical
+    // head's frequency-independent delay. The sinc's own half-length is a
+    // bulk delay shared by all four responses, so it does not shift the image.
+    struct EarModel
+    {
+        double delay;          // samples, including the bulk delay
+        double b0, b1, a1;
+    };
+
+    EarModel makeEarModel (double sampleRate, double angle)
+    {
+        const double pi = juce::MathConstants<double>::pi;
+
+        const double delaySeconds = angle < pi * 0.5 ? headRadius / speedOfSound * (1.0 - std::cos(angle))
+                                                     : headRadius / speedOfSound * (1.0 + angle - pi * 0.5);
+
+        // High-frequency gain: about +6 dB facing the ear, -20 dB at 150 degrees
+        const double alpha = 1.05 + 0.95 * std::cos(angle / juce::degreesToRadians(150.0) * pi);
+        const double w0 = speedOfSound / headRadius;
+        const double k = 2.0 * sampleRate;
+
+        // (alpha s + 2 w0) / (s + 2 w0), bilinear transformed
+        const double a0 = k + 2.0 * w0;
+
+        return { sincHalfLength + delaySeconds * sampleRate,
+                 (alpha * k + 2.0 * w0) / a0, (2.0 * w0 - alpha * k) / a0, (2.0 * w0 - k) / a0 };
+    }
+
+    void makeEarResponse (float* destination, int length, double sampleRate, double angle)
+    {
+        const double pi = juce::MathConstants<double>::pi;
+        const auto [delay, b0, b1, a1] = makeEarModel(sampleRate, angle);
+
+        double previousInput = 0.0, previousOutput = 0.0;
+
+        for (int i = 0; i < length; ++i)
+        {
+            // Hann-windowed sinc at the fractional delay
+            const double x = i - delay;
+            double input = 0.0;
+
+            if (std::abs(x) < sincHalfLength)
+            {
+                const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(pi * x) / (pi * x);
+                input = sinc * (0.5 + 0.5 * std::cos(pi * x / sincHalfLength));
+            }
+
+            const double output = b0 * input + b1 * previousInput - a1 * previousOutput;
+            previousInput = input;
+            previousOutput = output;
+
+            destination[i] = static_cast<float>(output * responseGain);
+        }
+    }
+}
+
+//==============================================================================
+/*
+    Builds spare sets for every realtime renderer in the process. It is
+    started by the first realtime prepare and sleeps until a renderer wakes
+    it, so an idle plugin (or a render daemon full of them) has one thread
+    doing nothing rather than one per instance polling.
+*/
+class BinauralRenderer::Builder  : private juce::Thread
+{
+public:
+    Builder()
+        : juce::Thread("Binaural responses")
+    {
+    }
+
+    ~Builder() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread(2000);
+    }
+
+    void add (BinauralRenderer& renderer)
+    {
+        const juce::ScopedLock sl(lock);
+        renderers.addIfNotAlreadyThere(&renderer);
+
+        if (! isThreadRunning())
+            startThread();
+    }
+
+    // Blocks until any build running for this renderer has finished
+    void remove (BinauralRenderer& renderer)
+    {
+        const juce::ScopedLock sl(lock);
+        renderers.removeFirstMatchingValue(&renderer);
+    }
+
+    void wake() noexcept
+    {
+        notify();
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            {
+                const juce::ScopedLock sl(lock);
+
+                for (auto* renderer : renderers)
+                    renderer->buildSpareIfNeeded();
+            }
+
+            // A wake while building leaves the event set, so it is not lost
+            wait(-1);
+        }
+    }
+
+    juce::CriticalSection lock;
+    juce::Array<BinauralRenderer*> renderers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+};
+
+//==============================================================================
+BinauralRenderer::BinauralRenderer()
+{
+}
+
+BinauralRenderer::~BinauralRenderer()
+{
+    builder->remove(*this);
+}
+
+void BinauralRenderer::prepare (const juce::dsp::ProcessSpec& spec, bool isRealtime,
+                                float* crossStorage, float* lowCostStorage, float* fadeStorage, float* historyStorage)
+{
+    // Outside buildLock, which the builder takes under its own lock
+    if (isRealtime)
+        builder->add(*this);
+    else
+        builder->remove(*this);
+
+    const juce::ScopedLock lock(buildLock);
+
+    sampleRate = spec.sampleRate;
+    realtime = isRealtime;
+    stereoSpec = { spec.sampleRate, spec.maximumBlockSize, 2 };
+
+    const bool hasStorage = crossStorage != nullptr && lowCostStorage != nullptr && fadeStorage != nullptr && historyStorage != nullptr;
+    crossChannels = { crossStorage, crossStorage != nullptr ? crossStorage + spec.maximumBlockSize : nullptr };
+    crossCapacity = hasStorage ? spec.maximumBlockSize : 0;
+    lowCostChannels = { lowCostStorage, lowCostStorage != nullptr ? lowCostStorage + spec.maximumBlockSize : nullptr };
+    fadeChannels = { fadeStorage, fadeStorage != nullptr ? fadeStorage + spec.maximumBlockSize : nullptr };
+    fadeCrossChannels = { fadeStorage != nullptr ? fadeStorage + 2 * spec.maximumBlockSize : nullptr,
+                          fadeStorage != nullptr ? fadeStorage + 3 * spec.maximumBlockSize : nullptr };
+    historyChannels = { historyStorage, historyStorage != nullptr ? historyStorage + historyLength : nullptr };
+
+    lowCostMixStep = static_cast<float>(1.0 / juce::jmax(1.0, lowCostFadeSeconds * sampleRate));
+    responseFadeStep = static_cast<float>(1.0 / juce::jmax(1.0, responseFadeSeconds * sampleRate));
+    lowCostAngle = -1.0f;
+
+    // Both sets are rebuilt for the new spec; the spare one again on demand
+    buildEngines(engines[0], speakerAngle.load());
+    engines[1].angle = -1.0f;
+    activeEngines.store(0);
+    spareState.store(spareIdle);
+    responseFade = 0.0f;
+    prepared = true;
+}
+
+size_t BinauralRenderer::getEngineBytesEstimate() noexcept
+{
+    // Laid out as juce::dsp::ConvolutionEngine lays out a uniform partition
+    // of headBlockSize: an FFT of four blocks, a third of it overlap, three
+    // input segments per response segment, and complex (doubled) spectra
+    constexpr size_t fftSize = 4 * headBlockSize;
+    constexpr size_t numSegments = responseLength / (fftSize - headBlockSize) + 1;
+    constexpr size_t floatsPerChannel = fftSize + 2 * fftSize + 2 * fftSize + fftSize
+                                      + 3 * numSegments * 2 * fftSize + numSegments * 2 * fftSize;
+
+    // Two sets, each with two stereo convolutions
+    return 2 * 2 * 2 * floatsPerChannel * sizeof (float);
+}
+
+void BinauralRenderer::reset()
+{
+    if (spareState.load(std::memory_order_acquire) == spareFading)
+        finishResponseFade();
+
+    // Only the active set: an idle spare may be being built right now, and
+    // a ready one has not processed anything yet
+    auto& active = engines[static_cast<size_t>(activeEngines.load(std::memory_order_relaxed))];
+    active.ipsilateral.reset();
+    active.contralateral.reset();
+
+    for (auto* channel : historyChannels)
+        if (channel != nullptr)
+            juce::FloatVectorOperations::clear(channel, historyLength);
+
+    for (auto& path : lowCostPaths)
+        path.previousInput = path.previousOutput = 0.0f;
+
+    lowCostMix = lowCostRequested ? 1.0f : 0.0f;
+}
+
+void BinauralRenderer::setLowCost (bool shouldUseLowCost) noexcept
+{
+    if (shouldUseLowCost == lowCostRequested)
+        return;
+
+    // The convolutions sat idle while the low-cost path ran alone, so their
+    // history is stale; starting them empty is hidden by the fade
+    if (! shouldUseLowCost && lowCostMix >= 1.0f)
+    {
+        auto& active = engines[static_cast<size_t>(activeEngines.load(std::memory_order_relaxed))];
+        active.ipsilateral.reset();
+        active.contralateral.reset();
+    }
+
+    lowCostRequested = shouldUseLowCost;
+}
+
+void BinauralRenderer::setSpeakerAngle (float degrees) noexcept
+{
+    const auto clamped = juce::jlimit(minimumAngle, maximumAngle, degrees);
+
+    if (speakerAngle.exchange(clamped, std::memory_order_relaxed) != clamped)
+        wakeBuilder();
+}
+
+void BinauralRenderer::wakeBuilder() noexcept
+{
+    if (prepared && realtime)
+        builder->wake();
+}
+
+void BinauralRenderer::buildSpareIfNeeded()
+{
+    const juce::ScopedLock lock(buildLock);
+
+    // A spare that is ready or fading is the audio thread's; once the fade
+    // finishes, finishResponseFade() wakes the builder again if needed
+    if (prepared && realtime && spareState.load(std::memory_order_acquire) == spareIdle)
+    {
+        const auto degrees = speakerAngle.load(std::memory_order_relaxed);
+        const int active = activeEngines.load(std::memory_order_relaxed);
+
+        if (degrees != engines[static_cast<size_t>(active)].angle)
+        {
+            buildEngines(engines[static_cast<size_t>(1 - active)], degrees);
+            spareState.store(spareReady, std::memory_order_release);
+        }
+    }
+}
+
+void BinauralRenderer::buildEngines (Engines& target, float degrees)
+{
+    // Speakers at +-degrees from centre, ears at +-90: the nearer ear is
+    // (90 - degrees) off its axis, the further one (90 + degrees)
+    const double ipsilateralAngle = juce::degreesToRadians(90.0 - degrees);
+    const double contralateralAngle = juce::degreesToRadians(90.0 + degrees);
+
+    juce::AudioBuffer<float> ipsilateralResponses(2, responseLength);
+    juce::AudioBuffer<float> contralateralResponses(2, responseLength);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        makeEarResponse(ipsilateralResponses.getWritePointer(channel), responseLength, sampleRate, ipsilateralAngle);
+        makeEarResponse(contralateralResponses.getWritePointer(channel), responseLength, sampleRate, contralateralAngle);
+    }
+
+    // A response loaded before prepare() is installed by it on this thread,
+    // rather than on the convolution's own background thread, and the
+    // convolution starts empty with no crossfade of its own
+    using Convolution = juce::dsp::Convolution;
+    target.ipsilateral.loadImpulseResponse(std::move(ipsilateralResponses), sampleRate, Convolution::Stereo::yes, Convolution::Trim::no, Convolution::Normalise::no);
+    target.contralateral.loadImpulseResponse(std::move(contralateralResponses), sampleRate, Convolution::Stereo::yes, Convolution::Trim::no, Convolution::Normalise::no);
+    target.ipsilateral.prepare(stereoSpec);
+    target.contralateral.prepare(stereoSpec);
+    target.angle = degrees;
+}
+
+void BinauralRenderer::finishResponseFade() noexcept
+{
+    // The old set becomes the spare, free for the builder again
+    const int active = 1 - activeEngines.load(std::memory_order_relaxed);
+    activeEngines.store(active, std::memory_order_relaxed);
+    responseFade = 0.0f;
+    spareState.store(spareIdle, std::memory_order_release);
+
+    // The angle moved again while this set was being built or faded to
+    if (speakerAngle.load(std::memory_order_relaxed) != engines[static_cast<size_t>(active)].angle)
+        wakeBuilder();
+}
+
+void BinauralRenderer::updateLowCostPaths (float degrees) noexcept
+{
+    // Same angles as loadResponses, with the fractional delays interpolated linearly
+    const auto ipsilateralModel = makeEarModel(sampleRate, juce::degreesToRadians(90.0 - degrees));
+    const auto contralateralModel = makeEarModel(sampleRate, juce::degreesToRadians(90.0 + degrees));
+
+    for (size_t i = 0; i < lowCostPaths.size(); ++i)
+    {
+        const auto& model = i < 2 ? ipsilateralModel : contralateralModel;
+        auto& path = lowCostPaths[i];
+
+        path.delay = juce::jlimit(0, historyLength - 2, static_cast<int>(model.delay));
+        path.fraction = static_cast<float>(juce::jlimit(0.0, 1.0, model.delay - path.delay));
+        path.b0 = static_cast<float>(model.b0 * responseGain);
+        path.b1 = static_cast<float>(model.b1 * responseGain);
+        path.a1 = static_cast<float>(model.a1);
+    }
+
+    lowCostAngle = degrees;
+}
+
+//==============================================================================
+void BinauralRenderer::process (const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto block = context.getOutputBlock();
+
+    if (block.getNumChannels() < 2 || block.getNumSamples() > crossCapacity)
+        return;
+
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    auto* left = block.getChannelPointer(0);
+    auto* right = block.getChannelPointer(1);
+
+    // The low-cost path reads the input before the convolutions replace it
+    const bool lowCostActive = lowCostRequested || lowCostMix > 0.0f;
+
+    if (lowCostActive)
+    {
+        if (const auto degrees = speakerAngle.load(std::memory_order_relaxed); degrees != lowCostAngle)
+            updateLowCostPaths(degrees);
+
+        processLowCost(left, right, numSamples);
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            historyChannels[0][historyPosition] = left[i];
+            historyChannels[1][historyPosition] = right[i];
+            historyPosition = (historyPosition + 1) & (historyLength - 1);
+        }
+    }
+
+    auto ears = block.getSubsetChannelBlock(0, 2);
+
+    if (! realtime)
+    {
+        // Offline the angle takes effect at this block boundary in every
+        // render: the new set is built here, then faded to from this block on
+        const auto degrees = speakerAngle.load(std::memory_order_relaxed);
+        const int state = spareState.load(std::memory_order_acquire);
+        const auto active = static_cast<size_t>(activeEngines.load(std::memory_order_relaxed));
+        const auto& latest = state == spareReady ? engines[1 - active] : engines[active];
+
+        if (state != spareFading && degrees != latest.angle)
+        {
+            const juce::ScopedLock lock(buildLock);
+            buildEngines(engines[1 - active], degrees);
+            spareState.store(spareReady, std::memory_order_release);
+        }
+    }
+
+    if (lowCostRequested && lowCostMix >= 1.0f)
+    {
+        // Nothing to fade while the convolutions are idle; the new set just
+        // takes over, and starts empty like the reset ones would
+        if (spareState.load(std::memory_order_acquire) != spareIdle)
+            finishResponseFade();
+
+        juce::FloatVectorOperations::copy(left, lowCostChannels[0], numSamples);
+        juce::FloatVectorOperations::copy(right, lowCostChannels[1], numSamples);
+        return;
+    }
+
+    if (spareState.load(std::memory_order_acquire) == spareReady)
+    {
+        spareState.store(spareFading, std::memory_order_relaxed);
+        responseFade = 0.0f;
+    }
+
+    const bool fading = spareState.load(std::memory_order_relaxed) == spareFading;
+    const auto active = static_cast<size_t>(activeEngines.load(std::memory_order_relaxed));
+
+    // The incoming set renders a copy of the input next to the active one
+    auto incoming = juce::dsp::AudioBlock<float>(fadeChannels.data(), 2, block.getNumSamples());
+
+    if (fading)
+        incoming.copyFrom(ears);
+
+    renderEngines(engines[active], ears, crossChannels.data());
+
+    if (fading)
+    {
+        renderEngines(engines[1 - active], incoming, fadeCrossChannels.data());
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            responseFade = juce::jmin(1.0f, responseFade + responseFadeStep);
+            left[i] += responseFade * (fadeChannels[0][i] - left[i]);
+            right[i] += responseFade * (fadeChannels[1][i] - right[i]);
+        }
+
+        if (responseFade >= 1.0f)
+            finishResponseFade();
+    }
+
+    if (! lowCostActive)
+        return;
+
+    // Both paths ran this block; fade between them a sample at a time
+    const float target = lowCostRequested ? 1.0f : 0.0f;
+    const float step = lowCostRequested ? lowCostMixStep : -lowCostMixStep;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        lowCostMix = step > 0.0f ? juce::jmin(target, lowCostMix + step) : juce::jmax(target, lowCostMix + step);
+        left[i] += lowCostMix * (lowCostChannels[0][i] - left[i]);
+        right[i] += lowCostMix * (lowCostChannels[1][i] - right[i]);
+    }
+}
+
+void BinauralRenderer::renderEngines (Engines& source, juce::dsp::AudioBlock<float> ears, float* const* cross)
+{
+    // The contralateral pair works on a copy; its channels come out with the
+    // ears swapped (left speaker -> right ear in channel 0) and are added back crossed
+    auto crossed = juce::dsp::AudioBlock<float>(cross, 2, ears.getNumSamples());
+    crossed.copyFrom(ears);
+    source.contralateral.process(juce::dsp::ProcessContextReplacing<float>(crossed));
+    source.ipsilateral.process(juce::dsp::ProcessContextReplacing<float>(ears));
+
+    ears.getSingleChannelBlock(0).add(crossed.getSingleChannelBlock(1));
+    ears.getSingleChannelBlock(1).add(crossed.getSingleChannelBlock(0));
+}
+
+void BinauralRenderer::processLowCost (const float* left, const float* right, int numSamples) noexcept
+{
+    auto& [leftToLeft, rightToRight, leftToRight, rightToLeft] = lowCostPaths;
+    auto* leftEar = lowCostChannels[0];
+    auto* rightEar = lowCostChannels[1];
+
+    auto tap = [this](size_t channel, const EarPath& path)
+    {
+        const float newer = historyChannels[channel][(historyPosition - path.delay) & (historyLength - 1)];
+        const float older = historyChannels[channel][(historyPosition - path.delay - 1) & (historyLength - 1)];
+        return newer + path.fraction * (older - newer);
+    };
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        historyChannels[0][historyPosition] = left[i];
+        historyChannels[1][historyPosition] = right[i];
+
+        leftEar[i] = leftToLeft.process(tap(0, leftToLeft)) + rightToLeft.process(tap(1, rightToLeft));
+        rightEar[i] = rightToRight.process(tap(1, rightToRight)) + leftToRight.process(tap(0, leftToRight));
+
+        historyPosition = (historyPosition + 1) & (historyLength - 1);
+    }
+}
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    BinauralRenderer.h
+    Created: 20 Oct 2026 1:06:44pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/*
+    Headphone playback of the stereo output as a pair of virtual speakers.
+
+    Each speaker reaches both ears through a head-related impulse response,
+    so four convolutions run: L->L and R->R (ipsilateral) share one stereo
+    juce::dsp::Convolution, L->R and R->L (contralateral) another. Both use
+    non-uniform partitioning with a short head block, which keeps the
+    latency at zero and the cost per 64-sample buffer small. Every
+    convolution in the process shares one ConvolutionMessageQueue, so they
+    do not start a background thread each.
+
+    The HRIRs come from a spherical head model (Brown & Duda) computed for
+    the speaker angle, so there is no data to ship. There are two sets of
+    convolutions: the active one, and a spare that a new angle is built
+    into. In realtime one builder thread, shared by every renderer in the
+    process, sleeps until a renderer's angle changes and then builds its
+    spare; offline, process() builds it itself at the start of the block. Either way the audio thread then fades from the
+    active set to the spare over responseFadeSeconds, so the swap never
+    clicks and, offline, always lands on the same sample.
+
+    Under CPU pressure the processor can switch to a low-cost path that
+    runs the same model directly: interpolated delays and four one-pole,
+    one-zero filters instead of the convolutions. The two crossfade over
+    lowCostFadeSeconds.
+*/
+class BinauralRenderer
+{
+public:
+    BinauralRenderer();
+    ~BinauralRenderer();
+
+    // Builds the responses for the current angle before returning, so the
+    // first processed block (offline renders included) already uses them.
+    // crossStorage and lowCostStorage each hold 2 * maximumBlockSize floats,
+    // fadeStorage 4 * maximumBlockSize and historyStorage 2 * historyLength;
+    // all belong to the caller (the processor's DspArena).
+    void prepare (const juce::dsp::ProcessSpec& spec, bool isRealtime,
+                  float* crossStorage, float* lowCostStorage, float* fadeStorage, float* historyStorage);
+    void reset();
+
+    // Audio thread; takes effect from the next process() call
+    void setLowCost (bool shouldUseLowCost) noexcept;
+
+    // Degrees either side of centre. Audio thread: stores the angle and, in
+    // realtime and only if it moved, wakes the builder thread (a brief
+    // lock inside juce::WaitableEvent). Offline the next process() call
+    // builds the responses before it renders.
+    void setSpeakerAngle (float degrees) noexcept;
+
+    void process (const juce::dsp::ProcessContextReplacing<float>& context);
+
+    static constexpr int headBlockSize = 64;
+    static constexpr int responseLength = 256;
+
+    static constexpr float minimumAngle = 10.0f;
+    static constexpr float maximumAngle = 90.0f;
+
+    static constexpr double lowCostFadeSeconds = 0.02;
+    static constexpr double responseFadeSeconds = 0.02;
+
+    static constexpr int historyLength = 256;   // a power of two over the longest delay at 192 kHz
+
+    // The convolutions allocate their own partitions, which JUCE does not
+    // report. An estimate of their buffers for both sets, from the
+    // partition sizes; the FFT tables are not included.
+    static size_t getEngineBytesEstimate() noexcept;
+
+private:
+    class Builder;
+
+    // One angle's convolutions
+    struct Engines
+    {
+        Engines (juce::dsp::ConvolutionMessageQueue& queue)
+            : ipsilateral (juce::dsp::Convolution::NonUniform { headBlockSize }, queue),
+              contralateral (juce::dsp::Convolution::NonUniform { headBlockSize }, queue)
+        {
+        }
+
+        juce::dsp::Convolution ipsilateral, contralateral;
+        float angle = -1.0f;
+    };
+
+    // Who owns the spare set: the builder while idle, process() once ready
+    enum SpareState
+    {
+        spareIdle,
+        spareReady,    // built for a new angle, not faded to yet
+        spareFading    // process() is fading from the active set to it
+    };
+
+    void buildSpareIfNeeded();
+    void wakeBuilder() noexcept;
+    void buildEngines (Engines& target, float degrees);
+    void renderEngines (Engines& source, juce::dsp::AudioBlock<float> ears, float* const* cross);
+    void finishResponseFade() noexcept;
+
+    void updateLowCostPaths (float degrees) noexcept;
+    void processLowCost (const float* left, const float* right, int numSamples) noexcept;
+
+    // One ear's filter, fed from a delayed tap of one input channel
+    struct EarPath
+    {
+        int delay = 0;
+        float fraction = 0.0f;
+        float b0 = 0.0f, b1 = 0.0f, a1 = 0.0f;
+        float previousInput = 0.0f, previousOutput = 0.0f;
+
+        float process (float input) noexcept
+        {
+            const float output = b0 * input + b1 * previousInput - a1 * previousOutput;
+            previousInput = input;
+            previousOutput = output;
+            return output;
+        }
+    };
+
+    // Declared before the engines, which hold on to the queue
+    juce::SharedResourcePointer<juce::dsp::ConvolutionMessageQueue> convolutionQueue;
+    juce::SharedResourcePointer<Builder> builder;
+
+    std::array<Engines, 2> engines { { { convolutionQueue.getObject() }, { convolutionQueue.getObject() } } };
+    std::atomic<int> activeEngines { 0 };
+    std::atomic<int> spareState { spareIdle };
+    float responseFade = 0.0f;             // 0 = active set, 1 = spare
+    float responseFadeStep = 1.0f;
+
+    // Held while a set is built; the audio thread only takes it offline.
+    // Taken after the builder's own lock, never before it.
+    juce::CriticalSection buildLock;
+    juce::dsp::ProcessSpec stereoSpec {};
+    bool realtime = true;
+    bool prepared = false;
+
+    std::array<float*, 2> crossChannels {};
+    std::array<float*, 2> fadeChannels {}, fadeCrossChannels {};
+    size_t crossCapacity = 0;
+
+    // Input history is kept up to date even while the convolutions are in
+    // use, so the low-cost path can fade in at any time
+    std::array<float*, 2> historyChannels {};
+    int historyPosition = 0;
+
+    std::array<EarPath, 4> lowCostPaths;   // left to left ear, right to right ear, left to right ear, right to left ear
+    std::array<float*, 2> lowCostChannels {};
+    float lowCostAngle = -1.0f;
+    bool lowCostRequested = false;
+    float lowCostMix = 0.0f;               // 0 = convolutions, 1 = low-cost path
+    float lowCostMixStep = 1.0f;
+
+    std::atomic<float> speakerAngle { 30.0f };
+    double sampleRate = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BinauralRenderer)
+};
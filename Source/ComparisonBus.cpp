@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+    ComparisonBus.cpp
+    Created: 20 Oct 2026 2:21:08pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "ComparisonBus.h"
+
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+ComparisonBus::ComparisonBus()
+{
+}
+
+ComparisonBus::~ComparisonBus()
+{
+}
+
+int ComparisonBus::claim()
+{
+    const juce::ScopedLock sl(registryLock);
+
+    for (int i = 0; i < maxSlots; ++i)
+    {
+        auto& s = slots[static_cast<size_t>(i)];
+
+        if (s.claimed)
+            continue;
+
+        s.claimed = true;
+        s.name.clear();
+        s.frame.frameNumber = 0;
+        s.generation.fetch_add(1, std::memory_order_release);
+        return i;
+    }
+
+    return -1;
+}
+
+void ComparisonBus::release (int slot)
+{
+    if (! juce::isPositiveAndBelow(slot, maxSlots))
+        return;
+
+    const juce::ScopedLock sl(registryLock);
+    auto& s = slots[static_cast<size_t>(slot)];
+    s.claimed = false;
+    s.name.clear();
+    s.generation.fetch_add(1, std::memory_order_release);
+}
+
+void ComparisonBus::setName (int slot, const juce::String& name)
+{
+    if (! juce::isPositiveAndBelow(slot, maxSlots))
+        return;
+
+    const juce::ScopedLock sl(registryLock);
+    slots[static_cast<size_t>(slot)].name = name;
+}
+
+std::vector<ComparisonBus::Publisher> ComparisonBus::getPublishers() const
+{
+    std::vector<Publisher> publishers;
+    const juce::ScopedLock sl(registryLock);
+
+    for (int i = 0; i < maxSlots; ++i)
+    {
+        const auto& s = slots[static_cast<size_t>(i)];
+
+        if (s.claimed && s.name.isNotEmpty())
+            publishers.push_back({ i, s.generation.load(std::memory_order_acquire), s.name });
+    }
+
+    return publishers;
+}
+
+//==============================================================================
+ComparisonFrame& ComparisonBus::beginWrite (int slot) noexcept
+{
+    auto& s = slots[static_cast<size_t>(slot)];
+    s.sequence.store(s.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return s.frame;
+}
+
+void ComparisonBus::endWrite (int slot) noexcept
+{
+    auto& s = slots[static_cast<size_t>(slot)];
+    s.sequence.store(s.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool ComparisonBus::read (const Publisher& publisher, ComparisonFrame& destination) const noexcept
+{
+    if (! juce::isPositiveAndBelow(publisher.slot, maxSlots))
+        return false;
+
+    const auto& s = slots[static_cast<size_t>(publisher.slot)];
+
+    if (s.generation.load(std::memory_order_acquire) != publisher.generation)
+        return false;
+
+    const auto before = s.sequence.load(std::memory_order_acquire);
+
+    if ((before & 1) != 0)
+        return false;
+
+    // Checked after the sequence was sampled: a frame older than what the
+    // reader has (or a slot that was re-claimed meanwhile) is not copied
+    if (s.frame.frameNumber == destination.frameNumber)
+        return false;
+
+    ComparisonFrame copy;
+    std::memcpy(&copy, &s.frame, sizeof(ComparisonFrame));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (s.sequence.load(std::memory_order_relaxed) != before)
+        return false;
+
+    destination = copy;
+    return true;
+}
+
+//==============================================================================
+ComparisonPublisher::ComparisonPublisher()
+{
+}
+
+ComparisonPublisher::~ComparisonPublisher()
+{
+    // Audio has stopped by the time the processor is destroyed
+    publishing.store(false);
+    bus->release(slot.load());
+}
+
+void ComparisonPublisher::prepare (double sampleRate, juce::Point<float>* pointStorage)
+{
+    jassert(sampleRate > 0.0 && pointStorage != nullptr);
+
+    pointRing = pointStorage;
+    samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate / framesPerSecond));
+    lowCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * 250.0 / sampleRate));
+    highCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * 4000.0 / sampleRate));
+
+    samplesInFrame = samplesToSkip = 0;
+    smoothedLeft = smoothedRight = 0.0f;
+    nextPoint = numPoints = 0;
+    sumProduct = sumLeft = sumRight = 0.0f;
+    midLow = midHigh = sideLow = sideHigh = 0.0f;
+    midEnergy.fill(0.0f);
+    sideEnergy.fill(0.0f);
+}
+
+void ComparisonPublisher::setName (const juce::String& name)
+{
+    // The slot is kept for the publisher's lifetime once claimed, so the
+    // audio thread is always its only writer
+    if (name.isNotEmpty() && slot.load() < 0)
+        slot.store(bus->claim());
+
+    bus->setName(slot.load(), name);
+    publishing.store(name.isNotEmpty() && slot.load() >= 0);
+}
+
+void ComparisonPublisher::process (const float* left, const float* right, int numSamples) noexcept
+{
+    if (! publishing.load(std::memory_order_relaxed) || pointRing == nullptr)
+        return;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float l = left[i], r = right[i];
+        const float mid = 0.5f * (l + r);
+        const float side = 0.5f * (l - r);
+
+        midLow += lowCoefficient * (mid - midLow);
+        midHigh += highCoefficient * (mid - midHigh);
+        sideLow += lowCoefficient * (side - sideLow);
+        sideHigh += highCoefficient * (side - sideHigh);
+
+        // The sums only feed ratios, and a power estimate taken from every
+        // other sample of the filtered signal is still unbiased, so at the
+        // reduced rate half of them are skipped. The filters above must not
+        // be: run at half rate they would alias the top band into the others.
+        if (samplesToSkip > 0)
+        {
+            --samplesToSkip;
+        }
+        else
+        {
+            samplesToSkip = stride - 1;
+
+            sumProduct += l * r;
+            sumLeft += l * l;
+            sumRight += r * r;
+
+            const float midBands[] = { midLow, midHigh - midLow, mid - midHigh };
+            const float sideBands[] = { sideLow, sideHigh - sideLow, side - sideHigh };
+
+            for (size_t band = 0; band < ComparisonFrame::numBands; ++band)
+            {
+                midEnergy[band] += midBands[band] * midBands[band];
+                sideEnergy[band] += sideBands[band] * sideBands[band];
+            }
+        }
+
+        // The vectorscope trace, built the same way as EditorAnalysis builds it
+        smoothedLeft += pointSmoothing * (l - smoothedLeft);
+        smoothedRight += pointSmoothing * (r - smoothedRight);
+
+        if (samplesInFrame % pointStride == 0)
+        {
+            float x = smoothedLeft - smoothedRight;
+            float y = -(smoothedLeft + smoothedRight) * 0.5f;
+            const float distance = std::sqrt(x * x + y * y);
+
+            if (distance > 1.0f)
+            {
+                x /= distance;
+                y /= distance;
+            }
+
+            pointRing[nextPoint] = { x, y };
+            nextPoint = (nextPoint + 1) % ComparisonFrame::maxPoints;
+            numPoints = juce::jmin(numPoints + 1, ComparisonFrame::maxPoints);
+        }
+
+        if (++samplesInFrame >= samplesPerFrame)
+            writeFrame();
+    }
+}
+
+void ComparisonPublisher::writeFrame() noexcept
+{
+    const int index = slot.load(std::memory_order_relaxed);
+    auto& frame = bus->beginWrite(index);
+
+    // Oldest point first
+    const int firstPoint = (nextPoint - numPoints + ComparisonFrame::maxPoints) % ComparisonFrame::maxPoints;
+
+    for (int i = 0; i < numPoints; ++i)
+        frame.points[static_cast<size_t>(i)] = pointRing[(firstPoint + i) % ComparisonFrame::maxPoints];
+
+    frame.numPoints = numPoints;
+    frame.correlation = (sumLeft > 0.0f && sumRight > 0.0f) ? sumProduct / (std::sqrt(sumLeft) * std::sqrt(sumRight)) : 0.0f;
+
+    for (size_t band = 0; band < ComparisonFrame::numBands; ++band)
+    {
+        const float total = midEnergy[band] + sideEnergy[band];
+        frame.bandWidth[band] = total > 1.0e-9f ? sideEnergy[band] / total : 0.0f;
+    }
+
+    frame.frameNumber = ++frameNumber;
+    bus->endWrite(index);
+
+    samplesInFrame = 0;
+    numPoints = 0;
+    sumProduct = sumLeft = sumRight = 0.0f;
+    midEnergy.fill(0.0f);
+    sideEnergy.fill(0.0f);
+}
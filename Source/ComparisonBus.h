@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    ComparisonBus.h
+    Created: 20 Oct 2026 2:21:08pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+// One instance's analysis at a moment in time, as published on the bus.
+// Plain data of fixed size, so it is written and copied without allocating.
+struct ComparisonFrame
+{
+    static constexpr int maxPoints = 512;
+    static constexpr int numBands = 3;    // below 250 Hz, 250 Hz - 4 kHz, above 4 kHz
+
+    std::array<juce::Point<float>, maxPoints> points;   // as EditorAnalysis builds them
+    int numPoints = 0;
+    float correlation = 0.0f;
+    std::array<float, numBands> bandWidth {};           // side / (mid + side) energy, 0 = mono
+    juce::uint32 frameNumber = 0;
+};
+
+//==============================================================================
+/*
+    In-process bus that lets an editor overlay another instance's analysis,
+    e.g. a stem against the mix bus or two alternate masters.
+
+    A fixed set of slots, shared by every instance through
+    juce::SharedResourcePointer<ComparisonBus>. Each slot has exactly one
+    writer (the audio thread of the instance that claimed it) and any
+    number of readers. Frames are handed over with a sequence lock: the
+    writer never waits and never allocates, and a reader that catches a
+    frame mid-write just tries again on its next timer tick.
+
+    Slots are claimed and named from the message thread; that bookkeeping
+    is the only part behind a lock.
+*/
+class ComparisonBus
+{
+public:
+    ComparisonBus();
+    ~ComparisonBus();
+
+    static constexpr int maxSlots = 16;
+
+    struct Publisher
+    {
+        int slot = -1;
+        juce::uint32 generation = 0;
+        juce::String name;
+    };
+
+    // Message thread. Returns the claimed slot, or -1 if all are taken.
+    int claim();
+    void release (int slot);
+
+    // Message thread. An empty name hides the slot from getPublishers().
+    void setName (int slot, const juce::String& name);
+
+    // Every named slot, in slot order
+    std::vector<Publisher> getPublishers() const;
+
+    // Writer (audio thread): fill the frame returned by beginWrite(), then call endWrite()
+    ComparisonFrame& beginWrite (int slot) noexcept;
+    void endWrite (int slot) noexcept;
+
+    // Reader, any thread. Copies the slot's latest frame if it is newer than
+    // `destination` and the slot still belongs to the same publisher.
+    // Returns false if nothing new could be read.
+    bool read (const Publisher& publisher, ComparisonFrame& destination) const noexcept;
+
+private:
+    struct Slot
+    {
+        std::atomic<juce::uint32> sequence { 0 };     // odd while a frame is being written
+        std::atomic<juce::uint32> generation { 0 };   // changes whenever the slot is claimed
+        ComparisonFrame frame;
+
+        // Guarded by registryLock
+        bool claimed = false;
+        juce::String name;
+    };
+
+    std::array<Slot, maxSlots> slots;
+    juce::CriticalSection registryLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComparisonBus)
+};
+
+//==============================================================================
+/*
+    The processor's side of the bus. While publishing it analyses every
+    block on the audio thread (correlation, a decimated vectorscope trace
+    and three-band width) and writes a frame framesPerSecond times a second.
+    At the reduced rate the band filters and the trace still see every
+    sample, but only every other one is added into the energy and
+    correlation sums; frames still go out on time.
+    While not publishing, process() is a single flag check.
+*/
+class ComparisonPublisher
+{
+public:
+    ComparisonPublisher();
+    ~ComparisonPublisher();
+
+    static constexpr int framesPerSecond = 30;
+
+    // pointStorage holds ComparisonFrame::maxPoints points and belongs to
+    // the caller (the processor's DspArena)
+    void prepare (double sampleRate, juce::Point<float>* pointStorage);
+
+    // Message thread. An empty name stops publishing.
+    void setName (const juce::String& name);
+    int getSlot() const noexcept { return slot.load(std::memory_order_relaxed); }
+
+    // Audio thread
+    void setReducedRate (bool shouldReduce) noexcept { stride = shouldReduce ? 2 : 1; }
+    void process (const float* left, const float* right, int numSamples) noexcept;
+
+private:
+    void writeFrame() noexcept;
+
+    juce::SharedResourcePointer<ComparisonBus> bus;
+    std::atomic<int> slot { -1 };
+    std::atomic<bool> publishing { false };
+
+    static constexpr float pointSmoothing = 0.05f;
+    static constexpr int pointStride = 4;
+
+    int samplesPerFrame = 1600;
+    int samplesInFrame = 0;
+    int stride = 1, samplesToSkip = 0;
+    juce::uint32 frameNumber = 0;
+
+    float smoothedLeft = 0.0f, smoothedRight = 0.0f;
+    juce::Point<float>* pointRing = nullptr;
+    int nextPoint = 0, numPoints = 0;
+
+    float sumProduct = 0.0f, sumLeft = 0.0f, sumRight = 0.0f;
+
+    // One-pole lowpasses on mid and side split the bands
+    float lowCoefficient = 0.0f, highCoefficient = 0.0f;
+    float midLow = 0.0f, midHigh = 0.0f, sideLow = 0.0f, sideHigh = 0.0f;
+    std::array<float, ComparisonFrame::numBands> midEnergy {}, sideEnergy {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComparisonPublisher)
+};
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    CorrelationHistory.cpp
+    Created: 19 Oct 2026 3:05:22pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "CorrelationHistory.h"
+
+//==============================================================================
+CorrelationHistory::CorrelationHistory (double pointsPerSecondToUse, double maxSpanSecondsToUse,
+                                        int decimationToUse, int numLevels)
+    : pointsPerSecond(pointsPerSecondToUse),
+      maxSpanSeconds(maxSpanSecondsToUse),
+      decimation(juce::jmax(2, decimationToUse)),
+      levels(static_cast<size_t>(juce::jmax(1, numLevels)))
+{
+    double pointsPerEntry = 1.0;
+
+    for (auto& level : levels)
+    {
+        const auto capacity = static_cast<int>(std::ceil(maxSpanSeconds * pointsPerSecond / pointsPerEntry)) + 1;
+        level.data.resize(static_cast<size_t>(juce::jmax(2, capacity)));
+        pointsPerEntry *= decimation;
+    }
+}
+
+CorrelationHistory::~CorrelationHistory()
+{
+}
+
+const CorrelationHistory::Bucket& CorrelationHistory::Level::fromOldest (int index) const noexcept
+{
+    const auto capacity = static_cast<int>(data.size());
+    return data[static_cast<size_t>((writePosition - numStored + index + capacity) % capacity)];
+}
+
+void CorrelationHistory::push (float value) noexcept
+{
+    pushToLevel(0, { value, value, value });
+}
+
+void CorrelationHistory::pushToLevel (size_t levelIndex, const Bucket& bucket) noexcept
+{
+    auto& level = levels[levelIndex];
+    const auto capacity = static_cast<int>(level.data.size());
+
+    level.data[static_cast<size_t>(level.writePosition)] = bucket;
+    level.writePosition = (level.writePosition + 1) % capacity;
+    level.numStored = juce::jmin(level.numStored + 1, capacity);
+
+    if (levelIndex + 1 >= levels.size())
+        return;
+
+    // pending.mean holds the running sum until the aggregate is complete
+    if (level.numPending == 0)
+    {
+        level.pending = bucket;
+    }
+    else
+    {
+        level.pending.min = juce::jmin(level.pending.min, bucket.min);
+        level.pending.max = juce::jmax(level.pending.max, bucket.max);
+        level.pending.mean += bucket.mean;
+    }
+
+    if (++level.numPending == decimation)
+    {
+        auto aggregate = level.pending;
+        aggregate.mean /= static_cast<float>(decimation);
+        level.numPending = 0;
+        pushToLevel(levelIndex + 1, aggregate);
+    }
+}
+
+void CorrelationHistory::clear() noexcept
+{
+    for (auto& level : levels)
+    {
+        level.writePosition = 0;
+        level.numStored = 0;
+        level.numPending = 0;
+    }
+}
+
+int CorrelationHistory::render (double spanSeconds, std::vector<Bucket>& columns) const noexcept
+{
+    const auto numColumns = static_cast<juce::int64>(columns.size());
+
+    if (numColumns == 0)
+        return 0;
+
+    const double pointsInSpan = juce::jlimit(1.0, maxSpanSeconds * pointsPerSecond, spanSeconds * pointsPerSecond);
+    const double pointsPerColumn = pointsInSpan / static_cast<double>(numColumns);
+
+    // Coarsest level that still has at least one entry per column
+    size_t levelIndex = 0;
+    double pointsPerEntry = 1.0;
+
+    while (levelIndex + 1 < levels.size() && pointsPerEntry * decimation <= pointsPerColumn)
+    {
+        ++levelIndex;
+        pointsPerEntry *= decimation;
+    }
+
+    const auto& level = levels[levelIndex];
+    const auto entriesInSpan = static_cast<juce::int64>(juce::jmax(1, juce::roundToInt(pointsInSpan / pointsPerEntry)));
+
+    // The newest entry lands in the rightmost column, so when less history
+    // than the span has been stored this goes negative
+    const auto firstEntry = static_cast<juce::int64>(level.numStored) - entriesInSpan;
+    int firstValidColumn = static_cast<int>(numColumns);
+
+    for (juce::int64 column = 0; column < numColumns; ++column)
+    {
+        auto begin = (column * entriesInSpan) / numColumns;
+        auto end = ((column + 1) * entriesInSpan) / numColumns;
+
+        if (end <= begin)
+            end = begin + 1;
+
+        begin = juce::jmax(static_cast<juce::int64>(0), begin + firstEntry);
+        end += firstEntry;
+
+        if (begin >= end)
+            continue;
+
+        if (firstValidColumn == static_cast<int>(numColumns))
+            firstValidColumn = static_cast<int>(column);
+
+        auto result = level.fromOldest(static_cast<int>(begin));
+        float sum = result.mean;
+
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            const auto& entry = level.fromOldest(static_cast<int>(i));
+            result.min = juce::jmin(result.min, entry.min);
+            result.max = juce::jmax(result.max, entry.max);
+            sum += entry.mean;
+        }
+
+        result.mean = sum / static_cast<float>(end - begin);
+        columns[static_cast<size_t>(column)] = result;
+    }
+
+    return firstValidColumn;
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    CorrelationHistory.h
+    Created: 19 Oct 2026 3:05:22pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/*
+    Fixed-capacity history of correlation readings, kept as a pyramid of ring
+    buffers. Level 0 holds every reading; each coarser level holds the
+    min/max/mean of `decimation` entries of the level below it.
+
+    Every level is sized to cover maxSpanSeconds and allocated in the
+    constructor, so pushing never allocates. Rendering picks the coarsest
+    level that still gives at least one entry per column, which keeps the
+    cost proportional to the number of columns whatever the span.
+*/
+class CorrelationHistory
+{
+public:
+    struct Bucket
+    {
+        float min  = 0.0f;
+        float max  = 0.0f;
+        float mean = 0.0f;
+    };
+
+    CorrelationHistory (double pointsPerSecond, double maxSpanSeconds,
+                        int decimation = 8, int numLevels = 4);
+    ~CorrelationHistory();
+
+    void push (float value) noexcept;
+    void clear() noexcept;
+
+    double getPointsPerSecond() const noexcept { return pointsPerSecond; }
+    double getMaxSpanSeconds() const noexcept  { return maxSpanSeconds; }
+
+    // Fills `columns` with one bucket per column covering the last spanSeconds,
+    // oldest on the left. Returns the index of the first column that has data;
+    // columns before it are left untouched (history shorter than the span).
+    int render (double spanSeconds, std::vector<Bucket>& columns) const noexcept;
+
+private:
+    struct Level
+    {
+        std::vector<Bucket> data;
+        int writePosition = 0;
+        int numStored = 0;
+
+        // Running aggregate of entries not yet handed to the next level
+        Bucket pending;
+        int numPending = 0;
+
+        const Bucket& fromOldest (int index) const noexcept;
+    };
+
+    void pushToLevel (size_t levelIndex, const Bucket& bucket) noexcept;
+
+    const double pointsPerSecond;
+    const double maxSpanSeconds;
+    const int decimation;
+    std::vector<Level> levels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CorrelationHistory)
+};
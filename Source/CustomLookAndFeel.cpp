@@ -24,6 +24,29 @@ CustomLookAndFeel::~CustomLookAndFeel()
 }
 
 void CustomLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPosProportional, float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider)
+{
+    // The knob only depends on its size and angle, so each angle is rendered
+    // once into a filmstrip frame and each repaint is a single blit of the nearest one
+    const int size = juce::jmin(width, height);
+
+    if (size <= 0)
+        return;
+
+    const auto key = "knob_" + juce::String(rotaryStartAngle, 3) + "_" + juce::String(rotaryEndAngle, 3);
+    const int frame = juce::roundToInt(juce::jlimit(0.0f, 1.0f, sliderPosProportional) * (numKnobFrames - 1));
+    const auto target = juce::Rectangle<float>(static_cast<float>(size), static_cast<float>(size))
+                            .withCentre({ x + width * 0.5f, y + height * 0.5f });
+
+    filmstrips.drawFrame(g, key, size, size, numKnobFrames, frame, target,
+                         [size, rotaryStartAngle, rotaryEndAngle](juce::Graphics& frameGraphics, int frameIndex)
+                         {
+                             const float proportion = static_cast<float>(frameIndex) / (numKnobFrames - 1);
+                             paintKnob(frameGraphics, 0, 0, size, size, proportion, rotaryStartAngle, rotaryEndAngle);
+                         });
+}
+
+void CustomLookAndFeel::paintKnob (juce::Graphics& g, int x, int y, int width, int height,
+                                   float sliderPosProportional, float rotaryStartAngle, float rotaryEndAngle)
 {
     const float radius = juce::jmin(width / 2, height / 2) - 4.0f;
     const float centerX = x + width * 0.5f;
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilmstripCache.h"
 
 //==============================================================================
 /*
@@ -27,5 +28,14 @@ public:
     void drawLabel (juce::Graphics& g, juce::Label& label) override;
 
 private:
+    // The full knob drawing, used to render the filmstrip frames
+    static void paintKnob (juce::Graphics&, int x, int y, int width, int height,
+                           float sliderPosProportional, float rotaryStartAngle, float rotaryEndAngle);
+
+    // Just over four degrees per frame across the default rotary range; the
+    // indicator tip moves about two pixels per frame at these knob sizes
+    static constexpr int numKnobFrames = 64;
+    FilmstripCache filmstrips;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CustomLookAndFeel)
 };
@@ -24,13 +24,38 @@ void CustomLookAndFeelVerticalSlider::drawLinearSlider (juce::Graphics& g, int x
                                                         float sliderPos, float minSliderPos, float maxSliderPos,
                                                         const juce::Slider::SliderStyle style, juce::Slider& slider)
 {
-    const auto trackWidth = 6.0f;
+    // Track and thumb are rendered once per size and scale; moving the fader
+    // just blits the thumb sprite at a new position over the track
+    juce::Rectangle<float> track (x + width * 0.5f - trackWidth * 0.5f, static_cast<float>(y), trackWidth, static_cast<float>(height));
+    const int trackHeight = juce::jmax(1, height);
+    sprites.drawFrame(g, "faderTrack", static_cast<int>(trackWidth), trackHeight, 1, 0, track,
+                      [trackHeight](juce::Graphics& spriteGraphics, int)
+                      {
+                          paintTrack(spriteGraphics, { 0.0f, 0.0f, trackWidth, static_cast<float>(trackHeight) });
+                      });
 
-    juce::Rectangle<float> track (x + width * 0.5f - trackWidth * 0.5f, y, trackWidth, height);
+    const auto thumbSpriteBounds = getThumbBounds().expanded(thumbOutline);
+    sprites.drawFrame(g, "faderThumb", juce::roundToInt(thumbSpriteBounds.getWidth()), juce::roundToInt(thumbSpriteBounds.getHeight()), 1, 0,
+                      thumbSpriteBounds.withCentre({ x + width * 0.5f, sliderPos }),
+                      [](juce::Graphics& spriteGraphics, int)
+                      {
+                          paintThumb(spriteGraphics, getThumbBounds().translated(thumbOutline, thumbOutline));
+                      });
+}
+
+juce::Rectangle<float> CustomLookAndFeelVerticalSlider::getThumbBounds()
+{
+    return { 0.0f, 0.0f, trackWidth * 3.0f, 20.0f };
+}
+
+void CustomLookAndFeelVerticalSlider::paintTrack (juce::Graphics& g, juce::Rectangle<float> track)
+{
     g.setColour(juce::Colours::black);
     g.fillRoundedRectangle(track, trackWidth * 0.5f);
+}
 
-    juce::Rectangle<float> thumb (x + width * 0.5f - trackWidth * 1.5f, sliderPos - 10, trackWidth * 3.0f, 20);
+void CustomLookAndFeelVerticalSlider::paintThumb (juce::Graphics& g, juce::Rectangle<float> thumb)
+{
     g.setColour(juce::Colours::black);
     g.fillRoundedRectangle(thumb, trackWidth * 0.5f);
 
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilmstripCache.h"
 
 class CustomLookAndFeelVerticalSlider : public juce::LookAndFeel_V4
 {
@@ -23,6 +24,16 @@ public:
                            const juce::Slider::SliderStyle, juce::Slider&) override;
     
 private:
+    static constexpr float trackWidth = 6.0f;
+    // Room around the thumb sprite for its outline stroke
+    static constexpr float thumbOutline = 2.0f;
+
+    static juce::Rectangle<float> getThumbBounds();
+    static void paintTrack (juce::Graphics&, juce::Rectangle<float> track);
+    static void paintThumb (juce::Graphics&, juce::Rectangle<float> thumb);
+
+    FilmstripCache sprites;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CustomLookAndFeelVerticalSlider)
 };
 
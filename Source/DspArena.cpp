@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    DspArena.cpp
+    Created: 20 Oct 2026 7:15:26pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "DspArena.h"
+
+namespace
+{
+    size_t roundUpToAlignment (size_t numBytes)
+    {
+        return (numBytes + DspArena::alignment - 1) & ~(DspArena::alignment - 1);
+    }
+}
+
+//==============================================================================
+DspArena::DspArena()
+{
+    regions.reserve(16);
+}
+
+DspArena::~DspArena()
+{
+}
+
+void DspArena::beginLayout()
+{
+    regions.clear();
+}
+
+int DspArena::add (const char* name, size_t numBytes, Temperature temperature)
+{
+    regions.push_back({ name, numBytes, temperature });
+    return static_cast<int>(regions.size()) - 1;
+}
+
+bool DspArena::allocate()
+{
+    // Hot regions first, each group in declaration order; handles stay the
+    // declaration indices, only the offsets follow the layout
+    size_t offset = 0;
+
+    for (auto temperature : { Temperature::hot, Temperature::cold })
+    {
+        for (auto& region : regions)
+        {
+            if (region.temperature != temperature)
+                continue;
+
+            region.offset = offset;
+            offset += roundUpToAlignment(region.numBytes);
+        }
+    }
+
+    usedBytes = offset;
+    const bool grew = usedBytes > capacity;
+
+    if (grew)
+    {
+        // Over-allocate by one cache line so the base can be aligned by hand
+        storage.free();
+        storage.malloc(usedBytes + alignment);
+        capacity = usedBytes;
+        ++numAllocations;
+
+        const auto address = reinterpret_cast<juce::pointer_sized_uint>(storage.get());
+        base = storage.get() + (roundUpToAlignment(static_cast<size_t>(address)) - static_cast<size_t>(address));
+    }
+
+    if (base != nullptr)
+        std::memset(base, 0, usedBytes);
+
+    return grew;
+}
+
+juce::String DspArena::getReport() const
+{
+    juce::String report;
+
+    for (auto temperature : { Temperature::hot, Temperature::cold })
+        for (const auto& region : regions)
+            if (region.temperature == temperature)
+                report << juce::String(static_cast<juce::int64>(region.offset)).paddedLeft(' ', 9) << "  "
+                       << juce::String(static_cast<juce::int64>(region.numBytes)).paddedLeft(' ', 9) << " B  "
+                       << (temperature == Temperature::hot ? "hot   " : "cold  ") << region.name << juce::newLine;
+
+    report << "arena: " << static_cast<juce::int64>(usedBytes) << " of " << static_cast<juce::int64>(capacity)
+           << " bytes used, " << numAllocations << (numAllocations == 1 ? " allocation" : " allocations") << juce::newLine;
+
+    return report;
+}
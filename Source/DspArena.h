@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    DspArena.h
+    Created: 20 Oct 2026 7:15:26pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/*
+    One cache-line-aligned block holding the processor's spec-sized DSP
+    buffers, in place of a separate heap allocation for each.
+
+    prepareToPlay declares every region with add(), hot ones (touched every
+    block) before cold ones, then calls allocate(). Regions are laid out in
+    that order, hot first, each starting on its own cache line. The block
+    is only replaced when the new layout does not fit, so re-preparing with
+    the same or a smaller spec allocates nothing. Not thread safe: the
+    layout only changes while the audio thread is stopped.
+*/
+class DspArena
+{
+public:
+    enum class Temperature { hot, cold };
+
+    DspArena();
+    ~DspArena();
+
+    // Forgets the previous regions; pointers into them stay valid until allocate()
+    void beginLayout();
+
+    // Returns a handle for get() once allocate() has been called
+    int add (const char* name, size_t numBytes, Temperature temperature);
+
+    template <typename Type>
+    int addArray (const char* name, size_t numElements, Temperature temperature)
+    {
+        static_assert (alignof (Type) <= alignment, "regions are only cache-line aligned");
+        return add(name, numElements * sizeof (Type), temperature);
+    }
+
+    // Lays the regions out and zeroes them. Returns true if the block had to grow.
+    bool allocate();
+
+    template <typename Type>
+    Type* get (int region) const noexcept
+    {
+        jassert(juce::isPositiveAndBelow(region, static_cast<int>(regions.size())) && base != nullptr);
+        return reinterpret_cast<Type*>(base + regions[static_cast<size_t>(region)].offset);
+    }
+
+    size_t getCapacity() const noexcept  { return capacity; }
+    size_t getUsedBytes() const noexcept { return usedBytes; }
+    int getNumAllocations() const noexcept { return numAllocations; }
+
+    // One line per region in layout order, then the totals
+    juce::String getReport() const;
+
+    static constexpr size_t alignment = 64;
+
+private:
+    struct Region
+    {
+        const char* name;
+        size_t numBytes;
+        Temperature temperature;
+        size_t offset = 0;
+    };
+
+    std::vector<Region> regions;
+
+    juce::HeapBlock<char> storage;
+    char* base = nullptr;
+    size_t capacity = 0;
+    size_t usedBytes = 0;
+    int numAllocations = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DspArena)
+};
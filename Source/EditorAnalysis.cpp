@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    EditorAnalysis.cpp
+    Created: 19 Oct 2026 6:14:51pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "EditorAnalysis.h"
+
+//==============================================================================
+EditorAnalysis::EditorAnalysis (StereoAnalysisModel& m, int readings, bool runOnSharedScheduler)
+    : model(m), readingsPerSecond(juce::jmax(1, readings)), isScheduled(runOnSharedScheduler)
+{
+    leftScratch.resize(static_cast<size_t>(model.getCapacity()));
+    rightScratch.resize(static_cast<size_t>(model.getCapacity()));
+
+    for (auto& frame : vectorscopeFrames.getAllBuffers())
+        frame.reserve(vectorscopeWindow / vectorscopeStride + 1);
+
+    model.setConsumerActive(true);
+
+    if (isScheduled)
+        scheduler->addClient(*this);
+}
+
+EditorAnalysis::~EditorAnalysis()
+{
+    if (isScheduled)
+        scheduler->removeClient(*this);
+
+    model.setConsumerActive(false);
+}
+
+bool EditorAnalysis::fetchVectorscope (std::vector<juce::Point<float>>& points)
+{
+    if (! vectorscopeFrames.fetch())
+        return false;
+
+    const auto& frame = vectorscopeFrames.getReadBuffer();
+    points.assign(frame.begin(), frame.end());
+    return true;
+}
+
+bool EditorAnalysis::fetchPolar (PolarHistogram::Frame& frame)
+{
+    if (! polarFrames.fetch())
+        return false;
+
+    frame = polarFrames.getReadBuffer();
+    return true;
+}
+
+int EditorAnalysis::fetchCorrelations (float* destination, int maxNum)
+{
+    int start1, size1, start2, size2;
+    correlationFifo.prepareToRead(juce::jmin(maxNum, correlationFifo.getNumReady()), start1, size1, start2, size2);
+
+    std::copy(correlationReadings.begin() + start1, correlationReadings.begin() + start1 + size1, destination);
+    std::copy(correlationReadings.begin() + start2, correlationReadings.begin() + start2 + size2, destination + size1);
+
+    correlationFifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+int EditorAnalysis::getMaximumIntervalMs() const noexcept
+{
+    // Half the FIFO's length, so a worker that starts late still drains it in time
+    const double sampleRate = juce::jmax(1.0, model.getSampleRate());
+    return juce::jmax(1, static_cast<int>(500.0 * model.getCapacity() / sampleRate));
+}
+
+void EditorAnalysis::runAnalysis (AnalysisScheduler::Priority priority)
+{
+    const int numSamples = model.pullLatest(leftScratch, rightScratch, model.getCapacity());
+
+    if (numSamples <= 0)
+        return;
+
+    // The meter's history has to stay continuous even while hidden, so the
+    // cheap correlation pass always runs; the display only when on screen
+    accumulateCorrelation(leftScratch.data(), rightScratch.data(), numSamples);
+
+    if (priority == AnalysisScheduler::Priority::hidden)
+        return;
+
+    const bool polar = polarEnabled.load(std::memory_order_relaxed);
+
+    // Start from an empty histogram rather than one left over from last time
+    if (polar && ! polarWasEnabled)
+        polarHistogram.reset();
+
+    polarWasEnabled = polar;
+
+    if (polar)
+    {
+        polarHistogram.process(leftScratch.data(), rightScratch.data(), numSamples, model.getSampleRate());
+        polarHistogram.fillFrame(polarFrames.getWriteBuffer());
+        polarFrames.publish();
+    }
+    else
+    {
+        buildVectorscope(leftScratch.data(), rightScratch.data(), numSamples);
+    }
+}
+
+void EditorAnalysis::accumulateCorrelation (const float* left, const float* right, int numSamples)
+{
+    const int samplesPerReading = juce::jmax(1, juce::roundToInt(model.getSampleRate() / readingsPerSecond));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        sumProduct += left[i] * right[i];
+        sumLeft += left[i] * left[i];
+        sumRight += right[i] * right[i];
+
+        if (++samplesInReading < samplesPerReading)
+            continue;
+
+        const float correlation = (sumLeft > 0.0f && sumRight > 0.0f) ? sumProduct / (std::sqrt(sumLeft) * std::sqrt(sumRight)) : 0.0f;
+
+        // If the editor stops collecting, newer readings are dropped until it catches up
+        if (correlationFifo.getFreeSpace() > 0)
+        {
+            int start1, size1, start2, size2;
+            correlationFifo.prepareToWrite(1, start1, size1, start2, size2);
+            correlationReadings[static_cast<size_t>(size1 > 0 ? start1 : start2)] = correlation;
+            correlationFifo.finishedWrite(1);
+        }
+
+        sumProduct = sumLeft = sumRight = 0.0f;
+        samplesInReading = 0;
+    }
+}
+
+void EditorAnalysis::buildVectorscope (const float* left, const float* right, int numSamples)
+{
+    // Use a simple low-pass filter for smoothing instead of moving average,
+    // carried across runs so consecutive frames join up
+    const float smoothingFactor = 0.05f;
+    const int firstPoint = juce::jmax(0, numSamples - vectorscopeWindow);
+
+    auto& points = vectorscopeFrames.getWriteBuffer();
+    points.clear();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        smoothedLeft += smoothingFactor * (left[i] - smoothedLeft);
+        smoothedRight += smoothingFactor * (right[i] - smoothedRight);
+
+        if (i < firstPoint || (i - firstPoint) % vectorscopeStride != 0)
+            continue;
+
+        // Side to the right, mid upwards, both normalised to the unit circle
+        float x = smoothedLeft - smoothedRight;
+        float y = -(smoothedLeft + smoothedRight) * 0.5f;
+
+        const float distance = std::sqrt(x * x + y * y);
+
+        if (distance > 1.0f)
+        {
+            x /= distance;
+            y /= distance;
+        }
+
+        points.push_back({ x, y });
+    }
+
+    vectorscopeFrames.publish();
+}
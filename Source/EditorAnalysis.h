@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    EditorAnalysis.h
+    Created: 19 Oct 2026 6:14:51pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "AnalysisScheduler.h"
+#include "PolarHistogram.h"
+#include "StereoAnalysisModel.h"
+#include "TripleBuffer.h"
+
+//==============================================================================
+/*
+    The analysis behind one editor's visualizer and correlation meter, run on
+    the shared AnalysisScheduler instead of the message thread.
+
+    Each run drains the processor's StereoAnalysisModel and produces:
+      - one correlation reading per 1/readingsPerSecond of audio, queued in
+        a lock-free FIFO for the meter's history
+      - a smoothed vectorscope frame of normalised points (only while the
+        editor is visible), handed over through a TripleBuffer
+      - or, while the polar display is selected, a PolarHistogram frame in
+        place of the vectorscope, handed over the same way
+
+    While the model is at its reduced rate (the processor is short of CPU),
+    visible runs come half as often. Each run still drains every sample, so
+    the correlation readings and the polar decay keep real time. No run,
+    hidden or not, is left waiting longer than half the model's FIFO lasts
+    at its sample rate (85 ms at 192 kHz), so no block is dropped.
+
+    The editor collects both from the message thread with fetch calls that
+    never block. Tools that need deterministic results (the frame benchmark)
+    can leave it off the scheduler and call runAnalysis themselves.
+*/
+class EditorAnalysis  : public AnalysisScheduler::Client
+{
+public:
+    EditorAnalysis (StereoAnalysisModel& model, int readingsPerSecond, bool runOnSharedScheduler = true);
+    ~EditorAnalysis() override;
+
+    // Message thread. Returns true and fills `points` if a new frame is ready.
+    bool fetchVectorscope (std::vector<juce::Point<float>>& points);
+
+    // Message thread. Returns true and fills `frame` if a new histogram is ready.
+    bool fetchPolar (PolarHistogram::Frame& frame);
+
+    // Any thread. Switches the visible analysis between vectorscope and polar histogram.
+    void setPolarEnabled (bool shouldBeEnabled) noexcept { polarEnabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+
+    // Message thread. Copies up to maxNum pending readings, oldest first.
+    int fetchCorrelations (float* destination, int maxNum);
+
+    void runAnalysis (AnalysisScheduler::Priority) override;
+    int getIntervalMultiplier() const noexcept override { return model.isReducedRate() ? 2 : 1; }
+    int getMaximumIntervalMs() const noexcept override;
+
+private:
+    void accumulateCorrelation (const float* left, const float* right, int numSamples);
+    void buildVectorscope (const float* left, const float* right, int numSamples);
+
+    StereoAnalysisModel& model;
+    const int readingsPerSecond;
+
+    // Worker thread state
+    std::vector<float> leftScratch, rightScratch;
+    float smoothedLeft = 0.0f, smoothedRight = 0.0f;
+    float sumProduct = 0.0f, sumLeft = 0.0f, sumRight = 0.0f;
+    int samplesInReading = 0;
+
+    static constexpr int vectorscopeWindow = 2048;
+    static constexpr int vectorscopeStride = 4;
+    TripleBuffer<std::vector<juce::Point<float>>> vectorscopeFrames;
+
+    std::atomic<bool> polarEnabled { false };
+    bool polarWasEnabled = false;
+    PolarHistogram polarHistogram;
+    TripleBuffer<PolarHistogram::Frame> polarFrames;
+
+    static constexpr int correlationCapacity = 512;
+    juce::AbstractFifo correlationFifo { correlationCapacity };
+    std::array<float, correlationCapacity> correlationReadings {};
+
+    juce::SharedResourcePointer<AnalysisScheduler> scheduler;
+    const bool isScheduled;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EditorAnalysis)
+};
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    FilmstripCache.cpp
+    Created: 19 Oct 2026 10:05:38pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "FilmstripCache.h"
+
+//==============================================================================
+FilmstripCache::FilmstripCache()
+{
+}
+
+FilmstripCache::~FilmstripCache()
+{
+    strips.clear();
+}
+
+void FilmstripCache::drawFrame (juce::Graphics& g, const juce::String& key, int frameWidth, int frameHeight,
+                                int numFrames, int frameIndex, juce::Rectangle<float> target, const FramePainter& painter)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(numFrames > 0);
+
+    if (frameWidth <= 0 || frameHeight <= 0 || numFrames <= 0)
+        return;
+
+    const float scale = getScaleFor(g);
+    const auto fullKey = key + "_" + juce::String(frameWidth) + "x" + juce::String(frameHeight)
+                           + "@" + juce::String(scale, 2) + "#" + juce::String(numFrames);
+
+    auto& strip = strips[fullKey];
+    strip.lastUsed = ++useCounter;
+
+    if (strip.frames.empty())
+        strip.frames.resize(static_cast<size_t>(numFrames));
+
+    auto& image = strip.frames[static_cast<size_t>(juce::jlimit(0, numFrames - 1, frameIndex))];
+
+    if (! image.isValid())
+    {
+        const int framePixelWidth = juce::jmax(1, juce::roundToInt(frameWidth * scale));
+        const int framePixelHeight = juce::jmax(1, juce::roundToInt(frameHeight * scale));
+
+        image = juce::Image(juce::Image::ARGB, framePixelWidth, framePixelHeight, true);
+
+        {
+            juce::Graphics frameGraphics(image);
+            frameGraphics.addTransform(juce::AffineTransform::scale(static_cast<float>(framePixelWidth) / frameWidth,
+                                                                    static_cast<float>(framePixelHeight) / frameHeight));
+            painter(frameGraphics, juce::jlimit(0, numFrames - 1, frameIndex));
+        }
+
+        const auto frameBytes = static_cast<size_t>(framePixelWidth) * static_cast<size_t>(framePixelHeight) * 4;
+        strip.numBytes += frameBytes;
+        numBytes += frameBytes;
+        trim(strip);
+    }
+
+    g.drawImage(image, target);
+}
+
+void FilmstripCache::trim (const Strip& keep)
+{
+    // Least recently drawn first; the strip being drawn always stays
+    while (numBytes > maxBytes)
+    {
+        auto oldest = strips.end();
+
+        for (auto it = strips.begin(); it != strips.end(); ++it)
+            if (&it->second != &keep && (oldest == strips.end() || it->second.lastUsed < oldest->second.lastUsed))
+                oldest = it;
+
+        if (oldest == strips.end())
+            return;
+
+        numBytes -= oldest->second.numBytes;
+        strips.erase(oldest);
+    }
+}
+
+float FilmstripCache::getScaleFor (juce::Graphics& g)
+{
+    return static_cast<float>(g.getInternalContext().getPhysicalPixelScaleFactor());
+}
@@ -0,0 +1,344 @@
+/*
+  ==============================================================================
+
+    MetricsPublisher.cpp
+    Created: 19 Oct 2026 4:26:10pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "MetricsPublisher.h"
+
+#if JUCE_MAC || JUCE_LINUX || JUCE_BSD
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <signal.h>
+ #include <cerrno>
+ #define IMAGINATION_METRICS_SEGMENT 1
+#else
+ #define IMAGINATION_METRICS_SEGMENT 0
+#endif
+
+using namespace ImaginationMetrics;
+
+#if IMAGINATION_METRICS_SEGMENT
+namespace
+{
+    // The owner exited without releasing the slot: it crashed or was killed
+    bool isOwnerGone (std::int32_t pid)
+    {
+        return pid > 0 && kill(pid, 0) != 0 && errno == ESRCH;
+    }
+
+    // Cross-process lock in the segment header, held for one pass over the
+    // slots at most. A holder that died is taken over, like its slots.
+    class ScopedSegmentLock
+    {
+    public:
+        explicit ScopedSegmentLock (SegmentHeader& h)
+            : header(h)
+        {
+            const auto pid = static_cast<std::int32_t>(getpid());
+
+            for (;;)
+            {
+                auto owner = header.lockOwnerPid.load(std::memory_order_relaxed);
+
+                if ((owner == 0 || isOwnerGone(owner))
+                     && header.lockOwnerPid.compare_exchange_weak(owner, pid, std::memory_order_acquire,
+                                                                  std::memory_order_relaxed))
+                    return;
+
+                juce::Thread::yield();
+            }
+        }
+
+        ~ScopedSegmentLock()
+        {
+            header.lockOwnerPid.store(0, std::memory_order_release);
+        }
+
+    private:
+        SegmentHeader& header;
+    };
+
+    void prepareClaimedSlot (Slot& slot, const juce::String& name)
+    {
+        // A writer that died mid-payload leaves the seqlock odd
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + (sequence & 1u), std::memory_order_relaxed);
+
+        std::memset(slot.name, 0, maxNameLength);
+        name.copyToUTF8(slot.name, maxNameLength);
+        slot.state.store(slotLive, std::memory_order_release);
+    }
+
+    // Caller holds the segment lock
+    Slot* claimFreeSlot (Segment& segment, const juce::String& name)
+    {
+        const auto pid = static_cast<std::int32_t>(getpid());
+
+        for (auto& candidate : segment.slots)
+        {
+            if (candidate.state.load(std::memory_order_relaxed) == slotFree)
+            {
+                candidate.state.store(slotClaiming, std::memory_order_relaxed);
+                candidate.ownerPid.store(pid, std::memory_order_relaxed);
+                prepareClaimedSlot(candidate, name);
+                return &candidate;
+            }
+        }
+
+        // Every slot is taken: reclaim one left behind by a process that died
+        for (auto& candidate : segment.slots)
+        {
+            if (isOwnerGone(candidate.ownerPid.load(std::memory_order_relaxed)))
+            {
+                candidate.ownerPid.store(pid, std::memory_order_relaxed);
+                candidate.state.store(slotClaiming, std::memory_order_relaxed);
+                prepareClaimedSlot(candidate, name);
+                return &candidate;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Caller holds the segment lock. Slots of processes that died don't count.
+    bool isAnySlotInUse (const Segment& segment)
+    {
+        for (auto& candidate : segment.slots)
+            if (candidate.state.load(std::memory_order_relaxed) != slotFree
+                 && ! isOwnerGone(candidate.ownerPid.load(std::memory_order_relaxed)))
+                return true;
+
+        return false;
+    }
+}
+#endif
+
+//==============================================================================
+MetricsSegmentMapping::~MetricsSegmentMapping()
+{
+    unmap();
+}
+
+ImaginationMetrics::Slot* MetricsSegmentMapping::claimSlot (const juce::String& name)
+{
+   #if IMAGINATION_METRICS_SEGMENT
+    const juce::ScopedLock sl (lock);
+
+    // The segment may be unlinked between mapping it and taking its lock;
+    // a fresh one is created then. Each retry means another process got as
+    // far as unlinking, so this only spins while instances keep coming and
+    // going; the bound just keeps a host from hanging on it.
+    for (int attempt = 0; attempt < 100; ++attempt)
+    {
+        if (segment == nullptr && ! map())
+            return nullptr;
+
+        {
+            const ScopedSegmentLock segmentLock (segment->header);
+
+            if (segment->header.unlinked.load(std::memory_order_relaxed) == 0)
+                return claimFreeSlot(*segment, name);
+        }
+
+        // Unlinked means no slot was in use, ours included, so nothing in
+        // this process still points into it
+        unmap();
+    }
+   #else
+    juce::ignoreUnused (name);
+   #endif
+
+    return nullptr;
+}
+
+void MetricsSegmentMapping::releaseSlot (ImaginationMetrics::Slot& slot)
+{
+   #if IMAGINATION_METRICS_SEGMENT
+    const juce::ScopedLock sl (lock);
+    jassert (segment != nullptr);
+
+    const ScopedSegmentLock segmentLock (segment->header);
+
+    slot.ownerPid.store(0, std::memory_order_relaxed);
+    slot.state.store(slotFree, std::memory_order_release);
+
+    // Last one out removes the name. Anyone attaching later creates a new
+    // segment; anyone who mapped this one already sees `unlinked` when
+    // they take the lock to claim.
+    if (! isAnySlotInUse(*segment))
+    {
+        segment->header.unlinked.store(1, std::memory_order_relaxed);
+        shm_unlink(segmentName);
+    }
+   #else
+    juce::ignoreUnused (slot);
+   #endif
+}
+
+bool MetricsSegmentMapping::map()
+{
+   #if IMAGINATION_METRICS_SEGMENT
+    constexpr auto segmentSize = static_cast<off_t>(sizeof(Segment));
+    bool created = false;
+
+    int fd = shm_open(segmentName, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (fd >= 0)
+    {
+        created = true;
+
+        if (ftruncate(fd, segmentSize) != 0)
+        {
+            close(fd);
+            shm_unlink(segmentName);
+            return false;
+        }
+    }
+    else if (errno == EEXIST)
+    {
+        fd = shm_open(segmentName, O_RDWR, 0600);
+
+        if (fd < 0)
+            return false;
+
+        // Another process may have created it but not sized it yet
+        struct stat info {};
+
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            if (fstat(fd, &info) == 0 && info.st_size >= segmentSize)
+                break;
+
+            juce::Thread::sleep(1);
+        }
+
+        if (info.st_size < segmentSize)
+        {
+            close(fd);
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    auto* address = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (address == MAP_FAILED)
+        return false;
+
+    auto* mapped = static_cast<Segment*>(address);
+
+    if (created)
+    {
+        // ftruncate zero-fills, so every slot already reads as free and the
+        // lock as unheld
+        mapped->header.version = segmentVersion;
+        mapped->header.numSlots = maxSlots;
+        mapped->header.magic.store(segmentMagic, std::memory_order_release);
+    }
+    else
+    {
+        for (int attempt = 0; attempt < 100 && mapped->header.magic.load(std::memory_order_acquire) != segmentMagic; ++attempt)
+            juce::Thread::sleep(1);
+
+        if (mapped->header.magic.load(std::memory_order_acquire) != segmentMagic
+             || mapped->header.version != segmentVersion)
+        {
+            munmap(address, sizeof(Segment));
+            return false;
+        }
+    }
+
+    segment = mapped;
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+void MetricsSegmentMapping::unmap()
+{
+   #if IMAGINATION_METRICS_SEGMENT
+    if (segment != nullptr)
+        munmap(segment, sizeof(Segment));
+   #endif
+
+    segment = nullptr;
+}
+
+//==============================================================================
+MetricsPublisher::MetricsPublisher()
+{
+    static std::atomic<int> instanceCounter { 0 };
+    slot = mapping->claimSlot("Imagination " + juce::String(++instanceCounter));
+
+    if (slot != nullptr)
+        header = &mapping->getSegment()->header;
+}
+
+MetricsPublisher::~MetricsPublisher()
+{
+    if (slot != nullptr)
+        mapping->releaseSlot(*slot);
+}
+
+void MetricsPublisher::publish (const juce::AudioBuffer<float>& buffer, double sampleRate, double cpuLoad,
+                                int qualityTier, juce::uint64 numOverruns) noexcept
+{
+    if (slot == nullptr)
+        return;
+
+    const auto nowMs = static_cast<std::uint64_t>(juce::Time::currentTimeMillis());
+    const auto lastPollMs = header->lastReaderPollMs.load(std::memory_order_relaxed);
+
+    ++payload.blockCounter;
+    payload.timestampMs = nowMs;
+    payload.sampleRate = static_cast<float>(sampleRate);
+    payload.cpuLoad = static_cast<float>(cpuLoad);
+    payload.qualityTier = static_cast<std::uint32_t>(qualityTier);
+    payload.numOverruns = numOverruns;
+
+    if (nowMs - lastPollMs <= readerTimeoutMs)
+        measureLevels(buffer);
+
+    writePayload(*slot, payload);
+}
+
+void MetricsPublisher::measureLevels (const juce::AudioBuffer<float>& buffer) noexcept
+{
+    const int numSamples = buffer.getNumSamples();
+
+    if (buffer.getNumChannels() == 0 || numSamples == 0)
+        return;
+
+    const auto* left = buffer.getReadPointer(0);
+    const auto* right = buffer.getReadPointer(buffer.getNumChannels() > 1 ? 1 : 0);
+
+    float sumLeft = 0.0f, sumRight = 0.0f, sumProduct = 0.0f;
+    float peakLeft = 0.0f, peakRight = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        sumLeft += left[i] * left[i];
+        sumRight += right[i] * right[i];
+        sumProduct += left[i] * right[i];
+        peakLeft = juce::jmax(peakLeft, std::abs(left[i]));
+        peakRight = juce::jmax(peakRight, std::abs(right[i]));
+    }
+
+    payload.peakLeft = peakLeft;
+    payload.peakRight = peakRight;
+    payload.rmsLeft = std::sqrt(sumLeft / static_cast<float>(numSamples));
+    payload.rmsRight = std::sqrt(sumRight / static_cast<float>(numSamples));
+    payload.correlation = (sumLeft > 0.0f && sumRight > 0.0f) ? sumProduct / std::sqrt(sumLeft * sumRight) : 0.0f;
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    MetricsPublisher.h
+    Created: 19 Oct 2026 4:26:10pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MetricsSegment.h"
+
+//==============================================================================
+/*
+    Process-wide mapping of the shared metrics segment, held through
+    juce::SharedResourcePointer. The first claim creates the segment (owner
+    only) or attaches to it; releasing the last slot in use removes it from
+    /dev/shm. Slots of processes that exited without releasing them are
+    reclaimed, and don't keep the segment alive.
+
+    Claims and releases are serialised within the process by a
+    CriticalSection and across processes by the segment's header lock.
+*/
+class MetricsSegmentMapping
+{
+public:
+    MetricsSegmentMapping() = default;
+    ~MetricsSegmentMapping();
+
+    // Returns nullptr if the segment can't be mapped or every slot is live
+    ImaginationMetrics::Slot* claimSlot (const juce::String& name);
+    void releaseSlot (ImaginationMetrics::Slot& slot);
+
+    // Stays valid while this process holds a slot
+    ImaginationMetrics::Segment* getSegment() const noexcept { return segment; }
+
+private:
+    bool map();
+    void unmap();
+
+    juce::CriticalSection lock;
+    ImaginationMetrics::Segment* segment = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MetricsSegmentMapping)
+};
+
+//==============================================================================
+/*
+    Owns one slot of the shared metrics segment for a processor instance.
+
+    publish() is called once per block from the audio thread and is
+    wait-free: it bumps the slot's seqlock and does a few relaxed stores.
+    Constructing and destroying one takes the segment lock, so neither
+    belongs on the audio thread.
+    Levels and correlation are only computed while a reader has polled the
+    segment recently, so unobserved instances skip the per-sample pass.
+*/
+class MetricsPublisher
+{
+public:
+    MetricsPublisher();
+    ~MetricsPublisher();
+
+    bool isConnected() const noexcept { return slot != nullptr; }
+
+    void publish (const juce::AudioBuffer<float>& buffer, double sampleRate, double cpuLoad,
+                  int qualityTier, juce::uint64 numOverruns) noexcept;
+
+private:
+    void measureLevels (const juce::AudioBuffer<float>& buffer) noexcept;
+
+    juce::SharedResourcePointer<MetricsSegmentMapping> mapping;
+    ImaginationMetrics::Slot* slot = nullptr;
+    const ImaginationMetrics::SegmentHeader* header = nullptr;
+    ImaginationMetrics::Payload payload;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MetricsPublisher)
+};
@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    MetricsSegment.h
+    Created: 19 Oct 2026 4:26:10pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/*
+    Layout of the POSIX shared-memory segment every plugin instance publishes
+    its metrics into. This header has no JUCE dependency so the standalone
+    reader in Tools/ can include it as-is.
+
+    Each slot is written by exactly one audio thread and protected by a
+    seqlock: the writer makes `sequence` odd, stores the payload with relaxed
+    atomics, then makes it even again. Readers retry until they see the same
+    even sequence before and after copying the payload.
+
+    The segment is created owner-only (0600), so only processes of the same
+    user can map it. Slots are claimed and released under a lock in the
+    header, `lockOwnerPid`, which a process that died holding it gives up
+    to the next one. The process that releases the last slot still in use
+    sets `unlinked` and removes the name under that lock; one that mapped
+    the segment before then finds `unlinked` set when it claims, and
+    creates a fresh segment instead. A slot is released by its owner, or
+    reclaimed by a later instance once `ownerPid` has exited.
+*/
+namespace ImaginationMetrics
+{
+    // Versioned, so a world-writable segment left behind by an older build
+    // can neither be attached to nor block this one
+    static constexpr const char* segmentName = "/imagination-metrics-v3";
+    static constexpr std::uint32_t segmentMagic = 0x494d4731; // "IMG1"
+    static constexpr std::uint32_t segmentVersion = 3;
+    static constexpr int maxSlots = 256;
+    static constexpr int maxNameLength = 32;
+
+    // A writer only computes levels and correlation while a reader has polled recently
+    static constexpr std::uint64_t readerTimeoutMs = 2000;
+
+    enum SlotState : std::uint32_t
+    {
+        slotFree     = 0,
+        slotClaiming = 1,
+        slotLive     = 2
+    };
+
+    struct Payload
+    {
+        std::uint64_t blockCounter = 0;
+        std::uint64_t timestampMs  = 0;
+        float sampleRate  = 0.0f;
+        float cpuLoad     = 0.0f;  // processBlock time as a fraction of the block's duration
+        float correlation = 0.0f;
+        float peakLeft    = 0.0f;
+        float peakRight   = 0.0f;
+        float rmsLeft     = 0.0f;
+        float rmsRight    = 0.0f;
+        std::uint32_t qualityTier = 0;  // QualityGovernor::Tier, 0 = full
+        std::uint64_t numOverruns = 0;  // blocks that took longer than they last, since the instance started
+    };
+
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint32_t> state;
+        std::atomic<std::int32_t> ownerPid;
+        char name[maxNameLength];   // written while claiming, before the slot goes live
+
+        std::atomic<std::uint32_t> sequence;
+        std::atomic<std::uint64_t> blockCounter;
+        std::atomic<std::uint64_t> timestampMs;
+        std::atomic<float> sampleRate;
+        std::atomic<float> cpuLoad;
+        std::atomic<float> correlation;
+        std::atomic<float> peakLeft;
+        std::atomic<float> peakRight;
+        std::atomic<float> rmsLeft;
+        std::atomic<float> rmsRight;
+        std::atomic<std::uint32_t> qualityTier;
+        std::atomic<std::uint64_t> numOverruns;
+    };
+
+    struct SegmentHeader
+    {
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t version;
+        std::atomic<std::int32_t> lockOwnerPid;   // 0 while nobody holds the lock
+        std::int32_t numSlots;
+        std::atomic<std::uint64_t> lastReaderPollMs;
+        std::atomic<std::uint32_t> unlinked;      // the name now belongs to a newer segment, or none
+    };
+
+    struct Segment
+    {
+        SegmentHeader header;
+        Slot slots[maxSlots];
+    };
+
+    static_assert(std::atomic<float>::is_always_lock_free, "metrics slots need lock-free atomics");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "metrics slots need lock-free atomics");
+
+    //==============================================================================
+    inline void writePayload (Slot& slot, const Payload& p) noexcept
+    {
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.blockCounter.store(p.blockCounter, std::memory_order_relaxed);
+        slot.timestampMs.store(p.timestampMs, std::memory_order_relaxed);
+        slot.sampleRate.store(p.sampleRate, std::memory_order_relaxed);
+        slot.cpuLoad.store(p.cpuLoad, std::memory_order_relaxed);
+        slot.correlation.store(p.correlation, std::memory_order_relaxed);
+        slot.peakLeft.store(p.peakLeft, std::memory_order_relaxed);
+        slot.peakRight.store(p.peakRight, std::memory_order_relaxed);
+        slot.rmsLeft.store(p.rmsLeft, std::memory_order_relaxed);
+        slot.rmsRight.store(p.rmsRight, std::memory_order_relaxed);
+        slot.qualityTier.store(p.qualityTier, std::memory_order_relaxed);
+        slot.numOverruns.store(p.numOverruns, std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Returns false if the writer kept interrupting the copy
+    inline bool readPayload (const Slot& slot, Payload& p, int maxAttempts = 64) noexcept
+    {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt)
+        {
+            const auto before = slot.sequence.load(std::memory_order_acquire);
+
+            if ((before & 1u) != 0)
+                continue;
+
+            p.blockCounter = slot.blockCounter.load(std::memory_order_relaxed);
+            p.timestampMs = slot.timestampMs.load(std::memory_order_relaxed);
+            p.sampleRate = slot.sampleRate.load(std::memory_order_relaxed);
+            p.cpuLoad = slot.cpuLoad.load(std::memory_order_relaxed);
+            p.correlation = slot.correlation.load(std::memory_order_relaxed);
+            p.peakLeft = slot.peakLeft.load(std::memory_order_relaxed);
+            p.peakRight = slot.peakRight.load(std::memory_order_relaxed);
+            p.rmsLeft = slot.rmsLeft.load(std::memory_order_relaxed);
+            p.rmsRight = slot.rmsRight.load(std::memory_order_relaxed);
+            p.qualityTier = slot.qualityTier.load(std::memory_order_relaxed);
+            p.numOverruns = slot.numOverruns.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+
+        return false;
+    }
+}
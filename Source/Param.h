@@ -21,6 +21,13 @@ static constexpr const char* depth = "depth";
 static constexpr const char* stereoSpread = "stereoSpread";
 static constexpr const char* crossfeed = "crossfeed";
 static constexpr const char* exciterEnhancer = "exciterEnhancer";
+static constexpr const char* widthGuard = "widthGuard";
+static constexpr const char* widthGuardThreshold = "widthGuardThreshold";
+static constexpr const char* binaural = "binaural";
+static constexpr const char* binauralAngle = "binauralAngle";
+static constexpr const char* transientSplit = "transientSplit";
+static constexpr const char* transientWidth = "transientWidth";
+static constexpr const char* transientExciter = "transientExciter";
 
 }
 
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    ParameterChangeTracker.cpp
+    Created: 19 Oct 2026 9:26:03pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "ParameterChangeTracker.h"
+
+//==============================================================================
+class ParameterChangeTracker::ParameterListener  : public juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    ParameterListener (std::atomic<juce::uint32>& mask, const juce::String& id, juce::uint32 f)
+        : dirtyFlags(mask), parameterID(id), flags(f)
+    {
+    }
+
+    void parameterChanged (const juce::String&, float) override
+    {
+        dirtyFlags.fetch_or(flags, std::memory_order_release);
+    }
+
+    std::atomic<juce::uint32>& dirtyFlags;
+    const juce::String parameterID;
+    const juce::uint32 flags;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterListener)
+};
+
+//==============================================================================
+ParameterChangeTracker::ParameterChangeTracker (juce::AudioProcessorValueTreeState& s)
+    : state(s)
+{
+}
+
+ParameterChangeTracker::~ParameterChangeTracker()
+{
+    for (auto* listener : listeners)
+        state.removeParameterListener(listener->parameterID, listener);
+}
+
+void ParameterChangeTracker::track (const juce::String& parameterID, juce::uint32 flags)
+{
+    jassert(state.getParameter(parameterID) != nullptr);
+
+    auto* listener = listeners.add(new ParameterListener(dirtyFlags, parameterID, flags));
+    state.addParameterListener(parameterID, listener);
+    markAllDirty();
+}
+
+void ParameterChangeTracker::markAllDirty() noexcept
+{
+    dirtyFlags.store(~0u, std::memory_order_release);
+}
+
+juce::uint32 ParameterChangeTracker::takeDirtyFlags() noexcept
+{
+    // Cheap early-out for the common case of nothing having changed
+    if (dirtyFlags.load(std::memory_order_relaxed) == 0)
+        return 0;
+
+    return dirtyFlags.exchange(0, std::memory_order_acquire);
+}
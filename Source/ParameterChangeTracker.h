@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    ParameterChangeTracker.h
+    Created: 19 Oct 2026 9:26:03pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+/*
+    Records which parameters changed since the audio thread last looked, as
+    bits in one atomic mask.
+
+    Each tracked parameter gets its own APVTS listener that ORs its flags into
+    the mask, whichever thread the change arrives on. processBlock takes the
+    mask once per block and only recomputes what depends on the bits that
+    are set, so a block with no changes costs a single atomic exchange.
+*/
+class ParameterChangeTracker
+{
+public:
+    explicit ParameterChangeTracker (juce::AudioProcessorValueTreeState& state);
+    ~ParameterChangeTracker();
+
+    // Several parameters may share flags; the mask starts with every bit set
+    void track (const juce::String& parameterID, juce::uint32 flags);
+
+    void markAllDirty() noexcept;
+
+    // Audio thread. Returns the flags set since the last call and clears them.
+    juce::uint32 takeDirtyFlags() noexcept;
+
+private:
+    class ParameterListener;
+
+    juce::AudioProcessorValueTreeState& state;
+    juce::OwnedArray<ParameterListener> listeners;
+    std::atomic<juce::uint32> dirtyFlags { ~0u };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterChangeTracker)
+};
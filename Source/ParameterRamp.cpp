@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    ParameterRamp.cpp
+    Created: 20 Oct 2026 9:34:08pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "ParameterRamp.h"
+
+//==============================================================================
+ParameterRamp::ParameterRamp (float initialValue) noexcept
+    : start(initialValue), target(initialValue), current(initialValue)
+{
+}
+
+void ParameterRamp::reset (double sampleRate, double rampSeconds) noexcept
+{
+    jassert(sampleRate > 0.0 && rampSeconds >= 0.0);
+
+    stepsToTarget = static_cast<int>(std::floor(rampSeconds * sampleRate));
+    setCurrentAndTargetValue(target);
+}
+
+void ParameterRamp::setTargetValue (float newTarget) noexcept
+{
+    if (newTarget == target)
+        return;
+
+    if (stepsToTarget <= 0)
+    {
+        setCurrentAndTargetValue(newTarget);
+        return;
+    }
+
+    // A new target restarts the ramp from wherever the old one had got to
+    start = current;
+    target = newTarget;
+    step = (target - start) / static_cast<float>(stepsToTarget);
+    position = 0;
+    length = stepsToTarget;
+}
+
+void ParameterRamp::setCurrentAndTargetValue (float newValue) noexcept
+{
+    start = target = current = newValue;
+    step = 0.0f;
+    position = length = 0;
+}
+
+void ParameterRamp::fill (float* dest, int num) noexcept
+{
+    const int numRamped = juce::jlimit(0, num, length - position);
+
+    if (numRamped > 0)
+    {
+        int i = 0;
+
+       #if JUCE_USE_SIMD
+        using Lanes = juce::dsp::SIMDRegister<float>;
+        constexpr int numLanes = static_cast<int>(Lanes::SIMDNumElements);
+        jassert(Lanes::isSIMDAligned(dest));
+
+        alignas (Lanes::SIMDRegisterSize) float laneOffsets[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+            laneOffsets[lane] = static_cast<float>(position + 1 + lane);
+
+        const auto startValue = Lanes::expand(start);
+        const auto stepValue = Lanes::expand(step);
+        const auto advance = Lanes::expand(static_cast<float>(numLanes));
+        auto index = Lanes::fromRawArray(laneOffsets);
+
+        for (; i + numLanes <= numRamped; i += numLanes)
+        {
+            (startValue + stepValue * index).copyToRawArray(dest + i);
+            index = index + advance;
+        }
+       #endif
+
+        for (; i < numRamped; ++i)
+            dest[i] = start + step * static_cast<float>(position + 1 + i);
+
+        position += numRamped;
+
+        // The last step lands exactly on the target
+        if (position >= length)
+            dest[numRamped - 1] = target;
+
+        current = dest[numRamped - 1];
+    }
+
+    if (num > numRamped)
+        juce::FloatVectorOperations::fill(dest + numRamped, target, num - numRamped);
+}
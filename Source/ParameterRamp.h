@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    ParameterRamp.h
+    Created: 20 Oct 2026 9:34:08pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    A linear parameter ramp with the juce::SmoothedValue interface, plus
+    fill(), which writes a run of upcoming values in one go. Each value is
+    computed from its position in the ramp rather than accumulated, so a
+    SIMD register can produce several samples at once with no drift.
+
+    Once the ramp has reached its target, fill() is a plain vector fill and
+    callers are expected to skip it altogether (see isSmoothing()).
+*/
+class ParameterRamp
+{
+public:
+    explicit ParameterRamp (float initialValue = 0.0f) noexcept;
+
+    // Changes take rampSeconds to complete, or jump with 0. Snaps to the target.
+    void reset (double sampleRate, double rampSeconds) noexcept;
+
+    void setTargetValue (float newTarget) noexcept;
+    void setCurrentAndTargetValue (float newValue) noexcept;
+
+    float getTargetValue() const noexcept  { return target; }
+    float getCurrentValue() const noexcept { return current; }
+    bool isSmoothing() const noexcept      { return position < length; }
+
+    float getNextValue() noexcept
+    {
+        if (position >= length)
+            return target;
+
+        ++position;
+        current = position < length ? start + step * static_cast<float>(position) : target;
+        return current;
+    }
+
+    // Writes the next num values to dest, which must be SIMD aligned, and
+    // moves past them; the same values getNextValue() would give, up to rounding
+    void fill (float* dest, int num) noexcept;
+
+private:
+    float start = 0.0f, target = 0.0f, current = 0.0f, step = 0.0f;
+    int position = 0, length = 0;
+    int stepsToTarget = 0;
+};
@@ -10,37 +10,51 @@
 
 #include <JuceHeader.h>
 #include "PhaseCorrelationMeter.h"
+#include "TraceRecorder.h"
 
 //==============================================================================
 PhaseCorrelationMeter::PhaseCorrelationMeter()
 {
-    startTimerHz(30); // Update every 100ms instead of 40ms
 }
 
 PhaseCorrelationMeter::~PhaseCorrelationMeter()
 {
-    stopTimer();
 }
 
-void PhaseCorrelationMeter::setAudioData(const std::vector<float>& leftChannelData, const std::vector<float>& rightChannelData)
+void PhaseCorrelationMeter::addReadings(const float* readings, int numReadings)
 {
-    const juce::ScopedLock sl(lock);
-        this->leftChannelData = leftChannelData;
-        this->rightChannelData = rightChannelData;
+    if (numReadings <= 0)
+        return;
 
-        if (!leftChannelData.empty() && !rightChannelData.empty())
-        {
-            phaseCorrelation = calculatePhaseCorrelation();
-            isActive = true;
-        }
-        else
-        {
-            isActive = false;
-        }
+    for (int i = 0; i < numReadings; ++i)
+        history.push(readings[i]);
+
+    phaseCorrelation = readings[numReadings - 1];
+    isActive = true;
+    repaint();
+}
+
+void PhaseCorrelationMeter::addComparisonReadings(const float* readings, int numReadings)
+{
+    for (int i = 0; i < numReadings; ++i)
+        comparisonHistory.push(readings[i]);
+
+    hasComparison = true;
+}
+
+void PhaseCorrelationMeter::clearComparison()
+{
+    if (! hasComparison)
+        return;
+
+    comparisonHistory.clear();
+    hasComparison = false;
+    repaint();
 }
 
 void PhaseCorrelationMeter::paint (juce::Graphics& g)
 {
+    IMAGINATION_TRACE_SCOPE("correlation meter paint");
     auto bounds = getLocalBounds().toFloat();
 
         g.fillAll(juce::Colour(60, 60, 65));
@@ -64,18 +78,28 @@ void PhaseCorrelationMeter::paint (juce::Graphics& g)
                 g.drawLine(0, y, bounds.getWidth(), y);
             }
 
-            // Draw the waveform
+            // Draw the min/max envelope and the mean of each column
             juce::Path waveformPath;
-            float yCenter = bounds.getCentreY();
-            waveformPath.startNewSubPath(0, yCenter);
+            juce::Path envelopePath;
 
             {
-                const juce::ScopedLock sl(lock);
-                for (size_t i = 0; i < phaseHistory.size(); ++i)
+                const int firstColumn = history.render(visibleSpanSeconds, columns);
+                const int numColumns = static_cast<int>(columns.size());
+
+                auto toY = [&bounds](float value) { return juce::jmap(value, -1.0f, 1.0f, bounds.getBottom(), bounds.getY()); };
+
+                for (int i = firstColumn; i < numColumns; ++i)
                 {
-                    float x = juce::jmap(static_cast<float>(i), 0.0f, static_cast<float>(phaseHistory.size() - 1), 0.0f, bounds.getWidth());
-                    float y = juce::jmap(phaseHistory[i], -1.0f, 1.0f, bounds.getBottom(), bounds.getY());
-                    waveformPath.lineTo(x, y);
+                    const auto x = static_cast<float>(i);
+                    const auto& column = columns[static_cast<size_t>(i)];
+
+                    if (i == firstColumn)
+                        waveformPath.startNewSubPath(x, toY(column.mean));
+                    else
+                        waveformPath.lineTo(x, toY(column.mean));
+
+                    if (column.max > column.min)
+                        envelopePath.addRectangle(x, toY(column.max), 1.0f, toY(column.min) - toY(column.max));
                 }
             }
 
@@ -83,8 +107,40 @@ void PhaseCorrelationMeter::paint (juce::Graphics& g)
                     juce::Colour::fromRGB(70, 70, 200), bounds.getRight(), bounds.getY(), false);
             gradient.addColour(0.5, juce::Colours::white);
             g.setGradientFill(gradient);
+            g.setOpacity(0.35f);
+            g.fillPath(envelopePath);
+            g.setOpacity(1.0f);
             g.strokePath(waveformPath, juce::PathStrokeType(2.0f));
 
+            // The compared instance's mean, thinner and on top
+            if (hasComparison)
+            {
+                juce::Path comparisonPath;
+                const int firstColumn = comparisonHistory.render(visibleSpanSeconds, comparisonColumns);
+                const int numColumns = static_cast<int>(comparisonColumns.size());
+
+                for (int i = firstColumn; i < numColumns; ++i)
+                {
+                    const auto x = static_cast<float>(i);
+                    const auto y = juce::jmap(comparisonColumns[static_cast<size_t>(i)].mean, -1.0f, 1.0f, bounds.getBottom(), bounds.getY());
+
+                    if (i == firstColumn)
+                        comparisonPath.startNewSubPath(x, y);
+                    else
+                        comparisonPath.lineTo(x, y);
+                }
+
+                g.setColour(juce::Colour(255, 170, 60).withAlpha(0.8f));
+                g.strokePath(comparisonPath, juce::PathStrokeType(1.0f));
+            }
+
+            // Visible time span
+            g.setColour(juce::Colours::grey);
+            g.setFont(12.0f);
+            const auto spanText = visibleSpanSeconds < 60.0 ? juce::String(juce::roundToInt(visibleSpanSeconds)) + " s"
+                                                            : juce::String(visibleSpanSeconds / 60.0, 1) + " min";
+            g.drawText(spanText, bounds.withTrimmedRight(45.0f).removeFromTop(18.0f), juce::Justification::centredRight);
+
             // Draw the text labels
             g.setColour(juce::Colours::white);
             g.setFont(15.0f);
@@ -102,46 +158,20 @@ void PhaseCorrelationMeter::paint (juce::Graphics& g)
 
 void PhaseCorrelationMeter::resized()
 {
+    columns.resize(static_cast<size_t>(juce::jmax(1, getWidth())));
+    comparisonColumns.resize(columns.size());
 }
 
-void PhaseCorrelationMeter::timerCallback()
+void PhaseCorrelationMeter::mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel)
 {
-    const juce::ScopedLock sl(lock);
-      
-      if (isActive)
-      {
-          phaseCorrelation = calculatePhaseCorrelation();
-          phaseHistory.push_back(phaseCorrelation);
-
-          if (phaseHistory.size() > 100) // Keep a fixed size history
-          {
-              phaseHistory.erase(phaseHistory.begin());
-          }
-
-          repaint();
-      }
+    // Scrolling up zooms in; the span scales exponentially with the wheel travel
+    visibleSpanSeconds = juce::jlimit(minSpanSeconds, maxSpanSeconds,
+                                      visibleSpanSeconds * std::pow(2.0, -wheel.deltaY * 2.0));
+    repaint();
 }
 
-float PhaseCorrelationMeter::calculatePhaseCorrelation()
+void PhaseCorrelationMeter::mouseDoubleClick (const juce::MouseEvent&)
 {
-    if (leftChannelData.size() != rightChannelData.size() || leftChannelData.empty())
-           return 0.0f;
-
-       // Downsample or use only a portion of the data
-       size_t step = std::max<size_t>(leftChannelData.size() / 1000, 1);
-       float sumProduct = 0.0f;
-       float sumLeft = 0.0f;
-       float sumRight = 0.0f;
-
-       for (size_t i = 0; i < leftChannelData.size(); i += step)
-       {
-           sumProduct += leftChannelData[i] * rightChannelData[i];
-           sumLeft += leftChannelData[i] * leftChannelData[i];
-           sumRight += rightChannelData[i] * rightChannelData[i];
-       }
-
-       if (sumLeft == 0.0f || sumRight == 0.0f)
-           return 0.0f;
-
-       return sumProduct / (std::sqrt(sumLeft) * std::sqrt(sumRight));
+    visibleSpanSeconds = defaultSpanSeconds;
+    repaint();
 }
@@ -6,34 +6,52 @@
     Author:  Adam Elhamami
 
   ==============================================================================
-/
+*/
 
 #pragma once
 
 #include <JuceHeader.h>
+#include "CorrelationHistory.h"
 
 //==============================================================================
-/
+/*
 */
-class PhaseCorrelationMeter  : public juce::Component, private juce::Timer
+class PhaseCorrelationMeter  : public juce::Component
 {
 public:
     PhaseCorrelationMeter();
     ~PhaseCorrelationMeter() override;
 
-    void setAudioData(const std::vector<float>& leftChannelData, const std::vector<float>& rightChannelData);
+    // Readings are expected at this rate, one per 1/readingsPerSecond of audio
+    static constexpr int readingsPerSecond = 30;
+
+    void addReadings(const float* readings, int numReadings);
+
+    // Another instance's readings from the comparison bus, drawn over our own
+    void addComparisonReadings(const float* readings, int numReadings);
+    void clearComparison();
+
     void paint(juce::Graphics& g) override;
     void resized() override;
 
-private:
-    void timerCallback() override;
-    float calculatePhaseCorrelation();
+    void mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails&) override;
+    void mouseDoubleClick (const juce::MouseEvent&) override;
 
-    juce::CriticalSection lock;
-    std::vector<float> leftChannelData;
-    std::vector<float> rightChannelData;
+private:
     float phaseCorrelation = 0.0f;
-    std::vector<float> phaseHistory;
+
+    // Zoomable from the last second to the last ten minutes
+    static constexpr double minSpanSeconds = 1.0;
+    static constexpr double maxSpanSeconds = 600.0;
+    static constexpr double defaultSpanSeconds = 5.0;
+
+    CorrelationHistory history { readingsPerSecond, maxSpanSeconds };
+    std::vector<CorrelationHistory::Bucket> columns;
+
+    CorrelationHistory comparisonHistory { readingsPerSecond, maxSpanSeconds };
+    std::vector<CorrelationHistory::Bucket> comparisonColumns;
+    bool hasComparison = false;
+    double visibleSpanSeconds = defaultSpanSeconds;
     
     bool isActive = false;
 
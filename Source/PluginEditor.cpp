@@ -16,10 +16,14 @@
 
 //==============================================================================
 ImaginationAudioProcessorEditor::ImaginationAudioProcessorEditor (ImaginationAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+      analysis (p.getAnalysisModel(), PhaseCorrelationMeter::readingsPerSecond)
 {
     setSize(800, 500);
     
+    auto& customLookAndFeel = sharedResources->getRotaryLookAndFeel();
+    auto& customLookAndFeelVerticalSlider = sharedResources->getVerticalSliderLookAndFeel();
+
     widthSlider.setLookAndFeel(&customLookAndFeelVerticalSlider);
     balanceSlider.setLookAndFeel(&customLookAndFeel);
     inputGainSlider.setLookAndFeel(&customLookAndFeel);
@@ -117,10 +121,38 @@ ImaginationAudioProcessorEditor::ImaginationAudioProcessorEditor (ImaginationAud
 
     crossfeedAttachment.emplace(audioProcessor.apvts, "crossfeed", crossfeedSlider);
     exciterEnhancerAttachment.emplace(audioProcessor.apvts, "exciterEnhancer", exciterEnhancerSlider);
+
+    addAndMakeVisible(widthGuardButton);
+    addAndMakeVisible(widthGuardMeter);
+    widthGuardAttachment.emplace(audioProcessor.apvts, ParamIDs::widthGuard, widthGuardButton);
+
+    addAndMakeVisible(binauralButton);
+    addAndMakeVisible(binauralAngleSlider);
+    binauralAngleSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    binauralAngleSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 16);
+    binauralAttachment.emplace(audioProcessor.apvts, ParamIDs::binaural, binauralButton);
+    binauralAngleAttachment.emplace(audioProcessor.apvts, ParamIDs::binauralAngle, binauralAngleSlider);
+
+    addAndMakeVisible(publishButton);
+    publishButton.setToggleState(audioProcessor.getComparisonName().isNotEmpty(), juce::dontSendNotification);
+    publishButton.onClick = [this] { publishClicked(); };
+
+    addAndMakeVisible(compareBox);
+    compareBox.setTextWhenNothingSelected("NO COMPARISON");
+    compareBox.onChange = [this] { setComparedPublisher(compareBox.getSelectedId() - 2); };
+    refreshComparisonList();
+
+    addAndMakeVisible(qualityLabel);
+    qualityLabel.setJustificationType(juce::Justification::centredRight);
+
+    addAndMakeVisible(presetButton);
+    presetButton.onClick = [this]
+    {
+        juce::CallOutBox::launchAsynchronously(std::make_unique<PresetBrowser>(audioProcessor), presetButton.getBounds(), this);
+    };
     
     // Set Font
-    juce::Typeface::Ptr helvetica = juce::Typeface::createSystemTypefaceFor(BinaryData::HelveticaBold_woff, BinaryData::HelveticaBold_woffSize);
-    juce::Font font(*helvetica);
+    auto font = sharedResources->getLabelFont();
     
     widthLabel.setFont(font);
     balanceLabel.setFont(font);
@@ -130,11 +162,16 @@ ImaginationAudioProcessorEditor::ImaginationAudioProcessorEditor (ImaginationAud
 //    depthLabel.setFont(font);
     crossfeedLabel.setFont(font);
     exciterEnhancerLabel.setFont(font);
-       
+    qualityLabel.setFont(font);
+    
+    updateQuality();
+    startTimerHz(30);
 }
 
 ImaginationAudioProcessorEditor::~ImaginationAudioProcessorEditor()
 {
+    stopTimer();
+
     widthSlider.setLookAndFeel(nullptr);
     balanceSlider.setLookAndFeel(nullptr);
     inputGainSlider.setLookAndFeel(nullptr);
@@ -145,9 +182,189 @@ ImaginationAudioProcessorEditor::~ImaginationAudioProcessorEditor()
     exciterEnhancerSlider.setLookAndFeel(nullptr);
 }
 
+//==============================================================================
+void ImaginationAudioProcessorEditor::timerCallback()
+{
+    IMAGINATION_TRACE_SCOPE("editor timer");
+
+    // Let the scheduler know how much this editor's analysis matters right now
+    if (! isShowing())
+        analysis.setPriority(AnalysisScheduler::Priority::hidden);
+    else if (auto* peer = getPeer(); peer != nullptr && peer->isFocused())
+        analysis.setPriority(AnalysisScheduler::Priority::focused);
+    else
+        analysis.setPriority(AnalysisScheduler::Priority::visible);
+
+    widthGuardMeter.setGuardEnabled(audioProcessor.getWidthGuardParam()->get());
+    widthGuardMeter.setGain(audioProcessor.getWidthGuardGain());
+
+    analysis.setPolarEnabled(visualizer.getDisplayMode() == VisualizerComponent::DisplayMode::polar);
+
+    if (analysis.fetchVectorscope(vectorscopePoints))
+        visualizer.setStereoPoints(vectorscopePoints);
+
+    if (analysis.fetchPolar(polarFrame))
+        visualizer.setPolarFrame(polarFrame);
+
+    updateComparison();
+    updateQuality();
+
+    for (;;)
+    {
+        const int numReadings = analysis.fetchCorrelations(correlationReadings.data(), static_cast<int>(correlationReadings.size()));
+
+        if (numReadings == 0)
+            break;
+
+        phaseCorrelationMeter.addReadings(correlationReadings.data(), numReadings);
+    }
+}
+
+void ImaginationAudioProcessorEditor::updateQuality()
+{
+    const auto& governor = audioProcessor.getQualityGovernor();
+    const auto tier = governor.getTier();
+    const auto numOverruns = governor.getNumOverruns();
+
+    juce::String text;
+
+    if (tier != QualityGovernor::Tier::full)
+        text << "QUALITY " << QualityGovernor::getTierName(tier);
+
+    if (numOverruns > 0)
+        text << (text.isEmpty() ? "" : "  ") << juce::String(numOverruns) << (numOverruns == 1 ? " OVERRUN" : " OVERRUNS");
+
+    // Label::setText does nothing when the text is unchanged
+    qualityLabel.setText(text, juce::dontSendNotification);
+}
+
+void ImaginationAudioProcessorEditor::publishClicked()
+{
+    if (audioProcessor.getComparisonName().isNotEmpty())
+    {
+        audioProcessor.setComparisonName({});
+        publishButton.setToggleState(false, juce::dontSendNotification);
+        return;
+    }
+
+    auto* window = new juce::AlertWindow("Publish Analysis", "Other instances can compare against this one under this name.",
+                                         juce::MessageBoxIconType::NoIcon, this);
+    window->addTextEditor("name", "Imagination", "Name");
+    window->addButton("Publish", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    window->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<ImaginationAudioProcessorEditor> safeThis(this);
+
+    window->enterModalState(true, juce::ModalCallbackFunction::create([safeThis, window](int result)
+    {
+        if (safeThis == nullptr)
+            return;
+
+        const auto name = window->getTextEditorContents("name").trim();
+
+        if (result == 1 && name.isNotEmpty())
+            safeThis->audioProcessor.setComparisonName(name);
+
+        safeThis->publishButton.setToggleState(safeThis->audioProcessor.getComparisonName().isNotEmpty(), juce::dontSendNotification);
+    }), true);
+}
+
+void ImaginationAudioProcessorEditor::refreshComparisonList()
+{
+    auto publishers = comparisonBus->getPublishers();
+    const int ownSlot = audioProcessor.getComparisonSlot();
+
+    publishers.erase(std::remove_if(publishers.begin(), publishers.end(),
+                                    [ownSlot](const ComparisonBus::Publisher& p) { return p.slot == ownSlot; }),
+                     publishers.end());
+
+    auto same = [](const ComparisonBus::Publisher& a, const ComparisonBus::Publisher& b)
+    {
+        return a.slot == b.slot && a.generation == b.generation && a.name == b.name;
+    };
+
+    if (std::equal(publishers.begin(), publishers.end(), comparisonPublishers.begin(), comparisonPublishers.end(), same))
+        return;
+
+    comparisonPublishers = std::move(publishers);
+    compareBox.clear(juce::dontSendNotification);
+    compareBox.addItem("NO COMPARISON", 1);
+
+    int selectedId = 1;
+
+    for (size_t i = 0; i < comparisonPublishers.size(); ++i)
+    {
+        const auto& publisher = comparisonPublishers[i];
+        compareBox.addItem(publisher.name, static_cast<int>(i) + 2);
+
+        if (publisher.slot == comparedPublisher.slot && publisher.generation == comparedPublisher.generation)
+            selectedId = static_cast<int>(i) + 2;
+    }
+
+    // The instance we were comparing against has gone away
+    if (selectedId == 1 && comparedPublisher.slot >= 0)
+        setComparedPublisher(-1);
+
+    compareBox.setSelectedId(selectedId, juce::dontSendNotification);
+}
+
+void ImaginationAudioProcessorEditor::setComparedPublisher (int index)
+{
+    comparedPublisher = juce::isPositiveAndBelow(index, static_cast<int>(comparisonPublishers.size()))
+                          ? comparisonPublishers[static_cast<size_t>(index)]
+                          : ComparisonBus::Publisher();
+    comparisonFrame.frameNumber = 0;
+
+    visualizer.clearComparison();
+    phaseCorrelationMeter.clearComparison();
+}
+
+void ImaginationAudioProcessorEditor::updateComparison()
+{
+    // Other instances come and go rarely; once a second is plenty
+    if (--comparisonListCountdown <= 0)
+    {
+        refreshComparisonList();
+        comparisonListCountdown = 30;
+    }
+
+    if (comparedPublisher.slot < 0)
+        return;
+
+    const auto previousFrame = comparisonFrame.frameNumber;
+
+    if (! comparisonBus->read(comparedPublisher, comparisonFrame))
+        return;
+
+    visualizer.setComparison(comparedPublisher.name, comparisonFrame);
+
+    // Frames arrive at the meter's reading rate; repeat the newest for any
+    // this timer missed, so both histories keep the same time scale
+    const auto missed = previousFrame == 0 ? 1u : comparisonFrame.frameNumber - previousFrame;
+    const int numReadings = static_cast<int>(juce::jlimit(1u, static_cast<juce::uint32>(correlationReadings.size()), missed));
+
+    std::fill_n(correlationReadings.begin(), numReadings, comparisonFrame.correlation);
+    phaseCorrelationMeter.addComparisonReadings(correlationReadings.data(), numReadings);
+}
+
 //==============================================================================
 void ImaginationAudioProcessorEditor::paint (juce::Graphics& g)
 {
+    IMAGINATION_TRACE_SCOPE("editor paint");
+
+    // The platforms only depend on the editor size, so they are rendered once
+    // per size and display scale and shared by every open editor.
+    const auto scale = static_cast<float>(g.getInternalContext().getPhysicalPixelScaleFactor());
+    auto background = sharedResources->getCachedImage("editorBackground", getWidth(), getHeight(), scale,
+                                                      [this](juce::Graphics& bg) { paintBackground(bg); });
+
+    g.drawImage(background, getLocalBounds().toFloat());
+}
+
+void ImaginationAudioProcessorEditor::paintBackground (juce::Graphics& g)
+{
+    IMAGINATION_TRACE_SCOPE("paintBackground");
+
 //     Load the image from memory
 //    juce::Image backgroundImage = juce::ImageCache::getFromMemory(BinaryData::fe36a0a008a9654494bd357bb1b564a3_jpg, BinaryData::fe36a0a008a9654494bd357bb1b564a3_jpgSize);
 ////
@@ -176,6 +393,7 @@ void ImaginationAudioProcessorEditor::paint (juce::Graphics& g)
        auto phaseMeterArea = area.removeFromBottom(phaseMeterHeight).withSizeKeepingCentre(visualizerWidth, phaseMeterHeight);
 
        auto drawLiftedPlatform = [&](juce::Rectangle<int> area) {
+           IMAGINATION_TRACE_SCOPE("drawLiftedPlatform");
            juce::Rectangle<float> platformArea = area.toFloat();
 
            // Background shadow
@@ -213,6 +431,23 @@ void ImaginationAudioProcessorEditor::paint (juce::Graphics& g)
 
 void ImaginationAudioProcessorEditor::resized()
 {
+    // The preset button sits in the top margin, centred over the visualizer
+    presetButton.setBounds(getLocalBounds().removeFromTop(20).withSizeKeepingCentre(100, 16));
+
+    // Headphone mode and its speaker angle share the margin, on the right
+    auto binauralArea = getLocalBounds().removeFromTop(20).removeFromRight(260).reduced(20, 2);
+    binauralButton.setBounds(binauralArea.removeFromLeft(90));
+    binauralAngleSlider.setBounds(binauralArea);
+
+    // Publishing and comparing on the left
+    auto comparisonArea = getLocalBounds().removeFromTop(20).removeFromLeft(260).reduced(20, 2);
+    publishButton.setBounds(comparisonArea.removeFromLeft(80));
+    comparisonArea.removeFromLeft(4);
+    compareBox.setBounds(comparisonArea);
+
+    // The quality tier in the bottom margin, under the width slider
+    qualityLabel.setBounds(getLocalBounds().removeFromBottom(20).removeFromRight(260).reduced(20, 2));
+
     auto area = getLocalBounds().reduced(20);
     auto sliderWidth = 80;
     auto sliderHeight = 75;
@@ -272,7 +507,14 @@ void ImaginationAudioProcessorEditor::resized()
     int rightLabelTopPadding = 30;
     int rightLabelHeight = 15;
     int rightSliderTopPadding = rightLabelTopPadding + rightLabelHeight + 5;
+    int guardButtonHeight = 20;
+    int guardMeterWidth = 6;
+    int rightSliderHeight = rightArea.getHeight() - rightSliderTopPadding - guardButtonHeight;
     
     widthLabel.setBounds(rightArea.getX(), rightLabelTopPadding, sliderWidth, rightLabelHeight);
-    widthSlider.setBounds(rightArea.getX(), rightSliderTopPadding, sliderWidth, rightArea.getHeight() - rightSliderTopPadding);
+    widthSlider.setBounds(rightArea.getX(), rightSliderTopPadding, sliderWidth - guardMeterWidth, rightSliderHeight);
+    
+    // The reduction meter runs alongside the slider track, above its text box
+    widthGuardMeter.setBounds(rightArea.getRight() - guardMeterWidth - 4, rightSliderTopPadding, guardMeterWidth, rightSliderHeight - labelHeight);
+    widthGuardButton.setBounds(rightArea.getX() + 4, rightSliderTopPadding + rightSliderHeight, sliderWidth - 8, guardButtonHeight);
 }
@@ -12,14 +12,20 @@
 #include "PluginProcessor.h"
 #include "VisualizerComponent.h"
 #include <optional>
+#include <algorithm>
 #include "CustomLookAndFeel.h"
 #include "PhaseCorrelationMeter.h"
 #include "CustomLookAndFeelVerticalSlider.h"
+#include "SharedEditorResources.h"
+#include "EditorAnalysis.h"
+#include "WidthGuardMeter.h"
+#include "PresetBrowser.h"
+#include "ComparisonBus.h"
 //==============================================================================
 /**
 */
-class ImaginationAudioProcessorEditor  : public juce::AudioProcessorEditor
-                                        
+class ImaginationAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                         private juce::Timer
 {
 public:
     ImaginationAudioProcessorEditor (ImaginationAudioProcessor&);
@@ -33,6 +39,17 @@ public:
     PhaseCorrelationMeter phaseCorrelationMeter;
 
 private:
+    void timerCallback() override;
+    void paintBackground (juce::Graphics&);
+    void publishClicked();
+    void refreshComparisonList();
+    void setComparedPublisher (int index);
+    void updateComparison();
+    void updateQuality();
+
+    // Shared across every open editor, so it is declared before the components using it
+    juce::SharedResourcePointer<SharedEditorResources> sharedResources;
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     ImaginationAudioProcessor& audioProcessor;
@@ -45,6 +62,13 @@ private:
 //    juce::Slider depthSlider;
     juce::Slider crossfeedSlider;
     juce::Slider exciterEnhancerSlider;
+    juce::ToggleButton widthGuardButton { "GUARD" };
+    juce::TextButton presetButton { "PRESETS" };
+    juce::ToggleButton binauralButton { "BINAURAL" };
+    juce::Slider binauralAngleSlider;
+    juce::TextButton publishButton { "PUBLISH" };
+    juce::ComboBox compareBox;
+    WidthGuardMeter widthGuardMeter;
 
     juce::Label widthLabel;
     juce::Label balanceLabel;
@@ -54,6 +78,22 @@ private:
 //    juce::Label depthLabel;
     juce::Label crossfeedLabel;
     juce::Label exciterEnhancerLabel;
+
+    // The quality tier the processor has dropped to, and its overruns
+    juce::Label qualityLabel;
+    
+    // Runs on the shared analysis threads; the timer only collects its results
+    EditorAnalysis analysis;
+    std::vector<juce::Point<float>> vectorscopePoints;
+    PolarHistogram::Frame polarFrame;
+    std::array<float, 64> correlationReadings {};
+
+    // Another instance's analysis, overlaid on our own
+    juce::SharedResourcePointer<ComparisonBus> comparisonBus;
+    std::vector<ComparisonBus::Publisher> comparisonPublishers;   // compareBox items after the first
+    ComparisonBus::Publisher comparedPublisher;                   // slot -1 while not comparing
+    ComparisonFrame comparisonFrame;
+    int comparisonListCountdown = 0;
     
     std::optional<juce::AudioProcessorValueTreeState::SliderAttachment> widthAttachment;
     std::optional<juce::AudioProcessorValueTreeState::SliderAttachment> balanceAttachment;
@@ -63,11 +103,10 @@ private:
 //    std::optional<juce::AudioProcessorValueTreeState::SliderAttachment> depthAttachment;
     std::optional<juce::AudioProcessorValueTreeState::SliderAttachment> crossfeedAttachment;
     std::optional<juce::AudioProcessorValueTreeState::SliderAttachment> exciterEnhancerAttachment;
+    std::optional<juce::AudioProcessorValueTreeState::ButtonAttachment> widthGuardAttachment;
+    std::optional<juce::AudioProcessorValueTreeState::ButtonAttachment> binauralAttachment;
+    std::optional<juce::AudioProcessorValueTreeState::SliderAttachment> binauralAngleAttachment;
 
-    CustomLookAndFeel customLookAndFeel;
-    CustomLookAndFeelVerticalSlider customLookAndFeelVerticalSlider;
-    
-    juce::Image backgroundImage;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImaginationAudioProcessorEditor)
 };
@@ -9,7 +9,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "Param.h"
-#include "VisualizerComponent.h"
 
 //==============================================================================
 ImaginationAudioProcessor::ImaginationAudioProcessor()
@@ -39,10 +38,53 @@ apvts(*this, nullptr, "Parameters", createParameterLayout())
     storeFloatParam(crossfeed, ParamIDs::crossfeed);
     storeFloatParam(stereoSpread, ParamIDs::stereoSpread);
     storeFloatParam(exciterEnhancer, ParamIDs::exciterEnhancer);
+    storeFloatParam(widthGuardThreshold, ParamIDs::widthGuardThreshold);
+    storeFloatParam(binauralAngle, ParamIDs::binauralAngle);
+    storeFloatParam(transientWidth, ParamIDs::transientWidth);
+    storeFloatParam(transientExciter, ParamIDs::transientExciter);
+
+    widthGuard = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(ParamIDs::widthGuard));
+    jassert(widthGuard != nullptr);
+
+    binaural = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(ParamIDs::binaural));
+    jassert(binaural != nullptr);
+
+    transientSplit = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(ParamIDs::transientSplit));
+    jassert(transientSplit != nullptr);
+
+    parameterTracker.track(ParamIDs::inputGain, inputGainDirty);
+    parameterTracker.track(ParamIDs::outputGain, outputGainDirty);
+
+    for (auto* paramID : { ParamIDs::width, ParamIDs::balance, ParamIDs::midSide, ParamIDs::crossfeed, ParamIDs::exciterEnhancer,
+                           ParamIDs::widthGuard, ParamIDs::widthGuardThreshold,
+                           ParamIDs::transientSplit, ParamIDs::transientWidth, ParamIDs::transientExciter })
+        parameterTracker.track(paramID, imagerDirty);
+
+    parameterTracker.track(ParamIDs::binaural, binauralDirty);
+    parameterTracker.track(ParamIDs::binauralAngle, binauralDirty);
+
+    // Presets are compared by their normalised values over every parameter
+    std::vector<PresetLibrary::FingerprintParameter> fingerprintParameters;
+
+    for (auto* paramID : { ParamIDs::width, ParamIDs::balance, ParamIDs::inputGain, ParamIDs::outputGain, ParamIDs::midSide,
+                           ParamIDs::stereoSpread, ParamIDs::crossfeed, ParamIDs::exciterEnhancer,
+                           ParamIDs::widthGuard, ParamIDs::widthGuardThreshold, ParamIDs::binaural, ParamIDs::binauralAngle,
+                           ParamIDs::transientSplit, ParamIDs::transientWidth, ParamIDs::transientExciter })
+    {
+        auto* param = apvts.getParameter(paramID);
+        fingerprintParameters.push_back({ paramID, param->getNormalisableRange(), param->getDefaultValue() });
+    }
+
+    presetLibrary->setFingerprintParameters(fingerprintParameters);
+
+    if (auto directory = juce::SystemStats::getEnvironmentVariable("IMAGINATION_CAPTURE_DIR", {}); directory.isNotEmpty())
+        captureDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(directory);
+    presetLibrary->addChangeListener(this);
 }
 
 ImaginationAudioProcessor::~ImaginationAudioProcessor()
 {
+    presetLibrary->removeChangeListener(this);
 }
 
 //==============================================================================
@@ -85,22 +127,49 @@ double ImaginationAudioProcessor::getTailLengthSeconds() const
 
 int ImaginationAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so with an empty library there is still the one initial program.
+    return juce::jmax(1, presetLibrary->getIndex()->size());
 }
 
 int ImaginationAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
 void ImaginationAudioProcessor::setCurrentProgram (int index)
 {
+    const auto presets = presetLibrary->getIndex();
+
+    if (juce::isPositiveAndBelow(index, presets->size()))
+        applyPreset(presets->getFile(index));
+}
+
+bool ImaginationAudioProcessor::applyPreset (const juce::File& presetFile)
+{
+    // The preset file is only read now, when it is actually applied
+    const auto state = presetLibrary->loadState(presetFile);
+
+    if (! state.hasType(apvts.state.getType()))
+        return false;
+
+    apvts.replaceState(state);
+    parameterTracker.markAllDirty();
+
+    // Programs are remembered by file, since a rescan can move them in the index
+    currentPresetFile = presetFile;
+    currentProgram = juce::jmax(0, presetLibrary->getIndex()->indexOf(presetFile));
+    return true;
 }
 
 const juce::String ImaginationAudioProcessor::getProgramName (int index)
 {
-    return {};
+    const auto presets = presetLibrary->getIndex();
+
+    if (juce::isPositiveAndBelow(index, presets->size()))
+        return presets->getName(index);
+
+    return index == 0 ? "Init" : juce::String();
 }
 
 void ImaginationAudioProcessor::changeProgramName (int index, const juce::String& newName)
@@ -117,11 +186,160 @@ void ImaginationAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
-    dryWetMixer.prepare(spec);
+    if (capture.isCapturing())
+        capture.recordPrepare(sampleRate, samplesPerBlock, isNonRealtime());
+    else if (captureDirectory != juce::File() && captureDirectory.createDirectory())
+        beginCapture(captureDirectory.getNonexistentChildFile("capture-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S"),
+                                                              ProcessCapture::fileExtension, false),
+                     sampleRate, samplesPerBlock);
+
+    // Hot buffers first; with the same or a smaller spec the arena is reused as is
+    const auto maximumBlockSize = static_cast<size_t>(samplesPerBlock);
+    arena.beginLayout();
+    transientWeightsRegion = arena.addArray<float>("imager transient weights", maximumBlockSize, DspArena::Temperature::hot);
+    binauralCrossRegion = arena.addArray<float>("binaural crossed channels", 2 * maximumBlockSize, DspArena::Temperature::hot);
+    binauralLowCostRegion = arena.addArray<float>("binaural low-cost path", 2 * maximumBlockSize, DspArena::Temperature::cold);
+    binauralFadeRegion = arena.addArray<float>("binaural response fade", 4 * maximumBlockSize, DspArena::Temperature::cold);
+    binauralHistoryRegion = arena.addArray<float>("binaural input history", 2 * BinauralRenderer::historyLength, DspArena::Temperature::cold);
+    comparisonPointsRegion = arena.addArray<juce::Point<float>>("comparison point ring", ComparisonFrame::maxPoints, DspArena::Temperature::cold);
+    arena.allocate();
+
+    configureQuality(spec);
+
+    // Built from the current angle before prepare returns
+    binauralRenderer.setSpeakerAngle(binauralAngle->get());
+    binauralRenderer.prepare(spec, ! isNonRealtime(), arena.get<float>(binauralCrossRegion),
+                             arena.get<float>(binauralLowCostRegion), arena.get<float>(binauralFadeRegion),
+                             arena.get<float>(binauralHistoryRegion));
+
     inputGainProcessor.prepare(spec);
     outputGainProcessor.prepare(spec);
-    inputGainProcessor.setGainDecibels(inputGain->get());
-    outputGainProcessor.setGainDecibels(outputGain->get());
+    parameterTracker.markAllDirty();
+    updateStereoImagerParams();
+
+    // Start every render from the same state, so offline bounces are reproducible
+    inputGainProcessor.reset();
+    outputGainProcessor.reset();
+    stereoImager.reset();
+    binauralRenderer.reset();
+
+    analysisModel.setSampleRate(sampleRate);
+    comparisonPublisher.prepare(sampleRate, arena.get<juce::Point<float>>(comparisonPointsRegion));
+}
+
+void ImaginationAudioProcessor::configureQuality (const juce::dsp::ProcessSpec& spec)
+{
+    // Hosts switch to offline rendering before calling prepareToPlay, so this
+    // is the one place the configuration (and the reported latency) changes.
+    highQualityMode = isNonRealtime();
+
+    // Without ramps every parameter would step at block boundaries, and how
+    // audible that is would depend on the host's buffer size
+    inputGainProcessor.setRampDurationSeconds(parameterSmoothingSeconds);
+    outputGainProcessor.setRampDurationSeconds(parameterSmoothingSeconds);
+
+    // Offline renders have no deadline, and must not vary with machine load
+    qualityGovernor.prepare(spec.sampleRate, ! highQualityMode);
+
+    if (! highQualityMode)
+    {
+        stereoImager.prepare(spec.sampleRate, spec.sampleRate, arena.get<float>(transientWeightsRegion),
+                             static_cast<int>(spec.maximumBlockSize), parameterSmoothingSeconds, false);
+        setLatencySamples(0);
+        return;
+    }
+
+    // Building the filters is expensive, so the oversampler is kept once created
+    if (exciterOversampler == nullptr || exciterOversamplerChannels != spec.numChannels)
+    {
+        exciterOversampler = std::make_unique<juce::dsp::Oversampling<float>>(spec.numChannels, highQualityOversamplingOrder,
+                                                                              juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+                                                                              true, true);
+        exciterOversamplerChannels = spec.numChannels;
+    }
+
+    exciterOversampler->initProcessing(spec.maximumBlockSize);
+    exciterOversampler->reset();
+
+    const auto oversampledRate = spec.sampleRate * static_cast<double>(exciterOversampler->getOversamplingFactor());
+    stereoImager.prepare(spec.sampleRate, oversampledRate, arena.get<float>(transientWeightsRegion),
+                         static_cast<int>(spec.maximumBlockSize), parameterSmoothingSeconds, true);
+    setLatencySamples(juce::roundToInt(exciterOversampler->getLatencyInSamples()));
+}
+
+void ImaginationAudioProcessor::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    // The library was rescanned, so the program list may have changed and
+    // the current preset may have moved
+    if (currentPresetFile != juce::File())
+        currentProgram = juce::jmax(0, presetLibrary->getIndex()->indexOf(currentPresetFile));
+
+    updateHostDisplay(ChangeDetails().withProgramChanged(true));
+}
+
+bool ImaginationAudioProcessor::startCapture (const juce::File& file)
+{
+    return beginCapture(file, getSampleRate(), getBlockSize());
+}
+
+void ImaginationAudioProcessor::stopCapture()
+{
+    capture.stop();
+}
+
+bool ImaginationAudioProcessor::beginCapture (const juce::File& file, double sampleRate, int maximumBlockSize)
+{
+    // Replay maps values back by ID, in getParameters() order
+    juce::StringArray parameterIDs;
+
+    for (auto* parameter : getParameters())
+        if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+            parameterIDs.add(withID->paramID);
+
+    jassert(parameterIDs.size() == getParameters().size());
+    return capture.start(file, parameterIDs, sampleRate, maximumBlockSize, isNonRealtime());
+}
+
+double ImaginationAudioProcessor::getWarmUpSeconds() const noexcept
+{
+    double seconds = stereoImager.getWarmUpSeconds();
+
+    if (binauralEnabled && getSampleRate() > 0.0)
+        seconds += BinauralRenderer::responseLength / getSampleRate();
+
+    // The gain ramps start at their targets on prepare, so only the
+    // oversampler's filter history adds to the imager's own state
+    if (highQualityMode && exciterOversampler != nullptr && getSampleRate() > 0.0)
+        seconds += 2.0 * exciterOversampler->getLatencyInSamples() / getSampleRate();
+
+    return seconds;
+}
+
+juce::String ImaginationAudioProcessor::getMemoryReport() const
+{
+    auto report = arena.getReport();
+
+    // The analysis FIFO is read by editor threads that keep running through
+    // a prepare, so it is allocated once in the constructor rather than in
+    // an arena that may move. The JUCE engines allocate for themselves and
+    // report nothing, so theirs are estimates of the buffers alone.
+    report << "outside the arena:" << juce::newLine
+           << "  processor object (fixed-size state) " << static_cast<juce::int64>(sizeof(*this)) << " B" << juce::newLine
+           << "  analysis FIFO " << static_cast<juce::int64>(analysisModel.getCapacity()) * 2 * static_cast<juce::int64>(sizeof(float))
+           << " B" << juce::newLine
+           << "  binaural convolution engines (juce::dsp::Convolution) about "
+           << static_cast<juce::int64>(BinauralRenderer::getEngineBytesEstimate()) << " B" << juce::newLine;
+
+    if (exciterOversampler != nullptr)
+    {
+        // Each stage doubles the rate and keeps a buffer at its output rate
+        const auto oversampledSamples = static_cast<juce::int64>(exciterOversampler->getOversamplingFactor() - 1) * 2
+                                      * static_cast<juce::int64>(getBlockSize());
+        report << "  exciter oversampler (juce::dsp::Oversampling) about "
+               << oversampledSamples * exciterOversamplerChannels * static_cast<juce::int64>(sizeof(float)) << " B" << juce::newLine;
+    }
+
+    return report;
 }
 
 void ImaginationAudioProcessor::releaseResources()
@@ -158,14 +376,56 @@ bool ImaginationAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void ImaginationAudioProcessor::updateStereoImagerParams()
 {
-    dryWetMixer.setWetMixProportion(width->get() * 0.01f);
-    inputGainProcessor.setGainDecibels(inputGain->get());
-    outputGainProcessor.setGainDecibels(outputGain->get());
+    const auto dirty = parameterTracker.takeDirtyFlags();
+
+    if (dirty == 0)
+        return;
+
+    if (dirty & inputGainDirty)
+        inputGainProcessor.setGainDecibels(inputGain->get());
+
+    if (dirty & outputGainDirty)
+        outputGainProcessor.setGainDecibels(outputGain->get());
+
+    if (dirty & binauralDirty)
+    {
+        binauralEnabled = binaural->get();
+
+        // Switching binaural on marks this dirty too, so the angle catches up
+        // then; until then, moving it does not wake the response builder
+        if (binauralEnabled)
+            binauralRenderer.setSpeakerAngle(binauralAngle->get());
+    }
+
+    if (dirty & imagerDirty)
+        stereoImager.setSettings(getImagerSettings());
+}
+
+StereoImagerSettings ImaginationAudioProcessor::getImagerSettings() const
+{
+    auto settings = StereoImager::makeSettings(width->get(), balance->get(), midSide->get(),
+                                               crossfeed->get(), exciterEnhancer->get());
+    settings.widthGuard = widthGuard->get();
+    settings.widthGuardThreshold = widthGuardThreshold->get();
+    settings.transientSplit = transientSplit->get();
+    settings.transientWidthFactor = StereoImager::widthFactorFor(transientWidth->get());
+    settings.transientExciterAmount = transientExciter->get() * 0.01f;
+    return settings;
+}
+
+float ImaginationAudioProcessor::getStaticGain() const
+{
+    return juce::Decibels::decibelsToGain(inputGain->get()) * juce::Decibels::decibelsToGain(outputGain->get());
 }
 
 void ImaginationAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    IMAGINATION_TRACE_SCOPE("processBlock");
     juce::ScopedNoDenormals noDenormals;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    const auto qualityTier = qualityGovernor.getTier();
+    capture.recordBlock(buffer, getParameters());
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     
@@ -175,92 +435,75 @@ void ImaginationAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     juce::dsp::AudioBlock<float> block(buffer);
     juce::dsp::ProcessContextReplacing<float> context(block);
     
-    updateStereoImagerParams();
+    {
+        IMAGINATION_TRACE_SCOPE("parameters");
+        updateStereoImagerParams();
+    }
     
-    inputGainProcessor.process(context);
-    dryWetMixer.pushDrySamples(context.getInputBlock());
-    dryWetMixer.mixWetSamples(context.getOutputBlock());
-    outputGainProcessor.process(context);
+    {
+        IMAGINATION_TRACE_SCOPE("gain");
+        inputGainProcessor.process(context);
+        outputGainProcessor.process(context);
+    }
     
-    // Precompute factors
-    float widthSliderValue = width->get();
-    float widthFactor = (widthSliderValue >= 50.0f) ? 1.0f + (widthSliderValue - 50.0f) * 0.02f : widthSliderValue * 0.02f;
-
-    float balanceValue = balance->get();
-    float midSideValue = midSide->get();
-    // float depthFactor = depth->get() * 0.01f;
-    float crossfeedFactor = crossfeed->get();
-    float exciterEnhancerFactor = exciterEnhancer->get() * 0.01f;
+    {
+        IMAGINATION_TRACE_SCOPE("matrix");
+        stereoImager.processStereo(context);
+        widthGuardGain.store(stereoImager.takeWidthGuardGain(), std::memory_order_relaxed);
+    }
 
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    if (highQualityMode && exciterOversampler != nullptr)
     {
-        float left = buffer.getSample(0, sample);
-        float right = buffer.getSample(1, sample);
-
-        // Width processing
-        float mid = (left + right) * 0.5f;
-        float side = (left - right) * 0.5f;
-        left = mid + side * widthFactor;
-        right = mid - side * widthFactor;
-
-        // Balance processing
-        if (balanceValue <= 0.0f)
-            left *= 1.0f;
-        else
-            left *= 1.0f - balanceValue;
+        IMAGINATION_TRACE_SCOPE("exciter (oversampled)");
+        auto oversampledBlock = exciterOversampler->processSamplesUp(context.getInputBlock());
+        stereoImager.processExciter(oversampledBlock);
+        exciterOversampler->processSamplesDown(context.getOutputBlock());
+    }
+    else
+    {
+        IMAGINATION_TRACE_SCOPE("exciter");
+        stereoImager.processExciter(context.getOutputBlock());
+    }
 
-        if (balanceValue >= 0.0f)
-            right *= 1.0f;
-        else
-            right *= 1.0f + balanceValue;
-
-        // Mid/side processing
-        mid = (left + right) * 0.5f;
-        side = (left - right) * 0.5f;
-        mid += side * midSideValue;
-        side -= side * midSideValue;
-        left = mid + side;
-        right = mid - side;
-
-        // Depth processing
-        // left *= depthFactor;
-        // right *= depthFactor;
-
-        // Crossfeed processing (calculated outside the buffer setSample to avoid feedback)
-        float leftCrossfeed = left + crossfeedFactor * right;
-        float rightCrossfeed = right + crossfeedFactor * left;
-
-        buffer.setSample(0, sample, leftCrossfeed);
-        buffer.setSample(1, sample, rightCrossfeed);
+    if (binauralEnabled && ! binauralWasEnabled)
+        binauralRenderer.reset();
+
+    binauralWasEnabled = binauralEnabled;
+    binauralRenderer.setLowCost(qualityTier == QualityGovernor::Tier::minimal);
+
+    if (binauralEnabled)
+    {
+        IMAGINATION_TRACE_SCOPE("binaural");
+        binauralRenderer.process(context);
     }
-    
-    // Exciter/enhancer processing
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+
+    // Hand the processed audio to the editor's analysis, if one is listening,
+    // and to the comparison bus, if this instance is publishing. Every block
+    // goes to both so their clocks stay right; below the full tier they do
+    // less with it instead.
+    if (buffer.getNumChannels() > 0)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            float sampleValue = channelData[sample];
-            // Apply a simple harmonic excitation
-            float excitedSample = sampleValue + exciterEnhancerFactor * sampleValue * sampleValue;
-            channelData[sample] = excitedSample;
-        }
+        IMAGINATION_TRACE_SCOPE("analysis handoff");
+        const auto* left = buffer.getReadPointer(0);
+        const auto* right = buffer.getReadPointer(buffer.getNumChannels() > 1 ? 1 : 0);
+        const bool reducedAnalysis = qualityTier != QualityGovernor::Tier::full;
+
+        analysisModel.setReducedRate(reducedAnalysis);
+        comparisonPublisher.setReducedRate(reducedAnalysis);
+        analysisModel.pushSamples(left, right, buffer.getNumSamples());
+        comparisonPublisher.process(left, right, buffer.getNumSamples());
     }
-    
-    // Update visualizer and phase correlation meter
-    if (auto* editor = dynamic_cast<ImaginationAudioProcessorEditor*>(getActiveEditor()))
+
+    // Pick the next block's tier, and publish this block's metrics for external monitoring
+    if (buffer.getNumSamples() > 0 && getSampleRate() > 0.0)
     {
-        std::vector<float> leftChannel(buffer.getNumSamples());
-        std::vector<float> rightChannel(buffer.getNumSamples());
-        
-        if (buffer.getNumChannels() > 0)
-            std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + buffer.getNumSamples(), leftChannel.begin());
-        
-        if (buffer.getNumChannels() > 1)
-            std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + buffer.getNumSamples(), rightChannel.begin());
-        
-        editor->visualizer.setAudioData(leftChannel, rightChannel);
-        editor->phaseCorrelationMeter.setAudioData(leftChannel, rightChannel);
+        const auto blockSeconds = buffer.getNumSamples() / getSampleRate();
+        const auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        qualityGovernor.update(elapsedSeconds, buffer.getNumSamples());
+
+        IMAGINATION_TRACE_SCOPE("metrics");
+        metricsPublisher.publish(buffer, getSampleRate(), elapsedSeconds / blockSeconds,
+                                 static_cast<int>(qualityTier), qualityGovernor.getNumOverruns());
     }
 }
 
@@ -283,7 +526,18 @@ void ImaginationAudioProcessor::getStateInformation (juce::MemoryBlock& destData
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
     juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    auto state = apvts.copyState();
+
+    if (comparisonName.isNotEmpty())
+        state.setProperty(comparisonNameProperty, comparisonName, nullptr);
+
+    state.writeToStream(mos);
+}
+
+void ImaginationAudioProcessor::setComparisonName (const juce::String& name)
+{
+    comparisonName = name;
+    comparisonPublisher.setName(name);
 }
 
 void ImaginationAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -293,8 +547,14 @@ void ImaginationAudioProcessor::setStateInformation (const void* data, int sizeI
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid()) 
     {
+        // The bus name belongs to the session, so it stays out of the parameter state
+        const auto name = tree.getProperty(comparisonNameProperty).toString();
+        tree.removeProperty(comparisonNameProperty, nullptr);
+
+        // Recomputed by the next block rather than from this thread
         apvts.replaceState(tree);
-        updateStereoImagerParams();
+        parameterTracker.markAllDirty();
+        setComparisonName(name);
     }
 }
 
@@ -394,6 +654,55 @@ juce::AudioProcessorValueTreeState::ParameterLayout ImaginationAudioProcessor::c
         percentFormat,
         nullptr));
 
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ ParamIDs::widthGuard, 1 },
+        "Width Guard",
+        false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ ParamIDs::widthGuardThreshold, 1 },
+        "Width Guard Threshold",
+        juce::NormalisableRange<float>{ -1.0f, 1.0f, 0.01f, 1.0f },
+        0.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        nullptr,
+        nullptr));
+
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ ParamIDs::binaural, 1 },
+        "Binaural",
+        false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ ParamIDs::binauralAngle, 1 },
+        "Binaural Speaker Angle",
+        juce::NormalisableRange<float>{ BinauralRenderer::minimumAngle, BinauralRenderer::maximumAngle, 0.5f, 1.0f },
+        30.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        [](float value, int) { return juce::String(value, 1) + " deg"; },
+        [](const juce::String& text) { return text.upToFirstOccurrenceOf(" ", false, false).getFloatValue(); }));
+
+    // With the split on, width and exciterEnhancer set the sustain and these the transients
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ ParamIDs::transientSplit, 1 },
+        "Transient Split",
+        false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ ParamIDs::transientWidth, 1 },
+        "Transient Width",
+        juce::NormalisableRange<float>{ 0.0f, 100.0f, 0.01f, 1.0f },
+        50.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        percentFormat,
+        nullptr));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ ParamIDs::transientExciter, 1 },
+        "Transient Exciter",
+        juce::NormalisableRange<float>{ 0.0f, 100.0f, 0.01f, 1.0f },
+        0.0f,
+        juce::String(),
+        juce::AudioProcessorParameter::genericParameter,
+        percentFormat,
+        nullptr));
+
     return layout;
 }
 
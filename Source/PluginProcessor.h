@@ -9,12 +9,23 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "VisualizerComponent.h"
+#include "StereoImager.h"
+#include "BinauralRenderer.h"
+#include "StereoAnalysisModel.h"
+#include "MetricsPublisher.h"
+#include "ComparisonBus.h"
+#include "ProcessCapture.h"
+#include "ParameterChangeTracker.h"
+#include "PresetLibrary.h"
+#include "DspArena.h"
+#include "QualityGovernor.h"
+#include "TraceRecorder.h"
 
 //==============================================================================
 /**
 */
-class ImaginationAudioProcessor  : public juce::AudioProcessor
+class ImaginationAudioProcessor  : public juce::AudioProcessor,
+                                   private juce::ChangeListener
 {
 public:
     //==============================================================================
@@ -66,6 +77,68 @@ public:
     juce::AudioParameterFloat* getCrossfeedParam()       const { return crossfeed; }
     juce::AudioParameterFloat* getExciterEnhancerParam() const { return exciterEnhancer; }
     juce::AudioParameterFloat* getStereoSpreadParam()    const { return stereoSpread; }
+    juce::AudioParameterBool*  getWidthGuardParam()      const { return widthGuard; }
+    juce::AudioParameterFloat* getWidthGuardThresholdParam() const { return widthGuardThreshold; }
+    juce::AudioParameterBool*  getBinauralParam()        const { return binaural; }
+    juce::AudioParameterFloat* getBinauralAngleParam()   const { return binauralAngle; }
+    juce::AudioParameterBool*  getTransientSplitParam()  const { return transientSplit; }
+    juce::AudioParameterFloat* getTransientWidthParam()  const { return transientWidth; }
+    juce::AudioParameterFloat* getTransientExciterParam() const { return transientExciter; }
+
+    // Read-only output: the side gain factor the width guard applied during
+    // the last block (1 = no reduction). Safe to call from any thread.
+    float getWidthGuardGain() const noexcept { return widthGuardGain.load(std::memory_order_relaxed); }
+
+    // The imager settings and the combined input/output gain (linear) the
+    // current parameter values map to
+    StereoImagerSettings getImagerSettings() const;
+    float getStaticGain() const;
+
+    // True while prepared for offline rendering with the high-quality configuration
+    bool isHighQualityMode() const noexcept { return highQualityMode; }
+
+    // Preceding audio a freshly prepared instance needs to reach the same
+    // state as one that has been running (filters, smoothing, the width
+    // guard). Valid after prepareToPlay.
+    double getWarmUpSeconds() const noexcept;
+
+    // Processed audio handed to whichever editor is open
+    StereoAnalysisModel& getAnalysisModel() { return analysisModel; }
+
+    // Publishes this instance's analysis on the comparison bus under the
+    // given name, or stops with an empty one. Saved with the session, not
+    // with presets. Not on the audio thread.
+    void setComparisonName (const juce::String& name);
+    juce::String getComparisonName() const { return comparisonName; }
+
+    // This instance's own slot on the bus, -1 if it has never published
+    int getComparisonSlot() const noexcept { return comparisonPublisher.getSlot(); }
+
+    // Records everything processBlock receives until stopCapture(), for
+    // replay with Tools/CaptureReplay.cpp. With IMAGINATION_CAPTURE_DIR set
+    // in the environment, every instance captures from its next prepare.
+    bool startCapture (const juce::File& file);
+    void stopCapture();
+
+    // Programs are the entries of the shared preset library, in name order
+    PresetLibrary& getPresetLibrary() { return *presetLibrary; }
+
+    // Applies a preset by file, so the choice survives the index being
+    // rebuilt in between. Message thread.
+    bool applyPreset (const juce::File& presetFile);
+    juce::File getCurrentPresetFile() const { return currentPresetFile; }
+
+    // The DSP arena's layout and what is allocated outside it, for logs and
+    // tools. Not on the audio thread.
+    juce::String getMemoryReport() const;
+
+    // The quality tier realtime processing has dropped to under CPU
+    // pressure, and the overrun counts behind it. Any thread.
+    const QualityGovernor& getQualityGovernor() const noexcept { return qualityGovernor; }
+
+    // Off pins realtime processing to the full tier, for tools whose output
+    // must not depend on machine load. Call before prepareToPlay.
+    void setAdaptiveQualityEnabled (bool shouldAdapt) noexcept { qualityGovernor.setAdaptive(shouldAdapt); }
 
 
 private:
@@ -77,15 +150,80 @@ private:
     juce::AudioParameterFloat* stereoSpread    = nullptr;
     juce::AudioParameterFloat* crossfeed       = nullptr;
     juce::AudioParameterFloat* exciterEnhancer = nullptr;
+    juce::AudioParameterBool*  widthGuard      = nullptr;
+    juce::AudioParameterFloat* widthGuardThreshold = nullptr;
+    juce::AudioParameterBool*  binaural        = nullptr;
+    juce::AudioParameterFloat* binauralAngle   = nullptr;
+    juce::AudioParameterBool*  transientSplit  = nullptr;
+    juce::AudioParameterFloat* transientWidth  = nullptr;
+    juce::AudioParameterFloat* transientExciter = nullptr;
+
+    // What each group of parameters feeds, so processBlock only recomputes
+    // derived values (gains, the stereo matrix) for the groups that moved
+    enum DirtyFlags : juce::uint32
+    {
+        inputGainDirty  = 1 << 0,
+        outputGainDirty = 1 << 1,
+        imagerDirty     = 1 << 2,
+        binauralDirty   = 1 << 3
+    };
+
+    ParameterChangeTracker parameterTracker { apvts };
 
     void updateStereoImagerParams();
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+    void configureQuality (const juce::dsp::ProcessSpec& spec);
+    bool beginCapture (const juce::File& file, double sampleRate, int maximumBlockSize);
     
-    juce::AudioBuffer<float> visualizerBuffer;
-    VisualizerComponent visualizer;
+    StereoAnalysisModel analysisModel;
+    MetricsPublisher metricsPublisher;
+    ComparisonPublisher comparisonPublisher;
+    juce::String comparisonName;
+
+    ProcessCapture capture;
+    juce::File captureDirectory;
+    static constexpr const char* comparisonNameProperty = "comparisonName";
+
+    juce::SharedResourcePointer<PresetLibrary> presetLibrary;
+    int currentProgram = 0;
+    juce::File currentPresetFile;
+
+    // Spec-sized buffers for the stages below, laid out once per prepare
+    DspArena arena;
+    int transientWeightsRegion = -1;
+    int binauralCrossRegion = -1;
+    int binauralLowCostRegion = -1;
+    int binauralFadeRegion = -1;
+    int binauralHistoryRegion = -1;
+    int comparisonPointsRegion = -1;
 
-    juce::dsp::DryWetMixer<float> dryWetMixer;
     juce::dsp::Gain<float> inputGainProcessor;
     juce::dsp::Gain<float> outputGainProcessor;
+    StereoImager stereoImager;
+    std::atomic<float> widthGuardGain { 1.0f };
+
+    // Headphone mode, last in the chain; its convolution history is cleared
+    // when it is switched on so stale audio never leaks in
+    BinauralRenderer binauralRenderer;
+    bool binauralEnabled = false;
+    bool binauralWasEnabled = false;
+
+    // Offline renders (isNonRealtime) trade latency and CPU for quality: the
+    // exciter runs 4x oversampled with linear-phase filters and the matrix in
+    // doubles. Parameters ramp per sample in both modes.
+    static constexpr size_t highQualityOversamplingOrder = 2;
+    static constexpr double parameterSmoothingSeconds = 0.02;
+    bool highQualityMode = false;
+    std::unique_ptr<juce::dsp::Oversampling<float>> exciterOversampler;
+    juce::uint32 exciterOversamplerChannels = 0;
+
+    // Realtime only: sheds optional work when processBlock gets close to its deadline
+    QualityGovernor qualityGovernor;
+
+   #if IMAGINATION_ENABLE_TRACING
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;
+   #endif
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImaginationAudioProcessor)
 };
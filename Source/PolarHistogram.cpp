@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    PolarHistogram.cpp
+    Created: 20 Oct 2026 6:02:44pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "PolarHistogram.h"
+
+//==============================================================================
+PolarHistogram::PolarHistogram (double decay)
+    : decaySeconds(juce::jmax(0.01, decay))
+{
+}
+
+PolarHistogram::~PolarHistogram()
+{
+}
+
+void PolarHistogram::reset()
+{
+    bins.fill(0.0f);
+}
+
+float PolarHistogram::getAngleBinCentre (int angleBin) noexcept
+{
+    return (static_cast<float>(angleBin) + 0.5f) * (2.0f * maximumAngle / numAngleBins) - maximumAngle;
+}
+
+void PolarHistogram::fastAtan2 (const float* y, const float* x, float* result, int num) noexcept
+{
+    constexpr float pi = juce::MathConstants<float>::pi;
+    constexpr float halfPi = juce::MathConstants<float>::halfPi;
+
+    // Reduce to an octant, approximate atan on [0, 1] with an odd minimax
+    // polynomial, then unfold. Comparisons only ever become 0/1 masks and
+    // signs go through copysign, so there are no branches or selects and
+    // the loop vectorises without relaxed floating-point flags.
+    for (int i = 0; i < num; ++i)
+    {
+        const float ax = std::abs(x[i]);
+        const float ay = std::abs(y[i]);
+        const auto steep = static_cast<float>(ay > ax);
+        const float larger = ax + steep * (ay - ax);
+        const float smaller = ay - steep * (ay - ax);
+        const float a = smaller / (larger + 1.0e-30f);
+        const float s = a * a;
+
+        float p = ((((( -0.01172120f * s + 0.05265332f) * s - 0.11643287f) * s
+                       + 0.19354346f) * s - 0.33262347f) * s + 0.99997726f) * a;
+
+        p += steep * (halfPi - 2.0f * p);
+
+        const auto behind = static_cast<float>(x[i] < 0.0f);
+        p += behind * (pi - 2.0f * p);
+
+        result[i] = std::copysign(p, y[i]);
+    }
+}
+
+void PolarHistogram::process (const float* left, const float* right, int numSamples, double sampleRate) noexcept
+{
+    if (numSamples <= 0 || sampleRate <= 0.0)
+        return;
+
+    const double samplesPerTimeConstant = sampleRate * decaySeconds;
+    const auto decay = static_cast<float>(std::exp(-numSamples / samplesPerTimeConstant));
+    juce::FloatVectorOperations::multiply(bins.data(), decay, static_cast<int>(bins.size()));
+
+    const auto weight = static_cast<float>(1.0 / samplesPerTimeConstant);
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+        processChunk(left + start, right + start, juce::jmin(chunkSize, numSamples - start), weight);
+}
+
+void PolarHistogram::processChunk (const float* left, const float* right, int num, float weight) noexcept
+{
+    for (int i = 0; i < num; ++i)
+    {
+        // A pair and its negation share a position, so fold onto positive mid
+        const float sign = std::copysign(1.0f, left[i] + right[i]);
+        mid[i] = sign * (left[i] + right[i]);
+        side[i] = sign * (right[i] - left[i]);
+        radius[i] = std::sqrt(std::sqrt(0.5f * (left[i] * left[i] + right[i] * right[i])));
+    }
+
+    fastAtan2(side, mid, angle, num);
+
+    constexpr float binsPerRadian = numAngleBins / juce::MathConstants<float>::pi;
+
+    for (int i = 0; i < num; ++i)
+    {
+        const int magnitudeBin = juce::jmin(numMagnitudeBins - 1, static_cast<int>(radius[i] * numMagnitudeBins));
+
+        // The innermost bin is below about -55 dBFS: too quiet to have a position
+        if (magnitudeBin == 0)
+            continue;
+
+        const int angleBin = juce::jlimit(0, numAngleBins - 1, static_cast<int>((angle[i] + juce::MathConstants<float>::halfPi) * binsPerRadian));
+        bins[static_cast<size_t>(angleBin * numMagnitudeBins + magnitudeBin)] += weight;
+    }
+}
+
+void PolarHistogram::fillFrame (Frame& frame) const noexcept
+{
+    frame.bins = bins;
+
+    std::array<float, numAngleBins> angleTotals {};
+
+    for (int angleBin = 0; angleBin < numAngleBins; ++angleBin)
+        for (int magnitudeBin = 0; magnitudeBin < numMagnitudeBins; ++magnitudeBin)
+            angleTotals[static_cast<size_t>(angleBin)] += frame.get(angleBin, magnitudeBin);
+
+    float total = 0.0f, weightedAngle = 0.0f;
+
+    for (int angleBin = 0; angleBin < numAngleBins; ++angleBin)
+    {
+        total += angleTotals[static_cast<size_t>(angleBin)];
+        weightedAngle += angleTotals[static_cast<size_t>(angleBin)] * getAngleBinCentre(angleBin);
+    }
+
+    frame.total = total;
+
+    if (total <= 0.0f)
+    {
+        frame.dominantAngle = frame.meanAngle = frame.spread = 0.0f;
+        return;
+    }
+
+    frame.meanAngle = weightedAngle / total;
+
+    float variance = 0.0f;
+
+    for (int angleBin = 0; angleBin < numAngleBins; ++angleBin)
+    {
+        const float offset = getAngleBinCentre(angleBin) - frame.meanAngle;
+        variance += angleTotals[static_cast<size_t>(angleBin)] * offset * offset;
+    }
+
+    frame.spread = std::sqrt(variance / total);
+
+    // Peak bin, refined between its neighbours with a parabola
+    const auto peak = static_cast<int>(std::max_element(angleTotals.begin(), angleTotals.end()) - angleTotals.begin());
+    float offset = 0.0f;
+
+    if (peak > 0 && peak < numAngleBins - 1)
+    {
+        const float before = angleTotals[static_cast<size_t>(peak - 1)];
+        const float at = angleTotals[static_cast<size_t>(peak)];
+        const float after = angleTotals[static_cast<size_t>(peak + 1)];
+        const float curvature = before - 2.0f * at + after;
+
+        if (curvature < 0.0f)
+            offset = juce::jlimit(-0.5f, 0.5f, 0.5f * (before - after) / curvature);
+    }
+
+    frame.dominantAngle = getAngleBinCentre(peak) + offset * (2.0f * maximumAngle / numAngleBins);
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    PolarHistogram.h
+    Created: 20 Oct 2026 6:02:44pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+/*
+    Decaying histogram of stereo sample pairs by angle and magnitude, behind
+    the visualizer's polar display.
+
+    A sample's angle is its position in the stereo field: 0 for mono, -45 and
+    +45 degrees for hard left and right, +-90 for fully out of phase. A pair
+    and its negation sit at the same position, so the angle is folded into
+    -90..+90. Magnitude is on a square-root scale so quiet material still
+    reaches the outer bins.
+
+    Each sample adds 1 / (sampleRate * decaySeconds) and everything decays
+    with time constant decaySeconds, so a steady signal totals 1 at any
+    sample rate. Angles come from a branch-free polynomial atan2 run over
+    fixed-size chunks the compiler vectorises.
+*/
+class PolarHistogram
+{
+public:
+    static constexpr int numAngleBins = 90;         // 2 degrees each
+    static constexpr int numMagnitudeBins = 24;
+    static constexpr float maximumAngle = 90.0f;    // degrees either side of centre
+
+    struct Frame
+    {
+        std::array<float, numAngleBins * numMagnitudeBins> bins {};
+
+        // Degrees, negative to the left. spread is the weighted standard
+        // deviation of the angle, 0 for a mono signal.
+        float dominantAngle = 0.0f;
+        float meanAngle = 0.0f;
+        float spread = 0.0f;
+        float total = 0.0f;
+
+        float get (int angleBin, int magnitudeBin) const noexcept { return bins[static_cast<size_t>(angleBin * numMagnitudeBins + magnitudeBin)]; }
+    };
+
+    explicit PolarHistogram (double decaySeconds = 0.3);
+    ~PolarHistogram();
+
+    void reset();
+
+    void process (const float* left, const float* right, int numSamples, double sampleRate) noexcept;
+
+    // Copies the bins and fills in the readouts
+    void fillFrame (Frame& frame) const noexcept;
+
+    static float getAngleBinCentre (int angleBin) noexcept;
+
+    // atan2 of each pair to within about 1e-5 radians
+    static void fastAtan2 (const float* y, const float* x, float* result, int num) noexcept;
+
+private:
+    static constexpr int chunkSize = 64;
+
+    void processChunk (const float* left, const float* right, int num, float weight) noexcept;
+
+    const double decaySeconds;
+    std::array<float, numAngleBins * numMagnitudeBins> bins {};
+
+    alignas (32) float side[chunkSize], mid[chunkSize], angle[chunkSize], radius[chunkSize];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolarHistogram)
+};
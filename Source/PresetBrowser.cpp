@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    PresetBrowser.cpp
+    Created: 20 Oct 2026 9:12:40am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "PresetBrowser.h"
+
+//==============================================================================
+PresetBrowser::PresetBrowser (ImaginationAudioProcessor& p)
+    : processor(p), library(p.getPresetLibrary()), presets(library.getIndex())
+{
+    addAndMakeVisible(searchBox);
+    searchBox.setTextToShowWhenEmpty("Search presets, #tag", juce::Colours::grey);
+    searchBox.onTextChange = [this] { showingSimilar = false; updateResults(); };
+    searchBox.onReturnKey = [this] { applyRow(0); };
+
+    addAndMakeVisible(resultList);
+    resultList.setModel(this);
+    resultList.setRowHeight(22);
+    resultList.setColour(juce::ListBox::backgroundColourId, juce::Colours::black);
+
+    addAndMakeVisible(similarButton);
+    similarButton.onClick = [this] { showSimilar(); };
+
+    addAndMakeVisible(saveButton);
+    saveButton.onClick = [this] { saveCurrentSettings(); };
+
+    library.addChangeListener(this);
+
+    // Show the index as it is now and let the library pick up anything new
+    // in the background; the list refreshes if the rescan changes it
+    updateResults();
+    library.refresh();
+
+    setSize(320, 400);
+}
+
+PresetBrowser::~PresetBrowser()
+{
+    library.removeChangeListener(this);
+    resultList.setModel(nullptr);
+}
+
+void PresetBrowser::paint (juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.brighter(0.1f));
+}
+
+void PresetBrowser::resized()
+{
+    auto area = getLocalBounds().reduced(8);
+
+    auto buttons = area.removeFromBottom(24);
+    similarButton.setBounds(buttons.removeFromLeft(buttons.getWidth() / 2).reduced(2, 0));
+    saveButton.setBounds(buttons.reduced(2, 0));
+    area.removeFromBottom(6);
+
+    searchBox.setBounds(area.removeFromTop(24));
+    area.removeFromTop(6);
+    resultList.setBounds(area);
+}
+
+//==============================================================================
+int PresetBrowser::getNumRows()
+{
+    return static_cast<int>(results.size());
+}
+
+void PresetBrowser::paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    if (! juce::isPositiveAndBelow(rowNumber, static_cast<int>(results.size())))
+        return;
+
+    const int entry = results[static_cast<size_t>(rowNumber)];
+
+    if (rowIsSelected)
+        g.fillAll(juce::Colour(254, 93, 159).withAlpha(0.4f));
+
+    auto area = juce::Rectangle<int>(width, height).reduced(6, 0);
+
+    g.setColour(presets->getFile(entry) == processor.getCurrentPresetFile() ? juce::Colour(246, 134, 189) : juce::Colours::white);
+    g.drawText(presets->getName(entry), area.removeFromLeft(width / 2), juce::Justification::centredLeft, true);
+
+    g.setColour(juce::Colours::grey);
+    g.drawText(presets->getTags(entry), area, juce::Justification::centredRight, true);
+}
+
+void PresetBrowser::listBoxItemDoubleClicked (int row, const juce::MouseEvent&)
+{
+    applyRow(row);
+}
+
+void PresetBrowser::returnKeyPressed (int lastRowSelected)
+{
+    applyRow(lastRowSelected);
+}
+
+void PresetBrowser::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    presets = library.getIndex();
+
+    if (showingSimilar)
+        showSimilar();
+    else
+        updateResults();
+}
+
+//==============================================================================
+void PresetBrowser::updateResults()
+{
+    results = library.search(*presets, searchBox.getText(), maxResults);
+    resultList.updateContent();
+    resultList.repaint();
+}
+
+void PresetBrowser::showSimilar()
+{
+    showingSimilar = true;
+    results = library.findSimilar(*presets, library.makeFingerprint(processor.apvts.copyState()), maxSimilarResults);
+    resultList.updateContent();
+    resultList.repaint();
+}
+
+void PresetBrowser::applyRow (int row)
+{
+    if (! juce::isPositiveAndBelow(row, static_cast<int>(results.size())))
+        return;
+
+    // By file rather than program number: the library may have swapped in
+    // a new index since this browser took its snapshot
+    processor.applyPreset(presets->getFile(results[static_cast<size_t>(row)]));
+    processor.updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+    resultList.repaint();
+}
+
+void PresetBrowser::saveCurrentSettings()
+{
+    auto* window = new juce::AlertWindow("Save Preset", {}, juce::MessageBoxIconType::NoIcon, this);
+    window->addTextEditor("name", {}, "Name");
+    window->addTextEditor("tags", {}, "Tags (comma separated)");
+    window->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    window->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<PresetBrowser> safeThis(this);
+
+    window->enterModalState(true, juce::ModalCallbackFunction::create([safeThis, window](int result)
+    {
+        if (result == 1 && safeThis != nullptr)
+            safeThis->library.savePreset(window->getTextEditorContents("name"),
+                                         window->getTextEditorContents("tags"),
+                                         safeThis->processor.apvts.copyState());
+    }), true);
+}
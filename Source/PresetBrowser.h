@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    PresetBrowser.h
+    Created: 20 Oct 2026 9:12:40am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "PluginProcessor.h"
+#include "PresetLibrary.h"
+
+//==============================================================================
+/*
+    Search box and result list over the shared PresetLibrary, shown in a
+    call-out from the editor.
+
+    Everything it displays comes straight from the mapped index, so opening
+    it and typing cost the same however many presets there are. Typing
+    filters by name prefix and "#tag" terms; SIMILAR lists the presets
+    nearest to the current settings. Double-click or return applies a preset
+    through the processor's program API.
+*/
+class PresetBrowser  : public juce::Component,
+                       private juce::ListBoxModel,
+                       private juce::ChangeListener
+{
+public:
+    explicit PresetBrowser (ImaginationAudioProcessor&);
+    ~PresetBrowser() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    int getNumRows() override;
+    void paintListBoxItem (int rowNumber, juce::Graphics&, int width, int height, bool rowIsSelected) override;
+    void listBoxItemDoubleClicked (int row, const juce::MouseEvent&) override;
+    void returnKeyPressed (int lastRowSelected) override;
+
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
+    void updateResults();
+    void showSimilar();
+    void applyRow (int row);
+    void saveCurrentSettings();
+
+    static constexpr int maxResults = 5000;
+    static constexpr int maxSimilarResults = 50;
+
+    ImaginationAudioProcessor& processor;
+    PresetLibrary& library;
+
+    std::shared_ptr<const PresetIndex> presets;
+    std::vector<int> results;
+    bool showingSimilar = false;
+
+    juce::TextEditor searchBox;
+    juce::ListBox resultList;
+    juce::TextButton similarButton { "SIMILAR" };
+    juce::TextButton saveButton { "SAVE" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBrowser)
+};
@@ -0,0 +1,621 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+    Created: 20 Oct 2026 9:12:40am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//==============================================================================
+// On-disk layout, native endianness (the index is a cache, never shared
+// between machines):
+//
+//   Header | Entry[numEntries] | float[numEntries * numFingerprintValues] | strings
+//
+// Every string in the table is NUL-terminated; tags are stored lower-cased
+// as ",tag,tag," so tag lookups are plain substring searches.
+struct PresetIndex::Header
+{
+    juce::uint32 magic;
+    juce::uint32 version;
+    juce::uint32 numEntries;
+    juce::uint32 numFingerprintValues;
+    juce::uint64 fingerprintsOffset;
+    juce::uint64 stringsOffset;
+    juce::uint64 stringsSize;
+};
+
+struct PresetIndex::Entry
+{
+    juce::int64 modificationTime;
+    juce::uint32 nameOffset, nameLength;
+    juce::uint32 sortKeyOffset, sortKeyLength;
+    juce::uint32 tagsOffset, tagsLength;
+    juce::uint32 pathOffset, pathLength;
+    juce::uint32 flags;
+    juce::uint32 reserved;
+};
+
+namespace
+{
+    constexpr juce::uint32 indexMagic = 0x58474d49; // "IMGX"
+    constexpr juce::uint32 indexVersion = 1;
+    constexpr juce::uint32 factoryFlag = 1;
+
+    std::string toSortKey (const juce::String& name)
+    {
+        return name.toLowerCase().toStdString();
+    }
+
+    // "Wide, Vocal ,pad" -> ",wide,vocal,pad,"
+    juce::String normaliseTags (const juce::String& tags)
+    {
+        juce::StringArray list;
+        list.addTokens(tags.toLowerCase(), ",", {});
+        list.trim();
+        list.removeEmptyStrings();
+        list.removeDuplicates(false);
+
+        return list.isEmpty() ? juce::String() : "," + list.joinIntoString(",") + ",";
+    }
+}
+
+//==============================================================================
+std::unique_ptr<PresetIndex> PresetIndex::open (const juce::File& file, int expectedFingerprintSize)
+{
+    if (! file.existsAsFile())
+        return {};
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly, false);
+    const auto* data = static_cast<const char*>(mapped->getData());
+    const auto size = static_cast<juce::uint64>(mapped->getSize());
+
+    if (data == nullptr || size < sizeof(Header))
+        return {};
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    const auto entriesEnd = sizeof(Header) + static_cast<juce::uint64>(header.numEntries) * sizeof(Entry);
+    const auto fingerprintsSize = static_cast<juce::uint64>(header.numEntries) * header.numFingerprintValues * sizeof(float);
+
+    if (header.magic != indexMagic
+         || header.version != indexVersion
+         || header.numFingerprintValues != static_cast<juce::uint32>(expectedFingerprintSize)
+         || header.numEntries > static_cast<juce::uint32>(std::numeric_limits<int>::max())
+         || header.fingerprintsOffset < entriesEnd
+         || header.fingerprintsOffset % alignof(float) != 0
+         || header.stringsOffset < header.fingerprintsOffset + fingerprintsSize
+         || header.stringsOffset + header.stringsSize > size)
+        return {};
+
+    std::unique_ptr<PresetIndex> index(new PresetIndex());
+    index->entries = reinterpret_cast<const Entry*>(data + sizeof(Header));
+    index->fingerprints = reinterpret_cast<const float*>(data + header.fingerprintsOffset);
+    index->strings = data + header.stringsOffset;
+    index->numEntries = static_cast<int>(header.numEntries);
+    index->numFingerprintValues = expectedFingerprintSize;
+
+    // One pass over the records so nothing later can read past the mapping
+    auto isValidString = [&header, &index](juce::uint32 offset, juce::uint32 length)
+    {
+        return static_cast<juce::uint64>(offset) + length < header.stringsSize && index->strings[offset + length] == 0;
+    };
+
+    for (int i = 0; i < index->numEntries; ++i)
+    {
+        const auto& e = index->entries[i];
+
+        if (! (isValidString(e.nameOffset, e.nameLength) && isValidString(e.sortKeyOffset, e.sortKeyLength)
+                && isValidString(e.tagsOffset, e.tagsLength) && isValidString(e.pathOffset, e.pathLength)))
+            return {};
+    }
+
+    index->mappedFile = std::move(mapped);
+    return index;
+}
+
+std::unique_ptr<PresetIndex> PresetIndex::createEmpty()
+{
+    return std::unique_ptr<PresetIndex>(new PresetIndex());
+}
+
+PresetIndex::~PresetIndex()
+{
+}
+
+juce::String PresetIndex::getName (int entry) const
+{
+    const auto& e = entries[entry];
+    return juce::String::fromUTF8(getString(e.nameOffset), static_cast<int>(e.nameLength));
+}
+
+juce::String PresetIndex::getTags (int entry) const
+{
+    const auto& e = entries[entry];
+    auto tags = juce::String::fromUTF8(getString(e.tagsOffset), static_cast<int>(e.tagsLength));
+    return tags.trimCharactersAtStart(",").trimCharactersAtEnd(",").replace(",", ", ");
+}
+
+juce::File PresetIndex::getFile (int entry) const
+{
+    const auto& e = entries[entry];
+    return juce::File(juce::String::fromUTF8(getString(e.pathOffset), static_cast<int>(e.pathLength)));
+}
+
+int PresetIndex::indexOf (const juce::File& presetFile) const
+{
+    // Compares the stored UTF-8 paths in place; only runs on a rescan or a program change
+    const auto path = presetFile.getFullPathName();
+    const auto* utf8 = path.toRawUTF8();
+    const auto length = std::strlen(utf8);
+
+    for (int i = 0; i < numEntries; ++i)
+        if (entries[i].pathLength == length && std::memcmp(getString(entries[i].pathOffset), utf8, length) == 0)
+            return i;
+
+    return -1;
+}
+
+juce::int64 PresetIndex::getModificationTime (int entry) const noexcept
+{
+    return entries[entry].modificationTime;
+}
+
+bool PresetIndex::isFactory (int entry) const noexcept
+{
+    return (entries[entry].flags & factoryFlag) != 0;
+}
+
+const float* PresetIndex::getFingerprint (int entry) const noexcept
+{
+    return fingerprints + static_cast<size_t>(entry) * static_cast<size_t>(numFingerprintValues);
+}
+
+juce::Range<int> PresetIndex::findPrefix (const juce::String& lowerCasePrefix) const
+{
+    const auto prefix = lowerCasePrefix.toStdString();
+    const std::string_view p(prefix);
+
+    auto keyOf = [this](const Entry& e) { return std::string_view(getString(e.sortKeyOffset), e.sortKeyLength); };
+
+    const auto* first = std::lower_bound(entries, entries + numEntries, p,
+                                         [&keyOf](const Entry& e, std::string_view value) { return keyOf(e) < value; });
+    const auto* last = std::upper_bound(first, entries + numEntries, p,
+                                        [&keyOf](std::string_view value, const Entry& e) { return value < keyOf(e).substr(0, value.size()); });
+
+    return { static_cast<int>(first - entries), static_cast<int>(last - entries) };
+}
+
+bool PresetIndex::hasTagStartingWith (int entry, const juce::String& lowerCaseTag) const
+{
+    const auto& e = entries[entry];
+    const std::string_view tags(getString(e.tagsOffset), e.tagsLength);
+    const auto needle = "," + lowerCaseTag.toStdString();
+
+    return tags.find(needle) != std::string_view::npos;
+}
+
+bool PresetIndex::write (const juce::File& file, const std::vector<Record>& records, int numFingerprintValues)
+{
+    std::vector<std::pair<std::string, size_t>> order;
+    order.reserve(records.size());
+
+    for (size_t i = 0; i < records.size(); ++i)
+        order.emplace_back(toSortKey(records[i].name), i);
+
+    std::sort(order.begin(), order.end());
+
+    std::string stringTable;
+    auto addString = [&stringTable](const std::string& text, juce::uint32& offset, juce::uint32& length)
+    {
+        offset = static_cast<juce::uint32>(stringTable.size());
+        length = static_cast<juce::uint32>(text.size());
+        stringTable.append(text);
+        stringTable.push_back('\0');
+    };
+
+    std::vector<Entry> entryTable(records.size());
+    std::vector<float> fingerprintTable(records.size() * static_cast<size_t>(numFingerprintValues), 0.0f);
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const auto& record = records[order[i].second];
+        auto& e = entryTable[i];
+
+        e = {};
+        e.modificationTime = record.modificationTime;
+        e.flags = record.factory ? factoryFlag : 0;
+        addString(record.name.toStdString(), e.nameOffset, e.nameLength);
+        addString(order[i].first, e.sortKeyOffset, e.sortKeyLength);
+        addString(record.tags.toStdString(), e.tagsOffset, e.tagsLength);
+        addString(record.file.getFullPathName().toStdString(), e.pathOffset, e.pathLength);
+
+        std::copy_n(record.fingerprint.begin(), juce::jmin(record.fingerprint.size(), static_cast<size_t>(numFingerprintValues)),
+                    fingerprintTable.begin() + static_cast<std::ptrdiff_t>(i * static_cast<size_t>(numFingerprintValues)));
+    }
+
+    Header header {};
+    header.magic = indexMagic;
+    header.version = indexVersion;
+    header.numEntries = static_cast<juce::uint32>(records.size());
+    header.numFingerprintValues = static_cast<juce::uint32>(numFingerprintValues);
+    header.fingerprintsOffset = sizeof(Header) + entryTable.size() * sizeof(Entry);
+    header.stringsOffset = header.fingerprintsOffset + fingerprintTable.size() * sizeof(float);
+    header.stringsSize = stringTable.size();
+
+    // Written next to the old index and swapped in with a rename, so other
+    // processes still mapping the old file keep a consistent view
+    juce::TemporaryFile temp(file);
+
+    {
+        juce::FileOutputStream out(temp.getFile());
+
+        if (! out.openedOk())
+            return false;
+
+        out.write(&header, sizeof(Header));
+        out.write(entryTable.data(), entryTable.size() * sizeof(Entry));
+        out.write(fingerprintTable.data(), fingerprintTable.size() * sizeof(float));
+        out.write(stringTable.data(), stringTable.size());
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+PresetLibrary::PresetLibrary()
+    : juce::Thread("Imagination preset indexer"),
+      index(PresetIndex::createEmpty())
+{
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    stopThread(5000);
+}
+
+void PresetLibrary::setFingerprintParameters (const std::vector<FingerprintParameter>& parameters)
+{
+    {
+        const juce::ScopedLock sl(parameterLock);
+
+        if (! fingerprintParameters.empty())
+        {
+            jassert(fingerprintParameters.size() == parameters.size());
+            return;
+        }
+
+        fingerprintParameters = parameters;
+    }
+
+    // Whatever index is already on disk is usable straight away; the scan
+    // only replaces it if the folders have changed since it was written
+    if (auto existing = PresetIndex::open(getIndexFile(), static_cast<int>(parameters.size())))
+    {
+        const juce::ScopedLock sl(indexLock);
+        index = std::move(existing);
+    }
+
+    startThread();
+}
+
+std::shared_ptr<const PresetIndex> PresetLibrary::getIndex() const
+{
+    const juce::ScopedLock sl(indexLock);
+    return index;
+}
+
+void PresetLibrary::refresh()
+{
+    notify();
+}
+
+juce::File PresetLibrary::getUserDirectory() const
+{
+   #if JUCE_MAC
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Audio/Presets/Imagination");
+   #else
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Imagination/Presets");
+   #endif
+}
+
+juce::File PresetLibrary::getFactoryDirectory() const
+{
+   #if JUCE_MAC
+    return juce::File::getSpecialLocation(juce::File::commonApplicationDataDirectory).getChildFile("Audio/Presets/Imagination");
+   #else
+    return juce::File::getSpecialLocation(juce::File::commonApplicationDataDirectory).getChildFile("Imagination/Factory Presets");
+   #endif
+}
+
+juce::File PresetLibrary::getIndexFile() const
+{
+   #if JUCE_MAC
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Application Support/Imagination/PresetIndex.bin");
+   #else
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("Imagination/PresetIndex.bin");
+   #endif
+}
+
+//==============================================================================
+std::vector<int> PresetLibrary::search (const PresetIndex& presets, const juce::String& query, int maxResults) const
+{
+    juce::StringArray nameTerms, tagTerms;
+
+    for (const auto& token : juce::StringArray::fromTokens(query.toLowerCase(), true))
+    {
+        if (token.startsWithChar('#'))
+        {
+            if (token.length() > 1)
+                tagTerms.add(token.substring(1));
+        }
+        else
+        {
+            nameTerms.add(token);
+        }
+    }
+
+    const auto namePrefix = nameTerms.joinIntoString(" ");
+    const auto range = namePrefix.isEmpty() ? juce::Range<int>(0, presets.size()) : presets.findPrefix(namePrefix);
+
+    std::vector<int> results;
+
+    for (int entry = range.getStart(); entry < range.getEnd() && static_cast<int>(results.size()) < maxResults; ++entry)
+    {
+        const bool matchesTags = std::all_of(tagTerms.begin(), tagTerms.end(),
+                                             [&presets, entry](const juce::String& tag) { return presets.hasTagStartingWith(entry, tag); });
+
+        if (matchesTags)
+            results.push_back(entry);
+    }
+
+    return results;
+}
+
+std::vector<int> PresetLibrary::findSimilar (const PresetIndex& presets, const std::vector<float>& fingerprint, int maxResults) const
+{
+    const int numValues = presets.getNumFingerprintValues();
+
+    if (static_cast<int>(fingerprint.size()) != numValues || maxResults <= 0)
+        return {};
+
+    std::vector<std::pair<float, int>> distances;
+    distances.reserve(static_cast<size_t>(presets.size()));
+
+    for (int entry = 0; entry < presets.size(); ++entry)
+    {
+        const float* values = presets.getFingerprint(entry);
+        float distance = 0.0f;
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            const float difference = values[i] - fingerprint[static_cast<size_t>(i)];
+            distance += difference * difference;
+        }
+
+        distances.emplace_back(distance, entry);
+    }
+
+    const auto numResults = static_cast<size_t>(juce::jmin(maxResults, presets.size()));
+    std::partial_sort(distances.begin(), distances.begin() + static_cast<std::ptrdiff_t>(numResults), distances.end());
+
+    std::vector<int> results;
+    results.reserve(numResults);
+
+    for (size_t i = 0; i < numResults; ++i)
+        results.push_back(distances[i].second);
+
+    return results;
+}
+
+std::vector<float> PresetLibrary::makeFingerprint (const juce::ValueTree& state) const
+{
+    if (auto xml = state.createXml())
+        return makeFingerprint(*xml);
+
+    return makeFingerprint(juce::XmlElement("Parameters"));
+}
+
+std::vector<float> PresetLibrary::makeFingerprint (const juce::XmlElement& parameters) const
+{
+    const juce::ScopedLock sl(parameterLock);
+
+    std::vector<float> fingerprint;
+    fingerprint.reserve(fingerprintParameters.size());
+
+    for (const auto& parameter : fingerprintParameters)
+        fingerprint.push_back(parameter.defaultValue);
+
+    for (auto* child : parameters.getChildIterator())
+    {
+        const auto id = child->getStringAttribute("id");
+
+        for (size_t i = 0; i < fingerprintParameters.size(); ++i)
+        {
+            const auto& parameter = fingerprintParameters[i];
+
+            if (parameter.parameterID == id)
+            {
+                const auto value = static_cast<float>(child->getDoubleAttribute("value"));
+                fingerprint[i] = parameter.range.convertTo0to1(parameter.range.snapToLegalValue(value));
+                break;
+            }
+        }
+    }
+
+    return fingerprint;
+}
+
+juce::ValueTree PresetLibrary::loadState (const PresetIndex& presets, int entry) const
+{
+    if (! juce::isPositiveAndBelow(entry, presets.size()))
+        return {};
+
+    return loadState(presets.getFile(entry));
+}
+
+juce::ValueTree PresetLibrary::loadState (const juce::File& presetFile) const
+{
+    auto xml = juce::parseXMLIfTagMatches(presetFile, "ImaginationPreset");
+
+    if (xml == nullptr)
+        return {};
+
+    if (auto* parameters = xml->getFirstChildElement())
+        return juce::ValueTree::fromXml(*parameters);
+
+    return {};
+}
+
+bool PresetLibrary::savePreset (const juce::String& name, const juce::String& tags, const juce::ValueTree& state)
+{
+    auto file = getUserDirectory().getChildFile(juce::File::createLegalFileName(name.trim()) + fileExtension);
+
+    if (name.trim().isEmpty() || ! file.getParentDirectory().createDirectory())
+        return false;
+
+    auto parameters = state.createXml();
+
+    if (parameters == nullptr)
+        return false;
+
+    juce::XmlElement preset("ImaginationPreset");
+    preset.setAttribute("name", name.trim());
+    preset.setAttribute("tags", tags);
+    preset.addChildElement(parameters.release());
+
+    if (! preset.writeTo(file))
+        return false;
+
+    refresh();
+    return true;
+}
+
+bool PresetLibrary::readPreset (const juce::File& file, PresetIndex::Record& record) const
+{
+    auto xml = juce::parseXMLIfTagMatches(file, "ImaginationPreset");
+
+    if (xml == nullptr)
+        return false;
+
+    record.name = xml->getStringAttribute("name", file.getFileNameWithoutExtension());
+    record.tags = normaliseTags(xml->getStringAttribute("tags"));
+
+    if (auto* parameters = xml->getFirstChildElement())
+        record.fingerprint = makeFingerprint(*parameters);
+    else
+        record.fingerprint = makeFingerprint(juce::XmlElement("Parameters"));
+
+    return true;
+}
+
+//==============================================================================
+void PresetLibrary::run()
+{
+    while (! threadShouldExit())
+    {
+        rebuildIndex();
+
+        // Rescans happen on request (opening the browser, saving a preset)
+        wait(-1);
+    }
+}
+
+void PresetLibrary::rebuildIndex()
+{
+    int numFingerprintValues = 0;
+    {
+        const juce::ScopedLock sl(parameterLock);
+        numFingerprintValues = static_cast<int>(fingerprintParameters.size());
+    }
+
+    const auto current = getIndex();
+
+    std::unordered_map<std::string, int> currentEntries;
+    currentEntries.reserve(static_cast<size_t>(current->size()));
+
+    for (int entry = 0; entry < current->size(); ++entry)
+        currentEntries.emplace(current->getFile(entry).getFullPathName().toStdString(), entry);
+
+    std::vector<PresetIndex::Record> records;
+    bool changed = false;
+
+    const std::pair<juce::File, bool> folders[] = { { getUserDirectory(), false }, { getFactoryDirectory(), true } };
+
+    for (const auto& [folder, isFactoryFolder] : folders)
+    {
+        if (! folder.isDirectory())
+            continue;
+
+        for (const auto& item : juce::RangedDirectoryIterator(folder, true, juce::String("*") + fileExtension, juce::File::findFiles))
+        {
+            if (threadShouldExit())
+                return;
+
+            PresetIndex::Record record;
+            record.file = item.getFile();
+            record.modificationTime = item.getModificationTime().toMilliseconds();
+            record.factory = isFactoryFolder;
+
+            // Unchanged presets are carried over from the current index
+            // without touching their files
+            const auto found = currentEntries.find(record.file.getFullPathName().toStdString());
+
+            if (found != currentEntries.end()
+                 && current->getModificationTime(found->second) == record.modificationTime
+                 && current->isFactory(found->second) == record.factory)
+            {
+                const auto entry = found->second;
+                const float* fingerprint = current->getFingerprint(entry);
+
+                record.name = current->getName(entry);
+                record.tags = normaliseTags(current->getTags(entry));
+                record.fingerprint.assign(fingerprint, fingerprint + numFingerprintValues);
+            }
+            else if (readPreset(record.file, record))
+            {
+                changed = true;
+            }
+            else
+            {
+                continue;
+            }
+
+            records.push_back(std::move(record));
+        }
+    }
+
+    if (! changed && static_cast<int>(records.size()) == current->size())
+        return;
+
+    const auto indexFile = getIndexFile();
+
+    if (! indexFile.getParentDirectory().createDirectory()
+         || ! PresetIndex::write(indexFile, records, numFingerprintValues))
+        return;
+
+    if (auto rebuilt = PresetIndex::open(indexFile, numFingerprintValues))
+    {
+        {
+            const juce::ScopedLock sl(indexLock);
+            index = std::move(rebuilt);
+        }
+
+        sendChangeMessage();
+    }
+}
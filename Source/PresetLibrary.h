@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 20 Oct 2026 9:12:40am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/*
+    Read-only view of the on-disk preset index, memory-mapped so opening it
+    costs the same for ten presets as for ten thousand.
+
+    The file holds a fixed-size record per preset (sorted by lower-cased
+    name), a block of normalised parameter fingerprints and a UTF-8 string
+    table with names, tags and paths. Nothing is copied out until asked for.
+*/
+class PresetIndex
+{
+public:
+    // Returns nullptr if the file is missing, truncated or was written for a
+    // different parameter set, in which case the library rebuilds it
+    static std::unique_ptr<PresetIndex> open (const juce::File& file, int expectedFingerprintSize);
+    static std::unique_ptr<PresetIndex> createEmpty();
+
+    ~PresetIndex();
+
+    int size() const noexcept                     { return numEntries; }
+    int getNumFingerprintValues() const noexcept  { return numFingerprintValues; }
+
+    juce::String getName (int entry) const;
+    juce::String getTags (int entry) const;
+    juce::File getFile (int entry) const;
+    juce::int64 getModificationTime (int entry) const noexcept;
+    bool isFactory (int entry) const noexcept;
+    const float* getFingerprint (int entry) const noexcept;
+
+    // The entry for a preset file, or -1 if this index does not have it
+    int indexOf (const juce::File& presetFile) const;
+
+    // The entries whose lower-cased name starts with the given lower-cased prefix
+    juce::Range<int> findPrefix (const juce::String& lowerCasePrefix) const;
+
+    // True if one of the entry's tags starts with the given lower-cased text
+    bool hasTagStartingWith (int entry, const juce::String& lowerCaseTag) const;
+
+    //==============================================================================
+    struct Record
+    {
+        juce::String name, tags;
+        juce::File file;
+        juce::int64 modificationTime = 0;
+        bool factory = false;
+        std::vector<float> fingerprint;
+    };
+
+    // Writes the records, sorted by name, as a new index and atomically replaces the old file
+    static bool write (const juce::File& file, const std::vector<Record>& records, int numFingerprintValues);
+
+private:
+    struct Header;
+    struct Entry;
+
+    PresetIndex() = default;
+
+    const char* getString (juce::uint32 offset) const noexcept { return strings + offset; }
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    const Entry* entries = nullptr;
+    const float* fingerprints = nullptr;
+    const char* strings = nullptr;
+    int numEntries = 0;
+    int numFingerprintValues = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetIndex)
+};
+
+//==============================================================================
+/*
+    The user and factory preset folders, shared by every instance in the
+    process through juce::SharedResourcePointer<PresetLibrary>.
+
+    Lookups always go to the current mapped index, so the browser and the
+    host's program list are available immediately. A background thread
+    rescans the folders, re-reads only presets that are new or changed, and
+    swaps in a fresh index when anything differs; listeners are told through
+    the ChangeBroadcaster. Preset files themselves are only read when a
+    preset is actually applied.
+*/
+class PresetLibrary  : public juce::ChangeBroadcaster,
+                       private juce::Thread
+{
+public:
+    PresetLibrary();
+    ~PresetLibrary() override;
+
+    static constexpr const char* fileExtension = ".imgpreset";
+
+    struct FingerprintParameter
+    {
+        juce::String parameterID;
+        juce::NormalisableRange<float> range;
+        float defaultValue = 0.0f;   // normalised, used when a preset leaves it out
+    };
+
+    // The parameters that make up a fingerprint, in order. Every instance
+    // passes the same list; the first call starts the initial scan.
+    void setFingerprintParameters (const std::vector<FingerprintParameter>& parameters);
+
+    // Snapshot of the current index; never null, possibly empty. Any thread.
+    std::shared_ptr<const PresetIndex> getIndex() const;
+
+    // Asks the background thread to rescan the folders
+    void refresh();
+
+    juce::File getUserDirectory() const;
+    juce::File getFactoryDirectory() const;
+
+    //==============================================================================
+    // A name prefix plus any number of "#tag" terms, e.g. "pad #wide #vocal".
+    // Results come back in name order.
+    std::vector<int> search (const PresetIndex& index, const juce::String& query, int maxResults) const;
+
+    // The entries nearest to the fingerprint by Euclidean distance, nearest first
+    std::vector<int> findSimilar (const PresetIndex& index, const std::vector<float>& fingerprint, int maxResults) const;
+
+    std::vector<float> makeFingerprint (const juce::ValueTree& state) const;
+
+    // Reads the preset's parameter state from disk; invalid if it could not be read
+    juce::ValueTree loadState (const PresetIndex& index, int entry) const;
+    juce::ValueTree loadState (const juce::File& presetFile) const;
+
+    // Writes a user preset and schedules a rescan
+    bool savePreset (const juce::String& name, const juce::String& tags, const juce::ValueTree& state);
+
+private:
+    void run() override;
+    void rebuildIndex();
+    bool readPreset (const juce::File& file, PresetIndex::Record& record) const;
+    std::vector<float> makeFingerprint (const juce::XmlElement& parameters) const;
+    juce::File getIndexFile() const;
+
+    mutable juce::CriticalSection indexLock;
+    std::shared_ptr<const PresetIndex> index;
+
+    mutable juce::CriticalSection parameterLock;
+    std::vector<FingerprintParameter> fingerprintParameters;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetLibrary)
+};
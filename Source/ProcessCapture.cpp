@@ -0,0 +1,407 @@
+/*
+  ==============================================================================
+
+    ProcessCapture.cpp
+    Created: 20 Oct 2026 3:34:52pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "ProcessCapture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    const char captureMagic[8] = { 'I', 'M', 'G', 'C', 'A', 'P', '0', '1' };
+
+    constexpr char prepareRecord = 'P';
+    constexpr char blockRecord = 'B';
+    constexpr char droppedRecord = 'D';
+
+    constexpr int prepareRecordSize = 1 + 8 + 4 + 4;
+    constexpr int blockHeaderSize = 1 + 4 + 4 + 8 + 4;
+    constexpr int changeSize = 4 + 4;
+    constexpr int droppedRecordSize = 1 + 4;
+}
+
+//==============================================================================
+// Copies a record into the ring's (up to two) free regions
+struct ProcessCapture::RingWriter
+{
+    char* ring = nullptr;
+    int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    int written = 0;
+
+    template <typename Type>
+    void put (const Type& value) noexcept { put(&value, static_cast<int>(sizeof(Type))); }
+
+    void put (const void* data, int numBytes) noexcept
+    {
+        auto* source = static_cast<const char*>(data);
+
+        if (written < size1)
+        {
+            const int n = juce::jmin(numBytes, size1 - written);
+            std::memcpy(ring + start1 + written, source, static_cast<size_t>(n));
+            written += n;
+            source += n;
+            numBytes -= n;
+        }
+
+        if (numBytes > 0)
+        {
+            std::memcpy(ring + start2 + (written - size1), source, static_cast<size_t>(numBytes));
+            written += numBytes;
+        }
+    }
+};
+
+//==============================================================================
+ProcessCapture::ProcessCapture (int ringBytes)
+    : juce::Thread("Imagination capture"), ringSize(ringBytes), fifo(ringBytes)
+{
+}
+
+ProcessCapture::~ProcessCapture()
+{
+    stop();
+}
+
+bool ProcessCapture::start (const juce::File& file, const juce::StringArray& parameterIDs,
+                            double sampleRate, int maximumBlockSize, bool nonRealtime)
+{
+    stop();
+
+    file.deleteFile();
+    auto newStream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (newStream->failedToOpen())
+        return false;
+
+    newStream->write(captureMagic, sizeof(captureMagic));
+    newStream->writeInt(parameterIDs.size());
+
+    for (const auto& id : parameterIDs)
+    {
+        const auto utf8 = id.toUTF8();
+        const auto numBytes = static_cast<int>(utf8.sizeInBytes() - 1);
+        newStream->writeInt(numBytes);
+        newStream->write(utf8.getAddress(), static_cast<size_t>(numBytes));
+    }
+
+    stream = std::move(newStream);
+
+    // The ring is only allocated the first time a capture starts
+    if (ring == nullptr)
+        ring.allocate(static_cast<size_t>(ringSize), false);
+
+    fifo.reset();
+    lastValues.assign(static_cast<size_t>(parameterIDs.size()), std::numeric_limits<float>::quiet_NaN());
+    changes.resize(lastValues.size());
+    pendingDropped = 0;
+    totalDropped.store(0);
+    startTicks = juce::Time::getHighResolutionTicks();
+
+    // The ring has a single producer. While `active` is false the audio
+    // thread leaves it alone, so this thread can write the first record;
+    // publishing `active` afterwards hands the ring (and the state above)
+    // over to the audio thread.
+    writePrepare(sampleRate, maximumBlockSize, nonRealtime);
+    active.store(true, std::memory_order_release);
+
+    startThread();
+    return true;
+}
+
+void ProcessCapture::stop()
+{
+    if (! active.exchange(false))
+        return;
+
+    // Let a block that is being recorded right now finish first
+    while (writerBusy.load())
+        juce::Thread::yield();
+
+    signalThreadShouldExit();
+    notify();
+    stopThread(5000);
+
+    if (stream != nullptr)
+        stream->flush();
+
+    stream.reset();
+}
+
+//==============================================================================
+bool ProcessCapture::beginRecord (int numBytes, RingWriter& writer) noexcept
+{
+    // A whole record or nothing, so the file never holds a partial block
+    if (fifo.getFreeSpace() < numBytes)
+        return false;
+
+    writer.ring = ring.get();
+    fifo.prepareToWrite(numBytes, writer.start1, writer.size1, writer.start2, writer.size2);
+    return true;
+}
+
+void ProcessCapture::recordPrepare (double sampleRate, int maximumBlockSize, bool nonRealtime) noexcept
+{
+    writerBusy.store(true);
+
+    if (active.load())
+        writePrepare(sampleRate, maximumBlockSize, nonRealtime);
+
+    writerBusy.store(false);
+}
+
+void ProcessCapture::writePrepare (double sampleRate, int maximumBlockSize, bool nonRealtime) noexcept
+{
+    RingWriter writer;
+
+    if (! beginRecord(prepareRecordSize, writer))
+        return;
+
+    writer.put(prepareRecord);
+    writer.put(sampleRate);
+    writer.put(static_cast<juce::int32>(maximumBlockSize));
+    writer.put(static_cast<juce::int32>(nonRealtime ? 1 : 0));
+    fifo.finishedWrite(prepareRecordSize);
+
+    // Every parameter goes into the first block after a prepare
+    std::fill(lastValues.begin(), lastValues.end(), std::numeric_limits<float>::quiet_NaN());
+}
+
+void ProcessCapture::recordBlock (const juce::AudioBuffer<float>& buffer,
+                                  const juce::Array<juce::AudioProcessorParameter*>& parameters) noexcept
+{
+    writerBusy.store(true);
+
+    if (! active.load())
+    {
+        writerBusy.store(false);
+        return;
+    }
+
+    // Only the parameters that moved since the previous block are stored
+    juce::uint32 numChanges = 0;
+    const int numParameters = juce::jmin(parameters.size(), static_cast<int>(lastValues.size()));
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        const float value = parameters.getUnchecked(i)->getValue();
+        auto& last = lastValues[static_cast<size_t>(i)];
+
+        if (value != last)   // NaN after start(), so the first block stores them all
+        {
+            changes[numChanges++] = { static_cast<juce::uint32>(i), value };
+            last = value;
+        }
+    }
+
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    const int blockBytes = blockHeaderSize + static_cast<int>(numChanges) * changeSize
+                             + numChannels * numSamples * static_cast<int>(sizeof(float));
+    const int dropBytes = pendingDropped > 0 ? droppedRecordSize : 0;
+
+    RingWriter writer;
+
+    if (! beginRecord(dropBytes + blockBytes, writer))
+    {
+        // Forget what this block changed, so the next stored block carries it
+        for (juce::uint32 i = 0; i < numChanges; ++i)
+            lastValues[changes[i].first] = std::numeric_limits<float>::quiet_NaN();
+
+        ++pendingDropped;
+        totalDropped.fetch_add(1, std::memory_order_relaxed);
+        writerBusy.store(false);
+        return;
+    }
+
+    if (dropBytes > 0)
+    {
+        writer.put(droppedRecord);
+        writer.put(pendingDropped);
+        pendingDropped = 0;
+    }
+
+    const auto microseconds = static_cast<juce::int64>(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6);
+
+    writer.put(blockRecord);
+    writer.put(static_cast<juce::int32>(numChannels));
+    writer.put(static_cast<juce::int32>(numSamples));
+    writer.put(microseconds);
+    writer.put(numChanges);
+
+    for (juce::uint32 i = 0; i < numChanges; ++i)
+    {
+        writer.put(changes[i].first);
+        writer.put(changes[i].second);
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        writer.put(buffer.getReadPointer(channel), numSamples * static_cast<int>(sizeof(float)));
+
+    // The drain thread polls rather than being woken: notify() can take a lock
+    fifo.finishedWrite(dropBytes + blockBytes);
+    writerBusy.store(false);
+}
+
+//==============================================================================
+void ProcessCapture::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(20);
+    }
+
+    drain();
+}
+
+void ProcessCapture::drain()
+{
+    const int numReady = fifo.getNumReady();
+
+    if (numReady == 0 || stream == nullptr)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        stream->write(ring.get() + start1, static_cast<size_t>(size1));
+
+    if (size2 > 0)
+        stream->write(ring.get() + start2, static_cast<size_t>(size2));
+
+    fifo.finishedRead(size1 + size2);
+}
+
+//==============================================================================
+CaptureReader::CaptureReader()
+{
+}
+
+CaptureReader::~CaptureReader()
+{
+}
+
+bool CaptureReader::open (const juce::File& file)
+{
+    auto newStream = std::make_unique<juce::FileInputStream>(file);
+
+    if (newStream->failedToOpen())
+        return false;
+
+    char magic[sizeof(captureMagic)] = {};
+
+    if (newStream->read(magic, sizeof(magic)) != static_cast<int>(sizeof(magic)) || std::memcmp(magic, captureMagic, sizeof(magic)) != 0)
+        return false;
+
+    const int numParameters = newStream->readInt();
+
+    if (numParameters < 0 || numParameters > 4096)
+        return false;
+
+    parameterIDs.clearQuick();
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        const int numBytes = newStream->readInt();
+
+        if (numBytes < 0 || numBytes > 1024)
+            return false;
+
+        juce::HeapBlock<char> utf8(static_cast<size_t>(numBytes) + 1, true);
+
+        if (newStream->read(utf8.get(), numBytes) != numBytes)
+            return false;
+
+        parameterIDs.add(juce::String::fromUTF8(utf8.get(), numBytes));
+    }
+
+    stream = std::move(newStream);
+    return true;
+}
+
+bool CaptureReader::readNext (Record& record)
+{
+    if (stream == nullptr || stream->isExhausted())
+        return false;
+
+    auto readValue = [this](auto& value)
+    {
+        return stream->read(&value, static_cast<int>(sizeof(value))) == static_cast<int>(sizeof(value));
+    };
+
+    char type = 0;
+
+    if (! readValue(type))
+        return false;
+
+    if (type == prepareRecord)
+    {
+        juce::int32 blockSize = 0, nonRealtime = 0;
+        record.type = Record::Type::prepare;
+
+        if (! (readValue(record.sampleRate) && readValue(blockSize) && readValue(nonRealtime)))
+            return false;
+
+        record.maximumBlockSize = blockSize;
+        record.nonRealtime = nonRealtime != 0;
+        return record.sampleRate > 0.0 && blockSize > 0;
+    }
+
+    if (type == droppedRecord)
+    {
+        juce::uint32 numDropped = 0;
+        record.type = Record::Type::dropped;
+
+        if (! readValue(numDropped))
+            return false;
+
+        record.numDropped = static_cast<int>(numDropped);
+        return true;
+    }
+
+    if (type != blockRecord)
+        return false;
+
+    juce::int32 numChannels = 0, numSamples = 0;
+    juce::uint32 numChanges = 0;
+    record.type = Record::Type::block;
+
+    if (! (readValue(numChannels) && readValue(numSamples) && readValue(record.microseconds) && readValue(numChanges)))
+        return false;
+
+    if (numChannels < 0 || numSamples < 0 || numChanges > static_cast<juce::uint32>(parameterIDs.size()))
+        return false;
+
+    record.changes.resize(numChanges);
+
+    for (auto& change : record.changes)
+    {
+        juce::uint32 index = 0;
+        float value = 0.0f;
+
+        if (! (readValue(index) && readValue(value)) || index >= static_cast<juce::uint32>(parameterIDs.size()))
+            return false;
+
+        change = { static_cast<int>(index), value };
+    }
+
+    record.audio.setSize(numChannels, numSamples, false, false, true);
+    const int channelBytes = numSamples * static_cast<int>(sizeof(float));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        if (stream->read(record.audio.getWritePointer(channel), channelBytes) != channelBytes)
+            return false;
+
+    return true;
+}
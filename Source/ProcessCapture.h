@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    ProcessCapture.h
+    Created: 20 Oct 2026 3:34:52pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/*
+    Records exactly what processBlock received, so a CPU spike seen in
+    production can be replayed under a profiler (Tools/CaptureReplay.cpp).
+
+    The audio thread copies each block's samples, plus the parameters that
+    changed since the previous block, into a preallocated byte ring; a
+    background thread drains the ring to disk. Nothing on the audio thread
+    locks or allocates. If the disk falls behind, whole blocks are dropped
+    and the gap is marked in the file.
+
+    File layout (native byte order): the magic "IMGCAP01", the parameter
+    count and each parameter ID (uint32 length + UTF-8), then records:
+      'P'  float64 sample rate, int32 maximum block size, int32 non-realtime
+      'B'  int32 channels, int32 samples, int64 microseconds since start,
+           uint32 changes, { uint32 parameter, float32 normalised value } per
+           change, then the samples channel by channel as float32
+      'D'  uint32 number of blocks dropped just before the next 'B'
+
+    A capture always starts with a 'P' record and every parameter in its
+    first 'B', so a fresh processor prepared from it starts from the same
+    settings. Replay is bit-exact when capturing started at prepareToPlay;
+    a capture started mid-stream matches once the processor's warm-up time
+    has passed.
+*/
+class ProcessCapture  : private juce::Thread
+{
+public:
+    explicit ProcessCapture (int ringBytes = 32 * 1024 * 1024);
+    ~ProcessCapture() override;
+
+    static constexpr const char* fileExtension = ".imgcap";
+
+    // Not on the audio thread. Writes the header and a prepare record with
+    // the given settings, then records every block until stop().
+    bool start (const juce::File& file, const juce::StringArray& parameterIDs,
+                double sampleRate, int maximumBlockSize, bool nonRealtime);
+    void stop();
+
+    bool isCapturing() const noexcept { return active.load(std::memory_order_relaxed); }
+    int getNumDroppedBlocks() const noexcept { return totalDropped.load(std::memory_order_relaxed); }
+
+    // Audio thread (processBlock) or prepareToPlay
+    void recordPrepare (double sampleRate, int maximumBlockSize, bool nonRealtime) noexcept;
+    void recordBlock (const juce::AudioBuffer<float>& buffer,
+                      const juce::Array<juce::AudioProcessorParameter*>& parameters) noexcept;
+
+private:
+    struct RingWriter;
+
+    void run() override;
+    void drain();
+    bool beginRecord (int numBytes, RingWriter&) noexcept;
+
+    // Whoever is the ring's producer: start() before capture is active,
+    // then the audio thread
+    void writePrepare (double sampleRate, int maximumBlockSize, bool nonRealtime) noexcept;
+
+    const int ringSize;
+    juce::HeapBlock<char> ring;
+    juce::AbstractFifo fifo;
+
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    std::atomic<bool> active { false };
+    std::atomic<bool> writerBusy { false };
+    std::atomic<int> totalDropped { 0 };
+
+    // Audio thread state, allocated by start()
+    std::vector<float> lastValues;
+    std::vector<std::pair<juce::uint32, float>> changes;
+    juce::uint32 pendingDropped = 0;
+    juce::int64 startTicks = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessCapture)
+};
+
+//==============================================================================
+/*
+    Reads a capture back one record at a time.
+*/
+class CaptureReader
+{
+public:
+    CaptureReader();
+    ~CaptureReader();
+
+    bool open (const juce::File& file);
+
+    const juce::StringArray& getParameterIDs() const noexcept { return parameterIDs; }
+
+    struct Record
+    {
+        enum class Type { prepare, block, dropped };
+        Type type = Type::block;
+
+        // prepare
+        double sampleRate = 0.0;
+        int maximumBlockSize = 0;
+        bool nonRealtime = false;
+
+        // block; `audio` keeps its allocation from record to record
+        juce::AudioBuffer<float> audio;
+        juce::int64 microseconds = 0;
+        std::vector<std::pair<int, float>> changes;
+
+        // dropped
+        int numDropped = 0;
+    };
+
+    // Returns false at the end of the file or on a truncated record
+    bool readNext (Record& record);
+
+private:
+    std::unique_ptr<juce::FileInputStream> stream;
+    juce::StringArray parameterIDs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CaptureReader)
+};
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 21 Oct 2026 1:41:08am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+#include <cmath>
+
+QualityGovernor::QualityGovernor()
+{
+}
+
+QualityGovernor::~QualityGovernor()
+{
+}
+
+void QualityGovernor::prepare (double newSampleRate, bool isRealtime)
+{
+    sampleRate = newSampleRate;
+    enabled = adaptive && isRealtime && sampleRate > 0.0;
+
+    load = 0.0;
+    secondsOverDownLoad = secondsUnderUpLoad = 0.0;
+    secondsSinceStep = 0.0;
+    secondsSinceStepDown = maximumStepUpHoldSeconds;
+    stepUpHold = stepUpHoldSeconds;
+
+    tier.store(static_cast<int>(Tier::full), std::memory_order_relaxed);
+    smoothedLoad.store(0.0f, std::memory_order_relaxed);
+}
+
+void QualityGovernor::update (double elapsedSeconds, int numSamples) noexcept
+{
+    if (! enabled || numSamples <= 0)
+        return;
+
+    const double blockSeconds = numSamples / sampleRate;
+    const double blockLoad = elapsedSeconds / blockSeconds;
+    const int current = tier.load(std::memory_order_relaxed);
+    const bool overrun = blockLoad > 1.0;
+
+    // Only this thread writes the counters, so plain increments are enough
+    auto increment = [](std::atomic<juce::uint64>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    };
+
+    increment(numBlocks[static_cast<size_t>(current)]);
+
+    if (overrun)
+        increment(numOverruns[static_cast<size_t>(current)]);
+
+    load += (1.0 - std::exp(-blockSeconds / smoothingSeconds)) * (blockLoad - load);
+    smoothedLoad.store(static_cast<float>(load), std::memory_order_relaxed);
+
+    secondsOverDownLoad = load > stepDownLoad ? secondsOverDownLoad + blockSeconds : 0.0;
+    secondsUnderUpLoad = load < stepUpLoad ? secondsUnderUpLoad + blockSeconds : 0.0;
+    secondsSinceStep += blockSeconds;
+    secondsSinceStepDown += blockSeconds;
+
+    // A tier that has held for a minute has earned the normal wait again
+    if (secondsSinceStepDown >= maximumStepUpHoldSeconds)
+        stepUpHold = stepUpHoldSeconds;
+
+    // Each step gets a moment to take effect (and for a crossfade to finish)
+    // before the next one down
+    if (current < numTiers - 1 && secondsSinceStep >= stepDownHoldSeconds
+         && (overrun || secondsOverDownLoad >= stepDownHoldSeconds))
+    {
+        // Back down soon after coming up: that tier does not really fit
+        if (secondsSinceStepUp < flappingSeconds)
+            stepUpHold = juce::jmin(2.0 * stepUpHold, maximumStepUpHoldSeconds);
+
+        stepTo(current + 1);
+        secondsSinceStepDown = 0.0;
+        increment(numStepsDown);
+    }
+    else if (current > 0 && secondsUnderUpLoad >= stepUpHold)
+    {
+        stepTo(current - 1);
+        secondsSinceStepUp = 0.0;
+        increment(numStepsUp);
+    }
+    else
+    {
+        secondsSinceStepUp += blockSeconds;
+    }
+}
+
+void QualityGovernor::stepTo (int newTier) noexcept
+{
+    tier.store(newTier, std::memory_order_relaxed);
+    secondsOverDownLoad = secondsUnderUpLoad = 0.0;
+    secondsSinceStep = 0.0;
+}
+
+QualityGovernor::Statistics QualityGovernor::getStatistics() const noexcept
+{
+    Statistics statistics;
+
+    for (size_t i = 0; i < static_cast<size_t>(numTiers); ++i)
+    {
+        statistics.numBlocks[i] = numBlocks[i].load(std::memory_order_relaxed);
+        statistics.numOverruns[i] = numOverruns[i].load(std::memory_order_relaxed);
+    }
+
+    statistics.numStepsDown = numStepsDown.load(std::memory_order_relaxed);
+    statistics.numStepsUp = numStepsUp.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+juce::uint64 QualityGovernor::getNumOverruns() const noexcept
+{
+    juce::uint64 total = 0;
+
+    for (auto& count : numOverruns)
+        total += count.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+const char* QualityGovernor::getTierName (Tier t) noexcept
+{
+    switch (t)
+    {
+        case Tier::full:    return "FULL";
+        case Tier::reduced: return "REDUCED";
+        case Tier::minimal: return "MINIMAL";
+    }
+
+    return "";
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 21 Oct 2026 1:41:08am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/*
+    Watches processBlock's own time against the block's deadline (its
+    length in real time) and picks how much of the optional work the next
+    block does.
+
+    The load is smoothed over about 50 ms. It steps down a tier as soon as a
+    block overruns its deadline, or once the smoothed load has stayed above
+    stepDownLoad for a short while. Stepping back up needs the load under
+    stepUpLoad for several seconds. A tier that gets stepped down from again
+    soon after it was entered doubles that wait (up to a minute), so a tier
+    that only just fits does not flap.
+
+    Offline renders have no deadline and always run the full tier, and so
+    does anything that switches adaptation off (tools replaying or comparing
+    renders, which must not depend on the machine they run on).
+*/
+class QualityGovernor
+{
+public:
+    enum class Tier
+    {
+        full    = 0,   // everything
+        reduced = 1,   // the editor analysis and the comparison bus analyse at half rate
+        minimal = 2    // as reduced, and binaural mode uses its low-cost path
+    };
+
+    static constexpr int numTiers = 3;
+
+    static constexpr double stepDownLoad = 0.75;
+    static constexpr double stepUpLoad = 0.4;
+
+    struct Statistics
+    {
+        std::array<juce::uint64, numTiers> numBlocks {};
+        std::array<juce::uint64, numTiers> numOverruns {};   // blocks that took longer than they last
+        juce::uint64 numStepsDown = 0, numStepsUp = 0;
+    };
+
+    QualityGovernor();
+    ~QualityGovernor();
+
+    // Starts every prepare at the full tier with the statistics kept
+    void prepare (double sampleRate, bool isRealtime);
+
+    // Not on the audio thread. Takes effect from the next prepare; while
+    // off, every block runs the full tier.
+    void setAdaptive (bool shouldAdapt) noexcept   { adaptive = shouldAdapt; }
+    bool isAdaptive() const noexcept               { return adaptive; }
+
+    // Audio thread, once per block: how long processBlock took. Moves the
+    // tier the next block will use.
+    void update (double elapsedSeconds, int numSamples) noexcept;
+
+    // Any thread
+    Tier getTier() const noexcept           { return static_cast<Tier>(tier.load(std::memory_order_relaxed)); }
+    float getLoad() const noexcept          { return smoothedLoad.load(std::memory_order_relaxed); }
+    Statistics getStatistics() const noexcept;
+    juce::uint64 getNumOverruns() const noexcept;   // across all tiers
+
+    static const char* getTierName (Tier tier) noexcept;
+
+private:
+    void stepTo (int newTier) noexcept;
+
+    static constexpr double smoothingSeconds = 0.05;
+    static constexpr double stepDownHoldSeconds = 0.1;
+    static constexpr double stepUpHoldSeconds = 3.0;
+    static constexpr double maximumStepUpHoldSeconds = 60.0;
+    static constexpr double flappingSeconds = 10.0;
+
+    double sampleRate = 0.0;
+    bool adaptive = true, enabled = false;
+
+    // Audio thread only
+    double load = 0.0;
+    double secondsOverDownLoad = 0.0, secondsUnderUpLoad = 0.0;
+    double secondsSinceStep = 0.0, secondsSinceStepDown = 0.0;
+    double secondsSinceStepUp = flappingSeconds;
+    double stepUpHold = stepUpHoldSeconds;
+
+    std::atomic<int> tier { static_cast<int>(Tier::full) };
+    std::atomic<float> smoothedLoad { 0.0f };
+
+    std::array<std::atomic<juce::uint64>, numTiers> numBlocks {}, numOverruns {};
+    std::atomic<juce::uint64> numStepsDown { 0 }, numStepsUp { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (QualityGovernor)
+};
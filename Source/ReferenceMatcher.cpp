@@ -0,0 +1,399 @@
+/*
+  ==============================================================================
+
+    ReferenceMatcher.cpp
+    Created: 21 Oct 2026 12:34:52am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "ReferenceMatcher.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    constexpr double decibelLimit = 60.0;
+
+    // Bands quieter than this relative to the loudest say nothing reliable about the image
+    constexpr double relevantBandLevel = 1.0e-6;
+
+    double ratioToDecibels (double numerator, double denominator)
+    {
+        constexpr double tiny = 1.0e-30;
+        return juce::jlimit(-decibelLimit, decibelLimit,
+                            10.0 * std::log10((juce::jmax(0.0, numerator) + tiny) / (juce::jmax(0.0, denominator) + tiny)));
+    }
+}
+
+//==============================================================================
+double ReferenceMatcher::Band::getCorrelation() const noexcept
+{
+    const auto denominator = std::sqrt(left * right);
+    return denominator > 0.0 ? juce::jlimit(-1.0, 1.0, cross / denominator) : 0.0;
+}
+
+double ReferenceMatcher::Band::getSideToMidDecibels() const noexcept
+{
+    return ratioToDecibels(getSideEnergy(), getMidEnergy());
+}
+
+double ReferenceMatcher::Band::getBalanceDecibels() const noexcept
+{
+    return ratioToDecibels(right, left);
+}
+
+ReferenceMatcher::Band ReferenceMatcher::Band::transformed (const std::array<double, 4>& m) const noexcept
+{
+    // out = M.in, so the covariance becomes M.C.Mt
+    Band b;
+    b.left  = m[0] * m[0] * left + 2.0 * m[0] * m[1] * cross + m[1] * m[1] * right;
+    b.right = m[2] * m[2] * left + 2.0 * m[2] * m[3] * cross + m[3] * m[3] * right;
+    b.cross = m[0] * m[2] * left + (m[0] * m[3] + m[1] * m[2]) * cross + m[1] * m[3] * right;
+    return b;
+}
+
+//==============================================================================
+struct ReferenceMatcher::Chunk
+{
+    juce::File file;
+    bool isReference = false;
+    juce::int64 start = 0, end = 0;   // frames starting in [start, end)
+
+    std::array<Band, numBands> bands {};
+    juce::int64 numFrames = 0;
+    juce::String error;
+};
+
+class ReferenceMatcher::AnalysisJob  : public juce::ThreadPoolJob
+{
+public:
+    AnalysisJob (const ReferenceMatcher& m, Chunk& c, const ReaderFactory& factory)
+        : juce::ThreadPoolJob("Reference analysis"), matcher(m), chunk(c), openFile(factory)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        matcher.analyseChunk(chunk, openFile);
+        return jobHasFinished;
+    }
+
+private:
+    const ReferenceMatcher& matcher;
+    Chunk& chunk;
+    const ReaderFactory& openFile;
+};
+
+//==============================================================================
+ReferenceMatcher::ReferenceMatcher (const Options& o)
+    : options(o)
+{
+    options.fftOrder = juce::jlimit(8, 16, options.fftOrder);
+    options.chunkSeconds = juce::jmax(1.0, options.chunkSeconds);
+}
+
+ReferenceMatcher::~ReferenceMatcher()
+{
+}
+
+float ReferenceMatcher::widthPercentFor (double widthFactor)
+{
+    // The inverse of StereoImager::widthFactorFor
+    const auto percent = widthFactor >= 1.0 ? 50.0 + (widthFactor - 1.0) * 50.0 : widthFactor * 50.0;
+    return static_cast<float>(juce::jlimit(0.0, 100.0, percent));
+}
+
+//==============================================================================
+ReferenceMatcher::Result ReferenceMatcher::analyse (const juce::Array<juce::File>& referenceFiles, const juce::Array<juce::File>& targetFiles,
+                                                    const ReaderFactory& openFile, const StereoImagerSettings& baseSettings)
+{
+    Result result;
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    if (referenceFiles.isEmpty() || targetFiles.isEmpty())
+    {
+        result.error = "need at least one reference and one target file";
+        return result;
+    }
+
+    const int hopSize = (1 << options.fftOrder) / 2;
+    std::vector<Chunk> chunks;
+
+    auto addFile = [&](const juce::File& file, bool isReference, Profile& profile)
+    {
+        auto reader = openFile(file);
+
+        if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0)
+        {
+            result.error = "could not read " + file.getFullPathName();
+            return false;
+        }
+
+        // Whole hops per chunk, so every chunk's frames sit on the same grid a serial pass would use
+        const auto length = reader->lengthInSamples;
+        const auto chunkLength = juce::jmax<juce::int64>(hopSize, static_cast<juce::int64>(options.chunkSeconds * reader->sampleRate) / hopSize * hopSize);
+
+        for (juce::int64 start = 0; start < length; start += chunkLength)
+        {
+            Chunk chunk;
+            chunk.file = file;
+            chunk.isReference = isReference;
+            chunk.start = start;
+            chunk.end = juce::jmin(length, start + chunkLength);
+            chunks.push_back(std::move(chunk));
+        }
+
+        profile.seconds += static_cast<double>(length) / reader->sampleRate;
+        ++profile.numFiles;
+        return true;
+    };
+
+    for (const auto& file : referenceFiles)
+        if (! addFile(file, true, result.reference))
+            return result;
+
+    for (const auto& file : targetFiles)
+        if (! addFile(file, false, result.target))
+            return result;
+
+    //==============================================================================
+    {
+        const int numThreads = options.numThreads > 0 ? options.numThreads : juce::SystemStats::getNumCpus();
+        juce::ThreadPool pool(juce::jmin(static_cast<int>(chunks.size()), numThreads));
+
+        for (auto& chunk : chunks)
+            pool.addJob(new AnalysisJob(*this, chunk, openFile), true);
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(5);
+    }
+
+    // Summed in chunk order, so the result does not depend on scheduling
+    for (const auto& chunk : chunks)
+    {
+        if (chunk.error.isNotEmpty())
+        {
+            result.error = chunk.error;
+            return result;
+        }
+
+        auto& profile = chunk.isReference ? result.reference : result.target;
+
+        for (int band = 0; band < numBands; ++band)
+        {
+            auto& total = profile.bands[static_cast<size_t>(band)];
+            const auto& part = chunk.bands[static_cast<size_t>(band)];
+            total.left += part.left;
+            total.right += part.right;
+            total.cross += part.cross;
+        }
+
+        profile.numFrames += chunk.numFrames;
+    }
+
+    result.match = match(result.reference, result.target, baseSettings);
+    result.succeeded = true;
+    result.elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return result;
+}
+
+void ReferenceMatcher::analyseChunk (Chunk& chunk, const ReaderFactory& openFile) const
+{
+    auto reader = openFile(chunk.file);
+
+    if (reader == nullptr)
+    {
+        chunk.error = "could not open " + chunk.file.getFullPathName();
+        return;
+    }
+
+    const int fftSize = 1 << options.fftOrder;
+    const int hopSize = fftSize / 2;
+    juce::dsp::FFT fft(options.fftOrder);
+
+    std::vector<float> window(static_cast<size_t>(fftSize));
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), static_cast<size_t>(fftSize),
+                                                             juce::dsp::WindowingFunction<float>::hann, false);
+
+    // Bins below the first band (DC and sub-sonic rumble) are left out
+    std::vector<int> bandOfBin(static_cast<size_t>(fftSize / 2 + 1), -1);
+
+    for (int bin = 1; bin <= fftSize / 2; ++bin)
+    {
+        const auto frequency = bin * reader->sampleRate / fftSize;
+
+        for (int band = numBands - 1; band >= 0; --band)
+        {
+            if (frequency >= bandStarts[static_cast<size_t>(band)])
+            {
+                bandOfBin[static_cast<size_t>(bin)] = band;
+                break;
+            }
+        }
+    }
+
+    // Each frame reuses the previous one's second half and reads only one
+    // hop, so every sample is decoded once. Reads past the end of the file
+    // return silence, which pads the last frame.
+    juce::AudioBuffer<float> frame(2, fftSize);
+    std::vector<float> leftSpectrum(static_cast<size_t>(fftSize * 2)), rightSpectrum(static_cast<size_t>(fftSize * 2));
+
+    reader->read(&frame, 0, hopSize, chunk.start, true, true);
+
+    for (auto position = chunk.start; position < chunk.end; position += hopSize)
+    {
+        reader->read(&frame, hopSize, hopSize, position + hopSize, true, true);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto& spectrum = channel == 0 ? leftSpectrum : rightSpectrum;
+            juce::FloatVectorOperations::multiply(spectrum.data(), frame.getReadPointer(channel), window.data(), fftSize);
+            fft.performRealOnlyForwardTransform(spectrum.data(), true);
+        }
+
+        for (int bin = 1; bin <= fftSize / 2; ++bin)
+        {
+            const auto band = bandOfBin[static_cast<size_t>(bin)];
+
+            if (band < 0)
+                continue;
+
+            const auto lr = static_cast<double>(leftSpectrum[static_cast<size_t>(2 * bin)]);
+            const auto li = static_cast<double>(leftSpectrum[static_cast<size_t>(2 * bin + 1)]);
+            const auto rr = static_cast<double>(rightSpectrum[static_cast<size_t>(2 * bin)]);
+            const auto ri = static_cast<double>(rightSpectrum[static_cast<size_t>(2 * bin + 1)]);
+
+            auto& sums = chunk.bands[static_cast<size_t>(band)];
+            sums.left += lr * lr + li * li;
+            sums.right += rr * rr + ri * ri;
+            sums.cross += lr * rr + li * ri;
+        }
+
+        ++chunk.numFrames;
+
+        for (int channel = 0; channel < 2; ++channel)
+            frame.copyFrom(channel, 0, frame, channel, hopSize, hopSize);
+    }
+}
+
+//==============================================================================
+ReferenceMatcher::Match ReferenceMatcher::match (const Profile& reference, const Profile& target, const StereoImagerSettings& baseSettings)
+{
+    Match result;
+    result.settings = baseSettings;
+    result.widthPercent = widthPercentFor(baseSettings.widthFactor);
+    result.midSide = baseSettings.midSide;
+    result.matched = target;
+
+    auto loudest = [](const Profile& profile)
+    {
+        double level = 0.0;
+
+        for (const auto& band : profile.bands)
+            level = juce::jmax(level, band.left + band.right);
+
+        return level;
+    };
+
+    const auto referenceLoudest = loudest(reference);
+    const auto targetLoudest = loudest(target);
+    int numCounted = 0;
+
+    for (size_t band = 0; band < static_cast<size_t>(numBands); ++band)
+    {
+        const auto& r = reference.bands[band];
+        const auto& t = target.bands[band];
+
+        result.bandCounts[band] = referenceLoudest > 0.0 && targetLoudest > 0.0
+                                   && r.left + r.right > relevantBandLevel * referenceLoudest
+                                   && t.left + t.right > relevantBandLevel * targetLoudest;
+
+        // Side energy scales with the side gain squared, so one band on its
+        // own needs gain 10^(difference / 20)
+        const auto difference = r.getSideToMidDecibels() - t.getSideToMidDecibels();
+        result.bandWidthPercent[band] = widthPercentFor(std::pow(10.0, difference / 20.0));
+
+        if (result.bandCounts[band])
+            ++numCounted;
+    }
+
+    if (numCounted == 0)
+        return result;
+
+    // The balance the base settings give the target, before width and mid/side
+    auto neutral = baseSettings;
+    neutral.widthFactor = 1.0f;
+    neutral.midSide = 0.0f;
+    const auto neutralMatrix = StereoImager::getMatrix(neutral);
+
+    // Side-to-mid error, and the same plus the balance penalty that keeps
+    // mid/side from buying a match by pulling the image to one side
+    auto evaluate = [&](const std::array<double, 4>& matrix, double& imageError)
+    {
+        double total = 0.0;
+        imageError = 0.0;
+
+        for (size_t band = 0; band < static_cast<size_t>(numBands); ++band)
+        {
+            if (! result.bandCounts[band])
+                continue;
+
+            const auto& t = target.bands[band];
+            const auto processed = t.transformed(matrix);
+            const auto image = processed.getSideToMidDecibels() - reference.bands[band].getSideToMidDecibels();
+            const auto balance = processed.getBalanceDecibels() - t.transformed(neutralMatrix).getBalanceDecibels();
+
+            imageError += image * image;
+            total += image * image + balance * balance;
+        }
+
+        imageError = std::sqrt(imageError / numCounted);
+        return total;
+    };
+
+    // "Before" is the target as the base settings already leave it, which
+    // is only unprocessed when they are neutral
+    double imageError = 0.0;
+    evaluate(StereoImager::getMatrix(baseSettings), imageError);
+    result.errorBeforeDecibels = imageError;
+
+    // An exhaustive grid at (about) the parameters' own resolution: a few
+    // hundred thousand 2x2 products, far cheaper than the analysis
+    auto settings = baseSettings;
+    double bestScore = std::numeric_limits<double>::max();
+
+    for (int w = 0; w <= 400; ++w)
+    {
+        const auto widthPercent = static_cast<float>(w) * 0.25f;
+        settings.widthFactor = StereoImager::widthFactorFor(widthPercent);
+
+        for (int k = -100; k <= 100; ++k)
+        {
+            settings.midSide = static_cast<float>(k) * 0.01f;
+
+            const auto score = evaluate(StereoImager::getMatrix(settings), imageError);
+
+            if (score < bestScore)
+            {
+                bestScore = score;
+                result.widthPercent = widthPercent;
+                result.midSide = settings.midSide;
+                result.errorAfterDecibels = imageError;
+            }
+        }
+    }
+
+    result.settings.widthFactor = StereoImager::widthFactorFor(result.widthPercent);
+    result.settings.midSide = result.midSide;
+
+    const auto matrix = StereoImager::getMatrix(result.settings);
+
+    for (size_t band = 0; band < static_cast<size_t>(numBands); ++band)
+        result.matched.bands[band] = target.bands[band].transformed(matrix);
+
+    return result;
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    ReferenceMatcher.h
+    Created: 21 Oct 2026 12:34:52am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <functional>
+#include "StereoImager.h"
+
+//==============================================================================
+/*
+    Offline analysis that finds imager settings moving a target's stereo
+    image toward a reference's, e.g. a mix toward a finished master.
+
+    Both sides are any number of files (a whole album is fine), read in
+    fixed-length chunks and analysed on a thread pool, each chunk with its
+    own reader. Every chunk runs a Hann-windowed FFT and sums, per band, the
+    left and right power and their cross spectrum. Those three sums are the
+    band's 2x2 covariance, which gives its mid and side energy and its
+    correlation, and is exactly what a constant stereo matrix transforms:
+    C' = M.C.Mt. So the effect of any width and mid/side setting on the
+    target can be predicted without rendering anything.
+
+    The processor applies one broadband matrix, so the match is a
+    compromise. For each band, the side-to-mid ratio after processing is
+    compared with the reference's. The search minimises the summed squared
+    dB error over width and mid/side, plus a penalty for moving the
+    band's left/right level balance. Each band's own best width (width
+    alone) is reported as well.
+*/
+class ReferenceMatcher
+{
+public:
+    static constexpr int numBands = 8;
+
+    // Band edges in Hz; the last band runs to Nyquist
+    static constexpr std::array<double, numBands> bandStarts { 20.0, 80.0, 200.0, 500.0, 1200.0, 3000.0, 6000.0, 12000.0 };
+
+    struct Options
+    {
+        int fftOrder = 12;            // 4096-point frames, half overlapped
+        double chunkSeconds = 30.0;   // the unit of parallel work
+        int numThreads = 0;           // 0 = one per CPU core
+    };
+
+    struct Band
+    {
+        double left = 0.0, right = 0.0, cross = 0.0;   // summed |L|^2, |R|^2 and Re(L.conj(R))
+
+        double getMidEnergy() const noexcept   { return 0.25 * (left + right + 2.0 * cross); }
+        double getSideEnergy() const noexcept  { return 0.25 * (left + right - 2.0 * cross); }
+        double getCorrelation() const noexcept;
+        double getSideToMidDecibels() const noexcept;
+        double getBalanceDecibels() const noexcept;    // right over left
+
+        // The band after a row-major stereo matrix
+        Band transformed (const std::array<double, 4>& matrix) const noexcept;
+    };
+
+    struct Profile
+    {
+        std::array<Band, numBands> bands {};
+        juce::int64 numFrames = 0;
+        double seconds = 0.0;
+        int numFiles = 0;
+    };
+
+    struct Match
+    {
+        StereoImagerSettings settings;      // base settings with width and mid/side replaced
+        float widthPercent = 50.0f;
+        float midSide = 0.0f;
+        double errorBeforeDecibels = 0.0;   // RMS side-to-mid error over the bands that count
+        double errorAfterDecibels = 0.0;
+
+        std::array<bool, numBands> bandCounts {};
+        std::array<float, numBands> bandWidthPercent {};   // each band's best width on its own
+        Profile matched;                                   // the target as the match should leave it
+    };
+
+    struct Result
+    {
+        bool succeeded = false;
+        Profile reference, target;
+        Match match;
+        double elapsedSeconds = 0.0;
+        juce::String error;
+    };
+
+    // Each chunk opens its own reader, since readers are not thread-safe
+    using ReaderFactory = std::function<std::unique_ptr<juce::AudioFormatReader>(const juce::File&)>;
+
+    explicit ReferenceMatcher (const Options& options);
+    ~ReferenceMatcher();
+
+    // Analyses both sides in one pass over the pool and matches them.
+    // Balance, crossfeed and the rest come from baseSettings unchanged.
+    Result analyse (const juce::Array<juce::File>& referenceFiles, const juce::Array<juce::File>& targetFiles,
+                    const ReaderFactory& openFile, const StereoImagerSettings& baseSettings);
+
+    static Match match (const Profile& reference, const Profile& target, const StereoImagerSettings& baseSettings);
+
+    // Width percentage whose side gain is the given factor, clamped to the parameter's range
+    static float widthPercentFor (double widthFactor);
+
+private:
+    struct Chunk;
+    class AnalysisJob;
+
+    void analyseChunk (Chunk&, const ReaderFactory& openFile) const;
+
+    Options options;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReferenceMatcher)
+};
@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+    RenderClient.cpp
+    Created: 20 Oct 2026 10:41:30pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "RenderClient.h"
+
+#include <cstring>
+
+#if defined (__linux__)
+ #include <sys/mman.h>
+ #include <sys/socket.h>
+ #include <sys/un.h>
+ #include <poll.h>
+ #include <unistd.h>
+ #include <cerrno>
+ #define IMAGINATION_RENDER_CLIENT 1
+#else
+ #define IMAGINATION_RENDER_CLIENT 0
+#endif
+
+using namespace ImaginationRender;
+
+#if IMAGINATION_RENDER_CLIENT
+namespace
+{
+    bool sendAll (int fd, const void* data, std::size_t numBytes)
+    {
+        auto* bytes = static_cast<const char*>(data);
+
+        while (numBytes > 0)
+        {
+            const auto sent = send(fd, bytes, numBytes, MSG_NOSIGNAL);
+
+            if (sent < 0 && errno == EINTR)
+                continue;
+
+            if (sent <= 0)
+                return false;
+
+            bytes += sent;
+            numBytes -= static_cast<std::size_t>(sent);
+        }
+
+        return true;
+    }
+
+    // The reply and its three descriptors arrive in one message
+    bool receiveReply (int fd, OpenReply& reply, int (&fds)[3])
+    {
+        char control[CMSG_SPACE(sizeof(int) * 3)] {};
+        iovec io { &reply, sizeof(reply) };
+
+        msghdr message {};
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t received;
+        do { received = recvmsg(fd, &message, MSG_WAITALL | MSG_CMSG_CLOEXEC); } while (received < 0 && errno == EINTR);
+
+        if (received != static_cast<ssize_t>(sizeof(reply)))
+            return false;
+
+        for (auto* c = CMSG_FIRSTHDR(&message); c != nullptr; c = CMSG_NXTHDR(&message, c))
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS && c->cmsg_len == CMSG_LEN(sizeof(int) * 3))
+                std::memcpy(fds, CMSG_DATA(c), sizeof(int) * 3);
+
+        return true;
+    }
+
+    void wake (int eventFd) noexcept
+    {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = write(eventFd, &one, sizeof(one));
+    }
+
+    void drain (int eventFd) noexcept
+    {
+        std::uint64_t count = 0;
+        [[maybe_unused]] const auto numRead = read(eventFd, &count, sizeof(count));
+    }
+}
+#endif
+
+//==============================================================================
+RenderClient::RenderClient()
+{
+}
+
+RenderClient::~RenderClient()
+{
+    close();
+}
+
+bool RenderClient::open (const Options& options, std::string& error)
+{
+    close();
+
+   #if IMAGINATION_RENDER_CLIENT
+    OpenRequest request;
+    request.highQuality = options.highQuality ? 1u : 0u;
+    request.sampleRate = options.sampleRate;
+    request.blockSize = options.blockSize;
+    request.numSlots = options.numSlots;
+    request.presetBytes = static_cast<std::uint32_t>(options.presetXml.size());
+
+    if (! isValidRequest(request) || options.presetXml.size() > maxPresetBytes)
+    {
+        error = "unsupported sample rate, block size, slot count or preset size";
+        return false;
+    }
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+
+    if (options.socketPath.size() >= sizeof(address.sun_path))
+    {
+        error = "socket path too long";
+        return false;
+    }
+
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size());
+
+    socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (socketFd < 0 || connect(socketFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        error = "could not connect to " + options.socketPath + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    OpenReply reply;
+    int fds[3] = { -1, -1, -1 };
+
+    if (! sendAll(socketFd, &request, sizeof(request))
+         || ! sendAll(socketFd, options.presetXml.data(), options.presetXml.size())
+         || ! receiveReply(socketFd, reply, fds))
+    {
+        error = "the daemon closed the connection";
+        close();
+        return false;
+    }
+
+    submitEvent = fds[1];
+    completeEvent = fds[2];
+
+    if (reply.status != statusOk || fds[0] < 0 || submitEvent < 0 || completeEvent < 0
+         || reply.sharedBytes != getSharedBytes(options.blockSize, options.numSlots))
+    {
+        error = reply.status == statusBadPreset  ? "the daemon could not read the preset"
+              : reply.status == statusNoResources ? "the daemon has no room for another stream"
+                                                  : "the daemon refused the stream";
+        if (fds[0] >= 0)
+            ::close(fds[0]);
+
+        close();
+        return false;
+    }
+
+    sharedBytes = static_cast<std::size_t>(reply.sharedBytes);
+    auto* mapped = mmap(nullptr, sharedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    ::close(fds[0]);
+
+    if (mapped == MAP_FAILED)
+    {
+        error = std::string("could not map the stream: ") + std::strerror(errno);
+        sharedBytes = 0;
+        close();
+        return false;
+    }
+
+    header = static_cast<StreamHeader*>(mapped);
+    blockSize = options.blockSize;
+    numSlots = options.numSlots;
+    latencySamples = reply.latencySamples;
+    numSubmitted = numReleased = header->submitted.blocks.load(std::memory_order_acquire);
+    return true;
+   #else
+    (void) options;
+    error = "the render daemon needs Linux";
+    return false;
+   #endif
+}
+
+void RenderClient::close()
+{
+   #if IMAGINATION_RENDER_CLIENT
+    if (header != nullptr)
+        munmap(header, sharedBytes);
+
+    for (auto* fd : { &socketFd, &submitEvent, &completeEvent })
+    {
+        if (*fd >= 0)
+            ::close(*fd);
+
+        *fd = -1;
+    }
+   #endif
+
+    header = nullptr;
+    sharedBytes = 0;
+    blockBegun = false;
+    pendingChanges.numChanges = 0;
+}
+
+float* const* RenderClient::beginBlock() noexcept
+{
+    if (header == nullptr || numSubmitted - numReleased >= static_cast<std::uint64_t>(numSlots))
+        return nullptr;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        inputChannels[channel] = getChannel(*header, blockSize, numSlots, numSubmitted, channel);
+
+    blockBegun = true;
+    return inputChannels;
+}
+
+void RenderClient::submitBlock() noexcept
+{
+    if (! blockBegun)
+        return;
+
+    blockBegun = false;
+
+    // Published by the counter's store, like the audio
+    auto& changes = getChanges(*header, numSlots, numSubmitted);
+    changes.numChanges = pendingChanges.numChanges;
+    std::memcpy(changes.changes, pendingChanges.changes, sizeof(ParameterChange) * pendingChanges.numChanges);
+    pendingChanges.numChanges = 0;
+
+    header->submitted.blocks.store(++numSubmitted, std::memory_order_seq_cst);
+
+   #if IMAGINATION_RENDER_CLIENT
+    // The daemon only needs waking when it has run out of blocks for this stream
+    if (header->submitted.waiting.exchange(0, std::memory_order_seq_cst) != 0)
+        wake(submitEvent);
+   #endif
+}
+
+bool RenderClient::isCompleted (std::uint64_t block) const noexcept
+{
+    return header->completed.blocks.load(std::memory_order_acquire) > block;
+}
+
+const float* const* RenderClient::waitForBlock (int timeoutMs) noexcept
+{
+    if (header == nullptr || numReleased == numSubmitted)
+        return nullptr;
+
+   #if IMAGINATION_RENDER_CLIENT
+    while (! isCompleted(numReleased))
+    {
+        // Announce the sleep, then look again: the daemon either sees the flag
+        // and signals, or finished before it and the second look catches it
+        header->completed.waiting.store(1, std::memory_order_seq_cst);
+
+        if (isCompleted(numReleased))
+            break;
+
+        pollfd fds[2] = { { completeEvent, POLLIN, 0 }, { socketFd, POLLIN, 0 } };
+        const int ready = poll(fds, 2, timeoutMs);
+
+        if (ready == 0)
+            return nullptr;
+
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return nullptr;
+        }
+
+        // The daemon never writes to the socket once the stream is open, so
+        // anything there means it has closed it
+        if (fds[1].revents != 0)
+            return nullptr;
+
+        drain(completeEvent);
+    }
+   #else
+    (void) timeoutMs;
+   #endif
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        outputChannels[channel] = getChannel(*header, blockSize, numSlots, numReleased, channel);
+
+    return outputChannels;
+}
+
+void RenderClient::releaseBlock() noexcept
+{
+    if (numReleased < numSubmitted && isCompleted(numReleased))
+        ++numReleased;
+}
+
+bool RenderClient::processBlock (const float* const* input, float* const* output, int timeoutMs) noexcept
+{
+    auto* const* slot = beginBlock();
+
+    if (slot == nullptr)
+        return false;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        std::memcpy(slot[channel], input[channel], sizeof(float) * static_cast<std::size_t>(blockSize));
+
+    submitBlock();
+
+    const auto* const* processed = waitForBlock(timeoutMs);
+
+    if (processed == nullptr)
+        return false;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        std::memcpy(output[channel], processed[channel], sizeof(float) * static_cast<std::size_t>(blockSize));
+
+    releaseBlock();
+    return true;
+}
+
+bool RenderClient::setParameter (const char* parameterId, float normalisedValue) noexcept
+{
+    if (header == nullptr || std::strlen(parameterId) >= static_cast<std::size_t>(maxParameterIdLength))
+        return false;
+
+    ParameterChange change {};
+    std::strncpy(change.parameterId, parameterId, maxParameterIdLength - 1);
+    change.normalisedValue = normalisedValue;
+
+    for (std::uint32_t i = 0; i < pendingChanges.numChanges; ++i)
+    {
+        if (std::strncmp(pendingChanges.changes[i].parameterId, change.parameterId, maxParameterIdLength) == 0)
+        {
+            pendingChanges.changes[i] = change;
+            return true;
+        }
+    }
+
+    if (pendingChanges.numChanges >= static_cast<std::uint32_t>(maxChangesPerBlock))
+        return false;
+
+    pendingChanges.changes[pendingChanges.numChanges++] = change;
+    return true;
+}
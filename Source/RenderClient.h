@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    RenderClient.h
+    Created: 20 Oct 2026 10:41:30pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RenderProtocol.h"
+
+#include <string>
+
+//==============================================================================
+/*
+    One audio stream through the render daemon (see RenderProtocol.h and
+    Tools/RenderDaemon.cpp). Plain POSIX and Linux only, with no JUCE
+    dependency, so a pipeline can build it straight into its own binaries.
+
+    The zero-copy interface works on the shared ring directly: write the
+    input into the channels from beginBlock(), submitBlock(), and later read
+    the processed audio in place from waitForBlock() before releaseBlock().
+    Up to numSlots blocks can be in flight, and they come back in the order
+    they were submitted. processBlock() wraps that for one block at a time.
+
+    A client is used from one thread at a time.
+*/
+class RenderClient
+{
+public:
+    struct Options
+    {
+        std::string socketPath = ImaginationRender::getDefaultSocketPath();
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numSlots = 4;
+        bool highQuality = false;   // the plugin's offline configuration, with latency
+        std::string presetXml;      // an ImaginationPreset document, empty for the defaults
+    };
+
+    RenderClient();
+    ~RenderClient();
+
+    RenderClient (const RenderClient&) = delete;
+    RenderClient& operator= (const RenderClient&) = delete;
+
+    // Connects and opens the stream; on failure says why in error
+    bool open (const Options& options, std::string& error);
+    void close();
+
+    bool isOpen() const noexcept { return header != nullptr; }
+
+    int getBlockSize() const noexcept       { return blockSize; }
+    int getLatencySamples() const noexcept  { return latencySamples; }
+    int getNumBlocksInFlight() const noexcept { return static_cast<int>(numSubmitted - numReleased); }
+
+    // Both channels of the next free slot, or nullptr if every slot is in
+    // flight or still waiting to be released
+    float* const* beginBlock() noexcept;
+    void submitBlock() noexcept;
+
+    // The oldest block in flight once it has been processed. nullptr on
+    // timeout (-1 waits forever), with nothing in flight, or if the daemon
+    // has gone away.
+    const float* const* waitForBlock (int timeoutMs) noexcept;
+    void releaseBlock() noexcept;
+
+    // Copies one block of getBlockSize() samples in, waits and copies it out
+    bool processBlock (const float* const* input, float* const* output, int timeoutMs) noexcept;
+
+    // Takes effect from the next block submitted: the change travels in that
+    // block's slot and the daemon applies it just before processing it, so
+    // blocks already in flight keep the old value. Setting the same
+    // parameter again before then replaces the value. False once
+    // maxChangesPerBlock different parameters are waiting, or for an id of
+    // maxParameterIdLength or more; ids the processor doesn't have are
+    // ignored.
+    bool setParameter (const char* parameterId, float normalisedValue) noexcept;
+
+private:
+    bool isCompleted (std::uint64_t block) const noexcept;
+
+    int socketFd = -1;
+    int submitEvent = -1;
+    int completeEvent = -1;
+
+    ImaginationRender::StreamHeader* header = nullptr;
+    std::size_t sharedBytes = 0;
+
+    int blockSize = 0;
+    int numSlots = 0;
+    int latencySamples = 0;
+
+    std::uint64_t numSubmitted = 0;
+    std::uint64_t numReleased = 0;
+    bool blockBegun = false;
+    ImaginationRender::SlotChanges pendingChanges {};
+
+    float* inputChannels[ImaginationRender::numChannels] {};
+    const float* outputChannels[ImaginationRender::numChannels] {};
+};
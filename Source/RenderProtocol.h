@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    RenderProtocol.h
+    Created: 20 Oct 2026 10:18:52pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+//==============================================================================
+/*
+    Wire format and shared-memory layout between the render daemon
+    (RenderServer) and its clients (RenderClient). No JUCE dependency, so
+    a pipeline can link the client without the plugin's modules.
+
+    Control goes over a Unix domain socket: a client sends an OpenRequest
+    (followed by an optional ImaginationPreset XML document) and gets an
+    OpenReply together with three file descriptors: the stream's shared
+    memory, and one eventfd for each direction. Nothing else goes over the
+    socket; closing it closes the stream.
+
+    The shared memory holds a ring of numSlots blocks, planar stereo, each
+    with the parameter changes that apply from it, and two block counters.
+    The client fills a slot and bumps `submitted`; the daemon applies the
+    slot's changes, processes its audio in place and bumps `completed`; the
+    client reads the result from the same slot and only then reuses it. Each side only signals the other's eventfd when
+    that side has said it is about to sleep (`waiting`), so a busy stream
+    costs no system calls.
+*/
+namespace ImaginationRender
+{
+    static constexpr const char* socketFileName = "imagination-render.sock";
+    static constexpr std::uint32_t protocolMagic = 0x494d5231; // "IMR1"
+    static constexpr std::uint32_t protocolVersion = 2;
+
+    static constexpr int numChannels = 2;
+    static constexpr int maxBlockSize = 8192;
+    static constexpr int maxSlots = 64;
+    static constexpr int maxParameterIdLength = 32;
+    static constexpr int maxChangesPerBlock = 16;
+    static constexpr std::uint32_t maxPresetBytes = 1u << 20;
+
+    enum MessageType : std::uint32_t
+    {
+        openStream = 1
+    };
+
+    enum Status : std::int32_t
+    {
+        statusOk           = 0,
+        statusBadRequest   = 1,
+        statusBadPreset    = 2,
+        statusNoResources  = 3
+    };
+
+    struct OpenRequest
+    {
+        std::uint32_t magic = protocolMagic;
+        std::uint32_t version = protocolVersion;
+        std::uint32_t type = openStream;
+        std::uint32_t highQuality = 0;   // prepare the processor as an offline render
+        double sampleRate = 48000.0;
+        std::int32_t blockSize = 512;
+        std::int32_t numSlots = 4;
+        std::uint32_t presetBytes = 0;   // ImaginationPreset XML that follows, 0 for the defaults
+    };
+
+    // Sent with SCM_RIGHTS: the shared memory, then the submit and complete eventfds
+    struct OpenReply
+    {
+        std::int32_t status = statusOk;
+        std::uint32_t streamId = 0;
+        std::int32_t latencySamples = 0;
+        std::uint32_t reserved = 0;
+        std::uint64_t sharedBytes = 0;
+    };
+
+    // In $XDG_RUNTIME_DIR where there is one, so each user gets their own daemon
+    inline std::string getDefaultSocketPath()
+    {
+        const char* runtimeDirectory = std::getenv("XDG_RUNTIME_DIR");
+        return std::string(runtimeDirectory != nullptr && *runtimeDirectory != 0 ? runtimeDirectory : "/tmp") + "/" + socketFileName;
+    }
+
+    //==============================================================================
+    struct alignas(64) Counter
+    {
+        std::atomic<std::uint64_t> blocks;    // only ever increases
+        std::atomic<std::uint32_t> waiting;   // the reader of this counter is about to sleep
+    };
+
+    struct StreamHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::int32_t blockSize;
+        std::int32_t numSlots;
+
+        Counter submitted;   // written by the client
+        Counter completed;   // written by the daemon
+    };
+
+    struct ParameterChange
+    {
+        char parameterId[maxParameterIdLength];   // not terminated at full length
+        float normalisedValue;
+    };
+
+    // Written by the client with the slot's audio; the daemon applies them,
+    // in order, just before processing that block
+    struct alignas(64) SlotChanges
+    {
+        std::uint32_t numChanges;
+        ParameterChange changes[maxChangesPerBlock];
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "stream counters need lock-free atomics");
+
+    // Every channel of every slot starts on its own cache line
+    inline std::size_t getChannelStride (int blockSize) noexcept
+    {
+        return (static_cast<std::size_t>(blockSize) + 15u) & ~static_cast<std::size_t>(15u);
+    }
+
+    inline std::size_t getSharedBytes (int blockSize, int numSlots) noexcept
+    {
+        return sizeof(StreamHeader) + sizeof(SlotChanges) * static_cast<std::size_t>(numSlots)
+                + sizeof(float) * getChannelStride(blockSize) * static_cast<std::size_t>(numChannels * numSlots);
+    }
+
+    // These take the sizes from the caller rather than the header, which the other process can write to
+    inline SlotChanges& getChanges (StreamHeader& header, int numSlots, std::uint64_t block) noexcept
+    {
+        const auto slot = static_cast<std::size_t>(block % static_cast<std::uint64_t>(numSlots));
+        return reinterpret_cast<SlotChanges*>(reinterpret_cast<char*>(&header) + sizeof(StreamHeader))[slot];
+    }
+
+    inline float* getChannel (StreamHeader& header, int blockSize, int numSlots, std::uint64_t block, int channel) noexcept
+    {
+        const auto slot = static_cast<std::size_t>(block % static_cast<std::uint64_t>(numSlots));
+        auto* audio = reinterpret_cast<float*>(reinterpret_cast<char*>(&header) + sizeof(StreamHeader)
+                                                + sizeof(SlotChanges) * static_cast<std::size_t>(numSlots));
+        return audio + getChannelStride(blockSize) * (slot * numChannels + static_cast<std::size_t>(channel));
+    }
+
+    inline bool isValidRequest (const OpenRequest& request) noexcept
+    {
+        return request.magic == protocolMagic && request.version == protocolVersion && request.type == openStream
+                && request.sampleRate >= 8000.0 && request.sampleRate <= 768000.0
+                && request.blockSize > 0 && request.blockSize <= maxBlockSize
+                && request.numSlots >= 2 && request.numSlots <= maxSlots
+                && request.presetBytes <= maxPresetBytes;
+    }
+}
@@ -0,0 +1,801 @@
+/*
+  ==============================================================================
+
+    RenderServer.cpp
+    Created: 20 Oct 2026 11:06:17pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "RenderServer.h"
+#include "PluginProcessor.h"
+
+#if JUCE_LINUX
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
+ #include <sys/mman.h>
+ #include <sys/socket.h>
+ #include <sys/un.h>
+ #include <unistd.h>
+ #include <cerrno>
+ #define IMAGINATION_RENDER_SERVER 1
+#else
+ #define IMAGINATION_RENDER_SERVER 0
+#endif
+
+using namespace ImaginationRender;
+
+#if IMAGINATION_RENDER_SERVER
+namespace
+{
+    bool sendReply (int fd, const OpenReply& reply, const int* fds, int numFds)
+    {
+        char control[CMSG_SPACE(sizeof(int) * 3)] {};
+        iovec io { const_cast<OpenReply*>(&reply), sizeof(reply) };
+
+        msghdr message {};
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+
+        if (numFds > 0)
+        {
+            message.msg_control = control;
+            message.msg_controllen = CMSG_SPACE(sizeof(int) * static_cast<size_t>(numFds));
+
+            auto* c = CMSG_FIRSTHDR(&message);
+            c->cmsg_level = SOL_SOCKET;
+            c->cmsg_type = SCM_RIGHTS;
+            c->cmsg_len = CMSG_LEN(sizeof(int) * static_cast<size_t>(numFds));
+            std::memcpy(CMSG_DATA(c), fds, sizeof(int) * static_cast<size_t>(numFds));
+        }
+
+        ssize_t sent;
+        do { sent = sendmsg(fd, &message, MSG_NOSIGNAL); } while (sent < 0 && errno == EINTR);
+
+        return sent == static_cast<ssize_t>(sizeof(reply));
+    }
+
+    void wake (int eventFd) noexcept
+    {
+        const juce::uint64 one = 1;
+        juce::ignoreUnused(write(eventFd, &one, sizeof(one)));
+    }
+
+    void drain (int eventFd) noexcept
+    {
+        juce::uint64 count = 0;
+        juce::ignoreUnused(read(eventFd, &count, sizeof(count)));
+    }
+
+    void closeIfOpen (int& fd) noexcept
+    {
+        if (fd >= 0)
+            close(fd);
+
+        fd = -1;
+    }
+}
+
+//==============================================================================
+class RenderServer::Stream
+{
+public:
+    Stream (juce::uint32 streamId, int socket)
+        : id(streamId), socketFd(socket)
+    {
+    }
+
+    ~Stream()
+    {
+        if (header != nullptr)
+            munmap(header, sharedBytes);
+
+        closeIfOpen(memoryFd);
+        closeIfOpen(submitEvent);
+        closeIfOpen(completeEvent);
+        closeIfOpen(socketFd);
+    }
+
+    bool allocate (int newBlockSize, int newNumSlots)
+    {
+        blockSize = newBlockSize;
+        numSlots = newNumSlots;
+        sharedBytes = getSharedBytes(blockSize, numSlots);
+
+        memoryFd = memfd_create("imagination-render", MFD_CLOEXEC);
+        submitEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        completeEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        if (memoryFd < 0 || submitEvent < 0 || completeEvent < 0
+             || ftruncate(memoryFd, static_cast<off_t>(sharedBytes)) != 0)
+            return false;
+
+        auto* mapped = mmap(nullptr, sharedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0);
+
+        if (mapped == MAP_FAILED)
+            return false;
+
+        // ftruncate zero-fills, so both counters start at 0
+        header = static_cast<StreamHeader*>(mapped);
+        header->magic = protocolMagic;
+        header->version = protocolVersion;
+        header->blockSize = blockSize;
+        header->numSlots = numSlots;
+        header->submitted.waiting.store(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    // Runs every block the client has submitted and returns how many. Worker thread only.
+    int processPending() noexcept
+    {
+        int numProcessed = 0;
+
+        while (! broken)
+        {
+            const auto submitted = header->submitted.blocks.load(std::memory_order_acquire);
+
+            // A client can only get numSlots ahead; anything else is a corrupt counter
+            if (submitted > numCompleted + static_cast<juce::uint64>(numSlots))
+            {
+                // Only the control thread closes streams, so hang up on the
+                // client instead: the control thread sees the hangup and
+                // closes this stream the same way as if the client had left
+                broken = true;
+                shutdown(socketFd, SHUT_RDWR);
+                break;
+            }
+
+            while (numCompleted < submitted)
+            {
+                applyChanges(getChanges(*header, numSlots, numCompleted));
+
+                float* channels[numChannels];
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    channels[channel] = getChannel(*header, blockSize, numSlots, numCompleted, channel);
+
+                juce::AudioBuffer<float> buffer(channels, numChannels, blockSize);
+                processor->processBlock(buffer, midi);
+                midi.clear();
+
+                header->completed.blocks.store(++numCompleted, std::memory_order_seq_cst);
+                ++numProcessed;
+
+                if (header->completed.waiting.exchange(0, std::memory_order_seq_cst) != 0)
+                    wake(completeEvent);
+            }
+
+            // Announce the sleep, then look again: the client either sees the
+            // flag and signals, or submitted before it and this catches it
+            header->submitted.waiting.store(1, std::memory_order_seq_cst);
+
+            if (header->submitted.blocks.load(std::memory_order_seq_cst) == numCompleted)
+                break;
+        }
+
+        return numProcessed;
+    }
+
+    const juce::uint32 id;
+    int socketFd;
+    int memoryFd = -1, submitEvent = -1, completeEvent = -1;
+
+    StreamHeader* header = nullptr;
+    size_t sharedBytes = 0;
+    int blockSize = 0, numSlots = 0;
+
+    std::unique_ptr<ImaginationAudioProcessor> processor;
+    Worker* worker = nullptr;
+
+private:
+    // The client writes these, so neither the count nor the values are trusted
+    void applyChanges (const SlotChanges& changes)
+    {
+        const auto numChanges = juce::jmin(changes.numChanges, static_cast<juce::uint32>(maxChangesPerBlock));
+
+        for (juce::uint32 i = 0; i < numChanges; ++i)
+        {
+            const auto& change = changes.changes[i];
+
+            if (! std::isfinite(change.normalisedValue))
+                continue;
+
+            const juce::String parameterId(change.parameterId, strnlen(change.parameterId, maxParameterIdLength));
+
+            if (auto* parameter = processor->apvts.getParameter(parameterId))
+                parameter->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, change.normalisedValue));
+        }
+    }
+
+    juce::uint64 numCompleted = 0;
+    bool broken = false;
+    juce::MidiBuffer midi;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Stream)
+};
+
+//==============================================================================
+class RenderServer::Worker  : public juce::Thread
+{
+public:
+    explicit Worker (int index)
+        : juce::Thread("Imagination render " + juce::String(index))
+    {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.u64 = 0;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeEvent, &event);
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        wake(wakeEvent);
+        stopThread(2000);
+
+        closeIfOpen(epollFd);
+        closeIfOpen(wakeEvent);
+    }
+
+    void addStream (Stream& stream)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            streams.set(static_cast<int>(stream.id), &stream);
+        }
+
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.u64 = stream.id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, stream.submitEvent, &event);
+    }
+
+    // Returns once the stream is no longer being processed
+    void removeStream (Stream& stream)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, stream.submitEvent, nullptr);
+
+        const juce::ScopedLock sl(lock);
+        streams.remove(static_cast<int>(stream.id));
+    }
+
+    int getNumStreams() const
+    {
+        const juce::ScopedLock sl(lock);
+        return streams.size();
+    }
+
+    juce::uint64 getNumBlocksProcessed() const noexcept { return numBlocksProcessed.load(std::memory_order_relaxed); }
+
+    void run() override
+    {
+        epoll_event events[64];
+
+        while (! threadShouldExit())
+        {
+            const int numEvents = epoll_wait(epollFd, events, 64, -1);
+
+            // Events for streams closed since are simply not found; ids are never reused
+            const juce::ScopedLock sl(lock);
+
+            for (int i = 0; i < numEvents; ++i)
+            {
+                if (events[i].data.u64 == 0)
+                {
+                    drain(wakeEvent);
+                    continue;
+                }
+
+                if (auto* stream = streams[static_cast<int>(events[i].data.u64)])
+                {
+                    drain(stream->submitEvent);
+                    numBlocksProcessed.fetch_add(static_cast<juce::uint64>(stream->processPending()), std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+private:
+    int epollFd = -1;
+    int wakeEvent = -1;
+
+    juce::CriticalSection lock;
+    juce::HashMap<int, Stream*> streams;
+    std::atomic<juce::uint64> numBlocksProcessed { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+class RenderServer::ControlThread  : public juce::Thread
+{
+public:
+    explicit ControlThread (RenderServer& s)
+        : juce::Thread("Imagination render control"), server(s)
+    {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        watch(server.listenFd, listenId);
+        watch(wakeEvent, wakeId);
+    }
+
+    ~ControlThread() override
+    {
+        stop();
+
+        handshakes.clear();
+        closeIfOpen(epollFd);
+        closeIfOpen(wakeEvent);
+    }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        wake(wakeEvent);
+        stopThread(5000);
+    }
+
+    void watch (int fd, juce::uint64 id)
+    {
+        epoll_event event {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    void unwatch (int fd)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    void run() override
+    {
+        epoll_event events[64];
+
+        while (! threadShouldExit())
+        {
+            // Only wakes up by itself while there are handshakes to time out
+            const int numEvents = epoll_wait(epollFd, events, 64, handshakes.isEmpty() ? -1 : handshakeTimeoutMs / 4);
+
+            for (int i = 0; i < numEvents && ! threadShouldExit(); ++i)
+            {
+                const auto id = events[i].data.u64;
+
+                if (id == wakeId)
+                {
+                    drain(wakeEvent);
+                }
+                else if (id == listenId)
+                {
+                    const int fd = accept4(server.listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+                    if (fd >= 0)
+                    {
+                        auto* handshake = handshakes.add(new Handshake(fd));
+                        watch(handshake->socketFd, handshakeFlag | static_cast<juce::uint64>(fd));
+                    }
+                }
+                else if ((id & handshakeFlag) != 0)
+                {
+                    if (auto* handshake = findHandshake(static_cast<int>(id & ~handshakeFlag)))
+                        continueHandshake(*handshake);
+                }
+                else if (auto* stream = findStream(static_cast<juce::uint32>(id)))
+                {
+                    // Hung up, or sent something, which no client does once its stream is open
+                    server.closeStream(stream);
+                }
+            }
+
+            dropStalledHandshakes();
+        }
+    }
+
+private:
+    static constexpr int handshakeTimeoutMs = 2000;
+    static constexpr juce::uint64 listenId = 0;
+    static constexpr juce::uint64 wakeId = ~static_cast<juce::uint64>(0);
+    static constexpr juce::uint64 handshakeFlag = static_cast<juce::uint64>(1) << 62;   // stream ids are 32 bits
+
+    // An accepted connection whose OpenRequest and preset are still arriving
+    struct Handshake
+    {
+        explicit Handshake (int fd)
+            : socketFd(fd), startedMs(juce::Time::getMillisecondCounter())
+        {
+        }
+
+        ~Handshake()
+        {
+            closeIfOpen(socketFd);
+        }
+
+        bool isComplete() const noexcept
+        {
+            return requestBytes == sizeof(request) && presetBytes == preset.getSize();
+        }
+
+        // Reads whatever has arrived. False if the client hung up or the
+        // request is no good; true if it is complete or just has more to come.
+        bool receive()
+        {
+            while (! isComplete())
+            {
+                const bool inRequest = requestBytes < sizeof(request);
+                auto* destination = inRequest ? reinterpret_cast<char*>(&request) + requestBytes
+                                              : static_cast<char*>(preset.getData()) + presetBytes;
+                const auto remaining = inRequest ? sizeof(request) - requestBytes
+                                                 : preset.getSize() - presetBytes;
+
+                const auto received = recv(socketFd, destination, remaining, 0);
+
+                if (received < 0 && errno == EINTR)
+                    continue;
+
+                if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    return true;
+
+                if (received <= 0)
+                    return false;
+
+                if (! inRequest)
+                {
+                    presetBytes += static_cast<size_t>(received);
+                    continue;
+                }
+
+                requestBytes += static_cast<size_t>(received);
+
+                // Validated before the preset's size is trusted
+                if (requestBytes == sizeof(request))
+                {
+                    if (! isValidRequest(request))
+                        return false;
+
+                    preset.setSize(request.presetBytes);
+                }
+            }
+
+            return true;
+        }
+
+        int socketFd;
+        const juce::uint32 startedMs;
+        OpenRequest request;
+        size_t requestBytes = 0;
+        juce::MemoryBlock preset;
+        size_t presetBytes = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Handshake)
+    };
+
+    Stream* findStream (juce::uint32 id) const
+    {
+        for (auto* stream : server.streams)
+            if (stream->id == id)
+                return stream;
+
+        return nullptr;
+    }
+
+    Handshake* findHandshake (int fd) const
+    {
+        for (auto* handshake : handshakes)
+            if (handshake->socketFd == fd)
+                return handshake;
+
+        return nullptr;
+    }
+
+    void continueHandshake (Handshake& handshake)
+    {
+        if (! handshake.receive())
+        {
+            dropHandshake(handshake);
+            return;
+        }
+
+        if (! handshake.isComplete())
+            return;
+
+        unwatch(handshake.socketFd);
+
+        // The stream owns the socket from here on
+        const int fd = std::exchange(handshake.socketFd, -1);
+        const auto request = handshake.request;
+        const auto preset = std::move(handshake.preset);
+        handshakes.removeObject(&handshake);
+
+        if (auto* stream = server.openStream(fd, request, preset))
+            watch(stream->socketFd, stream->id);
+    }
+
+    void dropHandshake (Handshake& handshake)
+    {
+        unwatch(handshake.socketFd);
+
+        // Nobody may be listening; the reply just saves a client that is a
+        // moment to read it
+        OpenReply reply;
+        reply.status = statusBadRequest;
+        sendReply(handshake.socketFd, reply, nullptr, 0);
+
+        handshakes.removeObject(&handshake);
+    }
+
+    void dropStalledHandshakes()
+    {
+        const auto now = juce::Time::getMillisecondCounter();
+
+        for (int i = handshakes.size(); --i >= 0;)
+            if (now - handshakes[i]->startedMs > static_cast<juce::uint32>(handshakeTimeoutMs))
+                dropHandshake(*handshakes[i]);
+    }
+
+    RenderServer& server;
+    int epollFd = -1;
+    int wakeEvent = -1;
+    juce::OwnedArray<Handshake> handshakes;   // few at a time, so searched linearly
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ControlThread)
+};
+#else
+// Never instantiated; start() refuses on other platforms
+class RenderServer::Stream {};
+class RenderServer::Worker {};
+class RenderServer::ControlThread {};
+#endif
+
+//==============================================================================
+RenderServer::RenderServer (const Options& o)
+    : options(o)
+{
+}
+
+RenderServer::~RenderServer()
+{
+    stop();
+}
+
+bool RenderServer::start (juce::String& error)
+{
+   #if IMAGINATION_RENDER_SERVER
+    stop();
+
+    socketPath = options.socketPath.isNotEmpty() ? options.socketPath : juce::String(getDefaultSocketPath());
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+
+    if (static_cast<size_t>(socketPath.getNumBytesAsUTF8()) >= sizeof(address.sun_path))
+    {
+        error = "socket path too long: " + socketPath;
+        return false;
+    }
+
+    socketPath.copyToUTF8(address.sun_path, sizeof(address.sun_path));
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (listenFd < 0)
+    {
+        error = "could not create a socket";
+        return false;
+    }
+
+    // A socket left behind by a daemon that died refuses connections and can
+    // go; one that answers belongs to a daemon that is still running
+    if (connect(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0)
+    {
+        error = "a daemon is already listening on " + socketPath;
+        closeIfOpen(listenFd);
+        return false;
+    }
+
+    closeIfOpen(listenFd);
+    unlink(address.sun_path);
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (listenFd < 0
+         || bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+         || listen(listenFd, SOMAXCONN) != 0)
+    {
+        error = "could not listen on " + socketPath + ": " + juce::String(std::strerror(errno));
+        closeIfOpen(listenFd);
+        return false;
+    }
+
+    {
+        const juce::MessageManagerLock mml;
+
+        for (int i = 0; i < options.poolSize; ++i)
+            pool.push_back(std::make_unique<ImaginationAudioProcessor>());
+
+        // What a stream opened without a preset starts from, including on a recycled processor
+        defaultState = pool.empty() ? ImaginationAudioProcessor().apvts.copyState()
+                                    : pool.back()->apvts.copyState();
+    }
+
+    const int numWorkers = options.numWorkers > 0 ? options.numWorkers : juce::SystemStats::getNumCpus();
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add(new Worker(i + 1))->startThread();
+
+    controlThread = std::make_unique<ControlThread>(*this);
+    controlThread->startThread();
+    return true;
+   #else
+    error = "the render daemon needs Linux";
+    return false;
+   #endif
+}
+
+void RenderServer::stop()
+{
+   #if IMAGINATION_RENDER_SERVER
+    // Joined before the pointer is cleared: closeStream, which the thread
+    // may still be in, reads it
+    if (controlThread != nullptr)
+        controlThread->stop();
+
+    controlThread.reset();
+
+    while (! streams.isEmpty())
+        closeStream(streams.getLast());
+
+    workers.clear();
+
+    if (listenFd >= 0)
+    {
+        closeIfOpen(listenFd);
+        unlink(socketPath.toRawUTF8());
+    }
+
+    const juce::MessageManagerLock mml;
+    pool.clear();
+   #endif
+}
+
+juce::uint64 RenderServer::getNumBlocksProcessed() const noexcept
+{
+    juce::uint64 total = 0;
+
+   #if IMAGINATION_RENDER_SERVER
+    for (auto* worker : workers)
+        total += worker->getNumBlocksProcessed();
+   #endif
+
+    return total;
+}
+
+RenderServer::Stream* RenderServer::openStream (int socketFd, const OpenRequest& request, const juce::MemoryBlock& preset)
+{
+   #if IMAGINATION_RENDER_SERVER
+    jassert (isValidRequest(request) && preset.getSize() == request.presetBytes);
+
+    // The stream owns the socket from here on, and closes it if anything fails
+    auto stream = std::make_unique<Stream>(nextStreamId++, socketFd);
+    OpenReply reply;
+
+    auto refuse = [&reply, socketFd](Status status) -> Stream*
+    {
+        reply.status = status;
+        sendReply(socketFd, reply, nullptr, 0);
+        return nullptr;
+    };
+
+    auto state = defaultState;
+
+    if (preset.getSize() > 0)
+    {
+        // Presets store the parameter state as XML, the same tree the plugin saves
+        const auto xml = juce::parseXMLIfTagMatches(preset.toString(), "ImaginationPreset");
+        const auto* parameters = xml != nullptr ? xml->getFirstChildElement() : nullptr;
+
+        if (parameters == nullptr)
+            return refuse(statusBadPreset);
+
+        state = juce::ValueTree::fromXml(*parameters);
+    }
+
+    if (streams.size() >= options.maxStreams || ! stream->allocate(request.blockSize, request.numSlots))
+        return refuse(statusNoResources);
+
+    {
+        // Gives up rather than deadlocking if the server is being stopped
+        const juce::MessageManagerLock mml(juce::Thread::getCurrentThread());
+
+        if (! mml.lockWasGained())
+            return refuse(statusNoResources);
+
+        stream->processor = takeProcessor();
+        stream->processor->apvts.replaceState(state.createCopy());
+    }
+
+    auto& processor = *stream->processor;
+    processor.setNonRealtime(request.highQuality != 0);
+    processor.setPlayConfigDetails(numChannels, numChannels, request.sampleRate, request.blockSize);
+    processor.prepareToPlay(request.sampleRate, request.blockSize);
+
+    Worker* leastLoaded = workers.getFirst();
+
+    for (auto* worker : workers)
+        if (worker->getNumStreams() < leastLoaded->getNumStreams())
+            leastLoaded = worker;
+
+    stream->worker = leastLoaded;
+    leastLoaded->addStream(*stream);
+
+    reply.streamId = stream->id;
+    reply.latencySamples = processor.getLatencySamples();
+    reply.sharedBytes = static_cast<juce::uint64>(stream->sharedBytes);
+
+    const int fds[] = { stream->memoryFd, stream->submitEvent, stream->completeEvent };
+    const bool sent = sendReply(socketFd, reply, fds, 3);
+
+    // The client has its own descriptor for the memory now, and the mapping stays valid without ours
+    closeIfOpen(stream->memoryFd);
+
+    auto* opened = streams.add(stream.release());
+    numStreams.store(streams.size(), std::memory_order_relaxed);
+
+    if (! sent)
+    {
+        closeStream(opened);
+        return nullptr;
+    }
+
+    return opened;
+   #else
+    juce::ignoreUnused(socketFd, request, preset);
+    return nullptr;
+   #endif
+}
+
+void RenderServer::closeStream (Stream* stream)
+{
+   #if IMAGINATION_RENDER_SERVER
+    if (controlThread != nullptr)
+        controlThread->unwatch(stream->socketFd);
+
+    if (stream->worker != nullptr)
+        stream->worker->removeStream(*stream);
+
+    if (stream->processor != nullptr)
+    {
+        stream->processor->releaseResources();
+        returnProcessor(std::move(stream->processor));
+    }
+
+    streams.removeObject(stream);
+    numStreams.store(streams.size(), std::memory_order_relaxed);
+   #else
+    juce::ignoreUnused(stream);
+   #endif
+}
+
+std::unique_ptr<ImaginationAudioProcessor> RenderServer::takeProcessor()
+{
+    // Called with the message manager locked
+    if (pool.empty())
+        return std::make_unique<ImaginationAudioProcessor>();
+
+    auto processor = std::move(pool.back());
+    pool.pop_back();
+    return processor;
+}
+
+void RenderServer::returnProcessor (std::unique_ptr<ImaginationAudioProcessor> processor)
+{
+    const juce::MessageManagerLock mml(juce::Thread::getCurrentThread());
+
+    // Without the lock (the server is stopping) it waits in the pool for stop() to delete it
+    if (static_cast<int>(pool.size()) < options.poolSize || ! mml.lockWasGained())
+        pool.push_back(std::move(processor));
+    else
+        processor.reset();
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    RenderServer.h
+    Created: 20 Oct 2026 11:06:17pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include "RenderProtocol.h"
+
+class ImaginationAudioProcessor;
+
+//==============================================================================
+/*
+    The render daemon's engine: serves ImaginationAudioProcessor streams to
+    other local processes, following RenderProtocol.h. Linux only.
+
+    A control thread accepts connections on the Unix socket and opens
+    streams. It reads each open request as its bytes arrive, without
+    blocking, so a client that stalls mid-request holds up nobody else and
+    is dropped after two seconds. A client hanging up, writing to
+    the socket after the open, or corrupting its ring's counters, closes
+    its stream.
+    Each stream gets its own processor and is pinned to one of the worker
+    threads, which sleep in epoll on their streams' submit eventfds and run
+    processBlock directly on the shared ring, so audio is never copied.
+    The parameter changes in a slot are applied by the worker just before
+    that block.
+
+    Processors come from a pool built up front, because constructing one is
+    far slower than a block's deadline. They are created and destroyed under
+    a MessageManagerLock, so the process must run the JUCE message loop.
+*/
+class RenderServer
+{
+public:
+    struct Options
+    {
+        juce::String socketPath;   // empty for ImaginationRender::getDefaultSocketPath()
+        int numWorkers = 0;        // 0 = one per CPU core
+        int poolSize = 16;         // idle processors kept ready
+        int maxStreams = 1024;
+    };
+
+    explicit RenderServer (const Options& options);
+    ~RenderServer();
+
+    // Binds the socket and starts the threads; on failure says why
+    bool start (juce::String& error);
+    void stop();
+
+    int getNumStreams() const noexcept       { return numStreams.load(std::memory_order_relaxed); }
+    juce::uint64 getNumBlocksProcessed() const noexcept;
+
+private:
+    class Stream;
+    class Worker;
+    class ControlThread;
+
+    // Takes ownership of the socket; the request has been validated
+    Stream* openStream (int socketFd, const ImaginationRender::OpenRequest& request, const juce::MemoryBlock& preset);
+    void closeStream (Stream* stream);
+
+    std::unique_ptr<ImaginationAudioProcessor> takeProcessor();
+    void returnProcessor (std::unique_ptr<ImaginationAudioProcessor> processor);
+
+    Options options;
+    juce::String socketPath;
+    int listenFd = -1;
+
+    std::unique_ptr<ControlThread> controlThread;
+    juce::OwnedArray<Worker> workers;
+    juce::OwnedArray<Stream> streams;   // control thread only
+    std::atomic<int> numStreams { 0 };
+    juce::uint32 nextStreamId = 1;
+
+    std::vector<std::unique_ptr<ImaginationAudioProcessor>> pool;
+    juce::ValueTree defaultState;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderServer)
+};
@@ -0,0 +1,334 @@
+/*
+  ==============================================================================
+
+    SegmentRenderer.cpp
+    Created: 20 Oct 2026 11:37:15am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "SegmentRenderer.h"
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Below this a file is not worth splitting: setting up an instance and
+    // its warm-up would cost more than the segment itself
+    constexpr double minimumSegmentSeconds = 10.0;
+}
+
+//==============================================================================
+struct SegmentRenderer::Segment
+{
+    int index = 0;
+    juce::int64 start = 0, end = 0;     // output samples this segment owns
+    juce::int64 renderEnd = 0;          // end plus the verification overrun
+    int warmUpSamples = 0;
+    int attempts = 0;
+
+    std::unique_ptr<ImaginationAudioProcessor> processor;
+    std::unique_ptr<juce::TemporaryFile> output;
+
+    juce::AudioBuffer<float> head;      // first output samples, compared with the previous overrun
+    juce::AudioBuffer<float> overrun;   // output past `end`, compared with the next head
+    juce::String error;
+};
+
+class SegmentRenderer::RenderJob  : public juce::ThreadPoolJob
+{
+public:
+    RenderJob (SegmentRenderer& r, Segment& s, const ReaderFactory& factory)
+        : juce::ThreadPoolJob("Segment " + juce::String(s.index)), renderer(r), segment(s), openInput(factory)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        renderer.renderSegment(segment, openInput);
+        return jobHasFinished;
+    }
+
+private:
+    SegmentRenderer& renderer;
+    Segment& segment;
+    const ReaderFactory& openInput;
+};
+
+//==============================================================================
+SegmentRenderer::SegmentRenderer (const juce::ValueTree& state, const Options& o)
+    : parameterState(state.createCopy()), options(o)
+{
+    options.blockSize = juce::jmax(32, options.blockSize);
+    options.verificationSamples = juce::jmax(0, options.verificationSamples);
+    options.maxRetries = juce::jmax(0, options.maxRetries);
+}
+
+SegmentRenderer::~SegmentRenderer()
+{
+}
+
+//==============================================================================
+SegmentRenderer::Result SegmentRenderer::render (const ReaderFactory& openInput, juce::AudioFormatWriter& output)
+{
+    Result result;
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    juce::int64 totalSamples = 0;
+
+    if (auto reader = openInput())
+    {
+        sampleRate = reader->sampleRate;
+        totalSamples = reader->lengthInSamples;
+    }
+
+    if (sampleRate <= 0.0 || totalSamples <= 0)
+    {
+        result.error = "could not read the input";
+        return result;
+    }
+
+    // The same form getStateInformation produces; an invalid tree keeps the defaults
+    juce::MemoryBlock stateData;
+
+    if (parameterState.isValid())
+    {
+        juce::MemoryOutputStream stream(stateData, false);
+        parameterState.writeToStream(stream);
+    }
+
+    // Instances are prepared here rather than on the workers: their
+    // parameter attachments are not safe to build or tear down elsewhere
+    auto createProcessor = [this, &stateData]
+    {
+        auto processor = std::make_unique<ImaginationAudioProcessor>();
+        processor->setNonRealtime(true);
+        processor->setPlayConfigDetails(2, 2, sampleRate, options.blockSize);
+
+        if (stateData.getSize() > 0)
+            processor->setStateInformation(stateData.getData(), static_cast<int>(stateData.getSize()));
+
+        processor->prepareToPlay(sampleRate, options.blockSize);
+        return processor;
+    };
+
+    int baseWarmUpSamples = 0;
+    {
+        auto probe = createProcessor();
+        latencySamples = probe->getLatencySamples();
+        baseWarmUpSamples = static_cast<int>(std::ceil((probe->getWarmUpSeconds() + options.extraWarmUpSeconds) * sampleRate)) + latencySamples;
+        probe->releaseResources();
+    }
+
+    const int numCores = juce::SystemStats::getNumCpus();
+    const auto maxSegments = juce::jmax<juce::int64>(1, totalSamples / juce::jmax<juce::int64>(options.verificationSamples * 2,
+                                                                                                  static_cast<juce::int64>(minimumSegmentSeconds * sampleRate)));
+    const int numSegments = static_cast<int>(juce::jmin<juce::int64>(maxSegments, options.numSegments > 0 ? options.numSegments : numCores));
+
+    std::vector<Segment> segments(static_cast<size_t>(numSegments));
+
+    for (int i = 0; i < numSegments; ++i)
+    {
+        auto& segment = segments[static_cast<size_t>(i)];
+        segment.index = i;
+        segment.start = totalSamples * i / numSegments;
+        segment.end = totalSamples * (i + 1) / numSegments;
+        segment.renderEnd = (i == numSegments - 1) ? segment.end : juce::jmin(totalSamples, segment.end + options.verificationSamples);
+        segment.warmUpSamples = baseWarmUpSamples;
+    }
+
+    //==============================================================================
+    juce::ThreadPool pool(juce::jmin(numSegments, numCores));
+    std::vector<Segment*> pending;
+
+    for (auto& segment : segments)
+        pending.push_back(&segment);
+
+    result.seams.resize(static_cast<size_t>(numSegments - 1));
+
+    while (! pending.empty())
+    {
+        for (auto* segment : pending)
+        {
+            segment->processor = createProcessor();
+            segment->output = std::make_unique<juce::TemporaryFile>(".wav");
+            segment->error.clear();
+            ++segment->attempts;
+        }
+
+        for (auto* segment : pending)
+            pool.addJob(new RenderJob(*this, *segment, openInput), true);
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(5);
+
+        for (auto* segment : pending)
+        {
+            segment->processor->releaseResources();
+            segment->processor.reset();
+
+            if (segment->error.isNotEmpty())
+            {
+                result.error = segment->error;
+                return result;
+            }
+        }
+
+        // A seam that does not match means the right-hand instance had not
+        // caught up with the serial state yet; give it twice the warm-up
+        pending.clear();
+
+        for (int i = 1; i < numSegments; ++i)
+        {
+            auto& left = segments[static_cast<size_t>(i - 1)];
+            auto& right = segments[static_cast<size_t>(i)];
+            auto& seam = result.seams[static_cast<size_t>(i - 1)];
+
+            seam.position = right.start;
+            seam.maxError = measureSeam(left, right);
+            seam.warmUpSamples = right.warmUpSamples;
+            seam.passed = seam.maxError <= options.seamTolerance;
+
+            if (! seam.passed && right.attempts <= options.maxRetries && right.start - right.warmUpSamples > 0)
+            {
+                right.warmUpSamples *= 2;
+                pending.push_back(&right);
+            }
+        }
+    }
+
+    result.seamsVerified = std::all_of(result.seams.begin(), result.seams.end(), [](const Seam& s) { return s.passed; });
+
+    //==============================================================================
+    // Stitch the segments, in order, into the real output
+    juce::WavAudioFormat wav;
+    juce::AudioBuffer<float> buffer(2, options.blockSize);
+
+    for (auto& segment : segments)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(segment.output->getFile().createInputStream().release(), true));
+
+        if (reader == nullptr)
+        {
+            result.error = "could not read back segment " + juce::String(segment.index);
+            return result;
+        }
+
+        for (juce::int64 position = 0; position < reader->lengthInSamples; position += options.blockSize)
+        {
+            const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(options.blockSize, reader->lengthInSamples - position));
+            reader->read(&buffer, 0, numSamples, position, true, true);
+
+            if (! output.writeFromAudioSampleBuffer(buffer, 0, numSamples))
+            {
+                result.error = "could not write the output";
+                return result;
+            }
+        }
+
+        reader.reset();
+        segment.output.reset();
+    }
+
+    result.succeeded = true;
+    result.elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return result;
+}
+
+//==============================================================================
+void SegmentRenderer::renderSegment (Segment& segment, const ReaderFactory& openInput)
+{
+    auto reader = openInput();
+
+    if (reader == nullptr)
+    {
+        segment.error = "could not open the input for segment " + juce::String(segment.index);
+        return;
+    }
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(segment.output->getFile().createOutputStream().release(),
+                                                                        sampleRate, 2, 32, {}, 0));
+
+    if (writer == nullptr)
+    {
+        segment.error = "could not create a temporary file for segment " + juce::String(segment.index);
+        return;
+    }
+
+    const int verificationLength = static_cast<int>(juce::jmin<juce::int64>(options.verificationSamples, segment.end - segment.start));
+    segment.head.setSize(2, verificationLength);
+    segment.overrun.setSize(2, static_cast<int>(segment.renderEnd - segment.end));
+
+    // Output sample n comes out of the processor `latency` samples after
+    // input sample n went in, so the input runs that much further than the
+    // output. Reads past the end of the file return silence, the same tail a
+    // serial render would flush through.
+    const auto feedStart = juce::jmax<juce::int64>(0, segment.start - segment.warmUpSamples);
+    const auto feedEnd = segment.renderEnd + latencySamples;
+
+    juce::AudioBuffer<float> buffer(2, options.blockSize);
+    juce::MidiBuffer midi;
+
+    for (auto position = feedStart; position < feedEnd; position += options.blockSize)
+    {
+        const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(options.blockSize, feedEnd - position));
+        buffer.setSize(2, numSamples, false, false, true);
+        reader->read(&buffer, 0, numSamples, position, true, true);
+
+        segment.processor->processBlock(buffer, midi);
+
+        // The part of this block that lands inside [start, renderEnd)
+        const auto blockOutputStart = position - latencySamples;
+        const auto from = juce::jmax(blockOutputStart, segment.start);
+        const auto to = juce::jmin(blockOutputStart + numSamples, segment.renderEnd);
+
+        if (from >= to)
+            continue;
+
+        const auto offset = static_cast<int>(from - blockOutputStart);
+
+        auto copyRange = [&](juce::AudioBuffer<float>& destination, juce::int64 destinationStart, juce::int64 rangeEnd)
+        {
+            const auto copyFrom = juce::jmax(from, destinationStart);
+            const auto copyTo = juce::jmin(to, rangeEnd);
+
+            for (int channel = 0; copyTo > copyFrom && channel < 2; ++channel)
+                destination.copyFrom(channel, static_cast<int>(copyFrom - destinationStart),
+                                     buffer, channel, static_cast<int>(copyFrom - blockOutputStart), static_cast<int>(copyTo - copyFrom));
+        };
+
+        copyRange(segment.head, segment.start, segment.start + verificationLength);
+        copyRange(segment.overrun, segment.end, segment.renderEnd);
+
+        const auto ownedEnd = juce::jmin(to, segment.end);
+
+        if (ownedEnd > from && ! writer->writeFromAudioSampleBuffer(buffer, offset, static_cast<int>(ownedEnd - from)))
+        {
+            segment.error = "could not write segment " + juce::String(segment.index);
+            return;
+        }
+    }
+}
+
+float SegmentRenderer::measureSeam (const Segment& left, const Segment& right) const
+{
+    // The left instance's overrun is what a serial render produces after the
+    // seam; the right instance's head should match it
+    const int numSamples = juce::jmin(left.overrun.getNumSamples(), right.head.getNumSamples());
+    float maxError = 0.0f;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const auto* a = left.overrun.getReadPointer(channel);
+        const auto* b = right.head.getReadPointer(channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            maxError = juce::jmax(maxError, std::abs(a[i] - b[i]));
+    }
+
+    return maxError;
+}
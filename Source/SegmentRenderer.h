@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    SegmentRenderer.h
+    Created: 20 Oct 2026 11:37:15am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/*
+    Offline render of one long file split into segments, each processed on
+    its own ImaginationAudioProcessor instance in parallel.
+
+    Every segment instance is prepared non-realtime (so with the high-quality
+    configuration) and first runs over the audio just before its segment,
+    long enough for the processor's warm-up time, so its filters and
+    smoothing arrive at the segment start in the state a serial render would
+    have. Output is latency-compensated: sample n of the result lines up with
+    sample n of the input.
+
+    Seams are checked automatically. Every segment but the last keeps
+    rendering a little way past its end; that overrun is the serial
+    continuation and is compared with the start of the next segment. A seam
+    over the tolerance has its right-hand segment re-rendered with twice the
+    warm-up, up to maxRetries times.
+
+    Processor instances are created and destroyed on the calling thread;
+    only processBlock runs on the worker threads.
+*/
+class SegmentRenderer
+{
+public:
+    struct Options
+    {
+        int numSegments = 0;              // 0 = one per CPU core
+        double extraWarmUpSeconds = 0.0;  // on top of what the processor asks for
+        int blockSize = 512;
+        float seamTolerance = 1.0e-5f;    // max absolute difference, about -100 dBFS
+        int verificationSamples = 4096;
+        int maxRetries = 2;
+    };
+
+    struct Seam
+    {
+        juce::int64 position = 0;
+        float maxError = 0.0f;
+        int warmUpSamples = 0;
+        bool passed = false;
+    };
+
+    struct Result
+    {
+        bool succeeded = false;
+        bool seamsVerified = false;
+        std::vector<Seam> seams;
+        double elapsedSeconds = 0.0;
+        juce::String error;
+    };
+
+    // Each segment opens its own reader, since readers are not thread-safe
+    using ReaderFactory = std::function<std::unique_ptr<juce::AudioFormatReader>()>;
+
+    SegmentRenderer (const juce::ValueTree& parameterState, const Options& options);
+    ~SegmentRenderer();
+
+    Result render (const ReaderFactory& openInput, juce::AudioFormatWriter& output);
+
+private:
+    struct Segment;
+    class RenderJob;
+
+    void renderSegment (Segment&, const ReaderFactory& openInput);
+    float measureSeam (const Segment& left, const Segment& right) const;
+
+    juce::ValueTree parameterState;
+    Options options;
+    double sampleRate = 0.0;
+    int latencySamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SegmentRenderer)
+};
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SharedEditorResources.cpp
+    Created: 19 Oct 2026 11:02:47am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "SharedEditorResources.h"
+#include "BinaryData.h"
+
+//==============================================================================
+SharedEditorResources::SharedEditorResources()
+{
+}
+
+SharedEditorResources::~SharedEditorResources()
+{
+    imageCache.clear();
+}
+
+juce::Typeface::Ptr SharedEditorResources::getHelveticaBold()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (helveticaBold == nullptr)
+        helveticaBold = juce::Typeface::createSystemTypefaceFor(BinaryData::HelveticaBold_woff, BinaryData::HelveticaBold_woffSize);
+
+    return helveticaBold;
+}
+
+juce::Font SharedEditorResources::getLabelFont()
+{
+    return juce::Font(getHelveticaBold());
+}
+
+CustomLookAndFeel& SharedEditorResources::getRotaryLookAndFeel()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (rotaryLookAndFeel == nullptr)
+        rotaryLookAndFeel = std::make_unique<CustomLookAndFeel>();
+
+    return *rotaryLookAndFeel;
+}
+
+CustomLookAndFeelVerticalSlider& SharedEditorResources::getVerticalSliderLookAndFeel()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (verticalSliderLookAndFeel == nullptr)
+        verticalSliderLookAndFeel = std::make_unique<CustomLookAndFeelVerticalSlider>();
+
+    return *verticalSliderLookAndFeel;
+}
+
+juce::Image SharedEditorResources::getCachedImage (const juce::String& name, int width, int height, float scale,
+                                                   const std::function<void (juce::Graphics&)>& painter)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto key = name + "_" + juce::String(width) + "x" + juce::String(height) + "@" + juce::String(scale, 2);
+
+    if (imageCache.contains(key))
+        return imageCache[key];
+
+    // Editors only ever show a handful of sizes, so rather than tracking usage
+    // just start over once the cache grows past that.
+    if (imageCache.size() >= maxCachedImages)
+        imageCache.clear();
+
+    juce::Image image(juce::Image::ARGB,
+                      juce::jmax(1, juce::roundToInt(width * scale)),
+                      juce::jmax(1, juce::roundToInt(height * scale)),
+                      true);
+    {
+        juce::Graphics g(image);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        painter(g);
+    }
+
+    imageCache.set(key, image);
+    return image;
+}
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    SharedEditorResources.h
+    Created: 19 Oct 2026 11:02:47am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "CustomLookAndFeel.h"
+#include "CustomLookAndFeelVerticalSlider.h"
+
+//==============================================================================
+/*
+    Process-wide GUI resources shared by every editor instance.
+
+    Hold one through juce::SharedResourcePointer<SharedEditorResources>; the
+    object is created by the first editor that asks for it and destroyed with
+    the last one. Everything inside is built lazily on first use and must
+    only be touched from the message thread.
+*/
+class SharedEditorResources
+{
+public:
+    SharedEditorResources();
+    ~SharedEditorResources();
+
+    juce::Typeface::Ptr getHelveticaBold();
+    juce::Font getLabelFont();
+
+    CustomLookAndFeel& getRotaryLookAndFeel();
+    CustomLookAndFeelVerticalSlider& getVerticalSliderLookAndFeel();
+
+    // Returns an image of width x height logical pixels rendered at the given
+    // display scale, calling the painter only if no matching image is cached yet.
+    juce::Image getCachedImage (const juce::String& name, int width, int height, float scale,
+                                const std::function<void (juce::Graphics&)>& painter);
+
+private:
+    juce::Typeface::Ptr helveticaBold;
+    std::unique_ptr<CustomLookAndFeel> rotaryLookAndFeel;
+    std::unique_ptr<CustomLookAndFeelVerticalSlider> verticalSliderLookAndFeel;
+
+    juce::HashMap<juce::String, juce::Image> imageCache;
+    static constexpr int maxCachedImages = 16;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedEditorResources)
+};
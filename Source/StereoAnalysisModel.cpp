@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    StereoAnalysisModel.cpp
+    Created: 19 Oct 2026 1:40:15pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "StereoAnalysisModel.h"
+
+//==============================================================================
+StereoAnalysisModel::StereoAnalysisModel (int capacityInSamples)
+    : fifo(capacityInSamples), storage(2, capacityInSamples)
+{
+    storage.clear();
+}
+
+StereoAnalysisModel::~StereoAnalysisModel()
+{
+}
+
+void StereoAnalysisModel::pushSamples (const float* left, const float* right, int numSamples) noexcept
+{
+    if (! isConsumerActive() || numSamples <= 0)
+        return;
+
+    // If the editor falls behind we drop the newest block rather than block the audio thread
+    if (fifo.getFreeSpace() < numSamples)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    if (size1 > 0)
+    {
+        storage.copyFrom(0, start1, left, size1);
+        storage.copyFrom(1, start1, right, size1);
+    }
+
+    if (size2 > 0)
+    {
+        storage.copyFrom(0, start2, left + size1, size2);
+        storage.copyFrom(1, start2, right + size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+void StereoAnalysisModel::setConsumerActive (bool shouldBeActive) noexcept
+{
+    consumerActive.store(shouldBeActive, std::memory_order_relaxed);
+}
+
+int StereoAnalysisModel::pullLatest (std::vector<float>& left, std::vector<float>& right, int maxSamples)
+{
+    const int numReady = fifo.getNumReady();
+
+    if (numReady <= 0)
+        return 0;
+
+    // Skip anything older than the window we were asked for
+    const int numToSkip = juce::jmax(0, numReady - maxSamples);
+    fifo.finishedRead(numToSkip);
+
+    const int numToRead = numReady - numToSkip;
+    left.resize(static_cast<size_t>(numToRead));
+    right.resize(static_cast<size_t>(numToRead));
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numToRead, start1, size1, start2, size2);
+
+    if (size1 > 0)
+    {
+        std::copy(storage.getReadPointer(0, start1), storage.getReadPointer(0, start1) + size1, left.begin());
+        std::copy(storage.getReadPointer(1, start1), storage.getReadPointer(1, start1) + size1, right.begin());
+    }
+
+    if (size2 > 0)
+    {
+        std::copy(storage.getReadPointer(0, start2), storage.getReadPointer(0, start2) + size2, left.begin() + size1);
+        std::copy(storage.getReadPointer(1, start2), storage.getReadPointer(1, start2) + size2, right.begin() + size1);
+    }
+
+    fifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
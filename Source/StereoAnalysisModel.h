@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    StereoAnalysisModel.h
+    Created: 19 Oct 2026 1:40:15pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/*
+    The only analysis state the processor owns: a single-producer,
+    single-consumer FIFO of processed stereo samples.
+
+    The audio thread pushes into it without locking or allocating, and only
+    while an editor has registered itself as a consumer, so headless
+    instances pay nothing beyond a flag check. All storage is allocated in
+    the constructor, which is safe to run on any thread.
+*/
+class StereoAnalysisModel
+{
+public:
+    explicit StereoAnalysisModel (int capacityInSamples = 32768);
+    ~StereoAnalysisModel();
+
+    // Audio thread
+    void pushSamples (const float* left, const float* right, int numSamples) noexcept;
+
+    // Any thread
+    void setSampleRate (double newSampleRate) noexcept { sampleRate.store(newSampleRate, std::memory_order_relaxed); }
+    double getSampleRate() const noexcept              { return sampleRate.load(std::memory_order_relaxed); }
+    int getCapacity() const noexcept                   { return fifo.getTotalSize(); }
+
+    // Set by the processor under CPU pressure: consumers should still take
+    // every sample, but may run their display work less often
+    void setReducedRate (bool shouldReduce) noexcept   { reducedRate.store(shouldReduce, std::memory_order_relaxed); }
+    bool isReducedRate() const noexcept                { return reducedRate.load(std::memory_order_relaxed); }
+
+    // Consumer side
+    void setConsumerActive (bool shouldBeActive) noexcept;
+    bool isConsumerActive() const noexcept { return consumerActive.load(std::memory_order_relaxed); }
+
+    // Drains everything pushed since the last call and returns up to maxSamples
+    // of the newest audio. Returns the number of samples copied; the vectors
+    // are left untouched when nothing new has arrived.
+    int pullLatest (std::vector<float>& left, std::vector<float>& right, int maxSamples);
+
+private:
+    juce::AbstractFifo fifo;
+    juce::AudioBuffer<float> storage;
+    std::atomic<bool> consumerActive { false };
+    std::atomic<bool> reducedRate { false };
+    std::atomic<double> sampleRate { 44100.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoAnalysisModel)
+};
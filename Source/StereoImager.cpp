@@ -0,0 +1,457 @@
+/*
+  ==============================================================================
+
+    StereoImager.cpp
+    Created: 19 Oct 2026 10:12:04am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "StereoImager.h"
+
+//==============================================================================
+StereoImager::StereoImager()
+{
+    updateMatrix();
+}
+
+StereoImager::~StereoImager()
+{
+}
+
+float StereoImager::widthFactorFor (float widthPercent)
+{
+    return (widthPercent >= 50.0f) ? 1.0f + (widthPercent - 50.0f) * 0.02f : widthPercent * 0.02f;
+}
+
+StereoImagerSettings StereoImager::makeSettings (float widthPercent, float balance, float midSide,
+                                                 float crossfeed, float exciterPercent)
+{
+    StereoImagerSettings s;
+    s.widthFactor = widthFactorFor (widthPercent);
+    s.balance = balance;
+    s.midSide = midSide;
+    s.crossfeed = crossfeed;
+    s.exciterAmount = exciterPercent * 0.01f;
+    return s;
+}
+
+void StereoImager::prepare (double sampleRate, double exciterSampleRate, float* transientWeightStorage, int maximumBlockSize,
+                            double smoothingSeconds, bool useDoublePrecision)
+{
+    widthFactor.reset(sampleRate, smoothingSeconds);
+    balance.reset(sampleRate, smoothingSeconds);
+    midSide.reset(sampleRate, smoothingSeconds);
+    crossfeed.reset(sampleRate, smoothingSeconds);
+    exciterAmount.reset(exciterSampleRate, smoothingSeconds);
+    transientWidthFactor.reset(sampleRate, smoothingSeconds);
+    transientExciterAmount.reset(exciterSampleRate, smoothingSeconds);
+    widthGuard.prepare(sampleRate);
+    transientSplitter.prepare(sampleRate);
+    transientWeights = transientWeightStorage;
+    transientWeightCapacity = transientWeightStorage != nullptr ? maximumBlockSize : 0;
+    numTransientWeights = 0;
+    exciterOversampling = juce::jmax(1, juce::roundToInt(exciterSampleRate / sampleRate));
+    doublePrecision = useDoublePrecision;
+}
+
+void StereoImager::reset()
+{
+    widthFactor.setCurrentAndTargetValue(widthFactor.getTargetValue());
+    balance.setCurrentAndTargetValue(balance.getTargetValue());
+    midSide.setCurrentAndTargetValue(midSide.getTargetValue());
+    crossfeed.setCurrentAndTargetValue(crossfeed.getTargetValue());
+    exciterAmount.setCurrentAndTargetValue(exciterAmount.getTargetValue());
+    transientWidthFactor.setCurrentAndTargetValue(transientWidthFactor.getTargetValue());
+    transientExciterAmount.setCurrentAndTargetValue(transientExciterAmount.getTargetValue());
+    widthGuard.reset();
+    transientSplitter.reset();
+}
+
+void StereoImager::setSettings (const StereoImagerSettings& newSettings)
+{
+    const bool matrixChanged = newSettings.balance != balance.getTargetValue()
+                                || newSettings.midSide != midSide.getTargetValue()
+                                || newSettings.crossfeed != crossfeed.getTargetValue();
+
+    widthFactor.setTargetValue(newSettings.widthFactor);
+    balance.setTargetValue(newSettings.balance);
+    midSide.setTargetValue(newSettings.midSide);
+    crossfeed.setTargetValue(newSettings.crossfeed);
+
+    if (matrixChanged)
+        updateMatrix();
+    exciterAmount.setTargetValue(newSettings.exciterAmount);
+
+    // Start from a clean slate each time the guard is switched on
+    if (newSettings.widthGuard && ! widthGuardEnabled)
+        widthGuard.reset();
+
+    widthGuardEnabled = newSettings.widthGuard;
+
+    if (newSettings.widthGuardThreshold != widthGuardThreshold)
+    {
+        widthGuardThreshold = newSettings.widthGuardThreshold;
+        widthGuard.setThreshold(widthGuardThreshold);
+    }
+
+    // The transient settings only advance while the split runs, so they
+    // start from their targets when it is switched on
+    if (newSettings.transientSplit && ! transientSplitEnabled)
+    {
+        transientSplitter.reset();
+        transientWidthFactor.setCurrentAndTargetValue(newSettings.transientWidthFactor);
+        transientExciterAmount.setCurrentAndTargetValue(newSettings.transientExciterAmount);
+    }
+    else
+    {
+        transientWidthFactor.setTargetValue(newSettings.transientWidthFactor);
+        transientExciterAmount.setTargetValue(newSettings.transientExciterAmount);
+    }
+
+    transientSplitEnabled = newSettings.transientSplit;
+}
+
+StereoImagerSettings StereoImager::getTargetSettings() const
+{
+    StereoImagerSettings s;
+    s.widthFactor = widthFactor.getTargetValue();
+    s.balance = balance.getTargetValue();
+    s.midSide = midSide.getTargetValue();
+    s.crossfeed = crossfeed.getTargetValue();
+    s.exciterAmount = exciterAmount.getTargetValue();
+    s.widthGuard = widthGuardEnabled;
+    s.widthGuardThreshold = widthGuardThreshold;
+    s.transientSplit = transientSplitEnabled;
+    s.transientWidthFactor = transientWidthFactor.getTargetValue();
+    s.transientExciterAmount = transientExciterAmount.getTargetValue();
+    return s;
+}
+
+float StereoImager::takeWidthGuardGain() noexcept
+{
+    return widthGuardEnabled ? widthGuard.takeLowestGain() : 1.0f;
+}
+
+void StereoImager::process (const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    processStereo(context);
+    processExciter(context.getOutputBlock());
+}
+
+void StereoImager::processStereo (const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto& block = context.getOutputBlock();
+
+    if (block.getNumChannels() < 2)
+        return;
+
+    auto* left = block.getChannelPointer(0);
+    auto* right = block.getChannelPointer(1);
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+
+    // Weights are only kept for blocks that fit; longer ones are not split
+    numTransientWeights = (transientSplitEnabled && numSamples <= transientWeightCapacity) ? numSamples : 0;
+
+    if (isStereoRamping())
+    {
+        if (doublePrecision)
+            processStereoRamped<double>(left, right, numSamples);
+        else
+            processStereoRamped<float>(left, right, numSamples);
+    }
+    else if (widthGuardEnabled || numTransientWeights > 0)
+    {
+        if (doublePrecision)
+            processStereoMatrixPerSample<double>(left, right, numSamples);
+        else
+            processStereoMatrixPerSample<float>(left, right, numSamples);
+    }
+    else
+    {
+        if (doublePrecision)
+            processStereoConstant<double>(left, right, numSamples);
+        else
+            processStereoConstant<float>(left, right, numSamples);
+    }
+}
+
+bool StereoImager::isStereoRamping() const noexcept
+{
+    return widthFactor.isSmoothing() || balance.isSmoothing() || midSide.isSmoothing() || crossfeed.isSmoothing()
+            || (numTransientWeights > 0 && transientWidthFactor.isSmoothing());
+}
+
+namespace
+{
+    template <typename CalcType>
+    inline void balanceMidSideCrossfeedSample (CalcType& left, CalcType& right, CalcType balanceValue,
+                                               CalcType midSideValue, CalcType crossfeedFactor) noexcept
+    {
+        const CalcType half = static_cast<CalcType>(0.5);
+        const CalcType one = static_cast<CalcType>(1);
+
+        // Balance processing
+        if (balanceValue > 0)
+            left *= one - balanceValue;
+
+        if (balanceValue < 0)
+            right *= one + balanceValue;
+
+        // Mid/side processing
+        CalcType mid = (left + right) * half;
+        CalcType side = (left - right) * half;
+        mid += side * midSideValue;
+        side -= side * midSideValue;
+        left = mid + side;
+        right = mid - side;
+
+        // Crossfeed processing (calculated before writing back to avoid feedback)
+        const CalcType leftCrossfeed = left + crossfeedFactor * right;
+        right = right + crossfeedFactor * left;
+        left = leftCrossfeed;
+    }
+
+    template <typename CalcType, typename MatrixType>
+    inline void applyMatrix (CalcType& left, CalcType& right, const MatrixType& m) noexcept
+    {
+        const CalcType newLeft = m[0] * left + m[1] * right;
+        right = m[2] * left + m[3] * right;
+        left = newLeft;
+    }
+}
+
+namespace
+{
+    void computeMatrices (double b, double k, double c, std::array<double, 4>& fixedMatrix, std::array<double, 4>& sideMatrix)
+    {
+        // Everything after the width stage is linear with fixed coefficients, so
+        // it collapses to one 2x2 matrix P, found by running it on unit vectors.
+        // The width stage is A + g * D (A averages to mid, D keeps side), giving
+        // out = (P.A + g * P.D) . in for any side gain g.
+        double p00 = 1.0, p10 = 0.0, p01 = 0.0, p11 = 1.0;
+        balanceMidSideCrossfeedSample(p00, p10, b, k, c);
+        balanceMidSideCrossfeedSample(p01, p11, b, k, c);
+
+        fixedMatrix = { 0.5 * (p00 + p01), 0.5 * (p00 + p01),
+                        0.5 * (p10 + p11), 0.5 * (p10 + p11) };
+        sideMatrix  = { 0.5 * (p00 - p01), -0.5 * (p00 - p01),
+                        0.5 * (p10 - p11), -0.5 * (p10 - p11) };
+    }
+}
+
+void StereoImager::updateMatrix()
+{
+    computeMatrices(balance.getTargetValue(), midSide.getTargetValue(), crossfeed.getTargetValue(), fixedMatrix, sideMatrix);
+}
+
+std::array<double, 4> StereoImager::getMatrix (const StereoImagerSettings& settings)
+{
+    std::array<double, 4> fixed, side, m;
+    computeMatrices(settings.balance, settings.midSide, settings.crossfeed, fixed, side);
+
+    for (size_t i = 0; i < m.size(); ++i)
+        m[i] = fixed[i] + static_cast<double>(settings.widthFactor) * side[i];
+
+    return m;
+}
+
+template <typename CalcType>
+std::array<CalcType, 4> StereoImager::matrixForWidth (CalcType widthValue) const noexcept
+{
+    std::array<CalcType, 4> m;
+
+    for (size_t i = 0; i < m.size(); ++i)
+        m[i] = static_cast<CalcType>(fixedMatrix[i]) + widthValue * static_cast<CalcType>(sideMatrix[i]);
+
+    return m;
+}
+
+template <typename CalcType>
+CalcType StereoImager::nextWidth (CalcType left, CalcType right, int sample) noexcept
+{
+    const auto widthValue = static_cast<CalcType>(widthFactor.getNextValue());
+    const float transientWidth = numTransientWeights > 0 ? transientWidthFactor.getNextValue() : 0.0f;
+    return adjustWidth(left, right, widthValue, transientWidth, sample);
+}
+
+template <typename CalcType>
+CalcType StereoImager::adjustWidth (CalcType left, CalcType right, CalcType widthValue, float transientWidth, int sample) noexcept
+{
+    // The width stage is linear in the side gain, so widening the transient
+    // and sustain parts separately and adding them back together is the
+    // same as one side gain blended by the transient weight
+    if (numTransientWeights > 0)
+    {
+        const float weight = transientSplitter.process(static_cast<float>(left), static_cast<float>(right));
+        transientWeights[sample] = weight;
+        widthValue += static_cast<CalcType>(weight) * (static_cast<CalcType>(transientWidth) - widthValue);
+    }
+
+    if (widthGuardEnabled)
+        widthValue = widthGuard.process(left, right, widthValue);
+
+    return widthValue;
+}
+
+template <typename CalcType>
+void StereoImager::processStereoConstant (float* leftData, float* rightData, int numSamples)
+{
+    const auto m = matrixForWidth(static_cast<CalcType>(widthFactor.getTargetValue()));
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        auto left = static_cast<CalcType>(leftData[sample]);
+        auto right = static_cast<CalcType>(rightData[sample]);
+
+        applyMatrix(left, right, m);
+
+        leftData[sample] = static_cast<float>(left);
+        rightData[sample] = static_cast<float>(right);
+    }
+}
+
+template <typename CalcType>
+void StereoImager::processStereoMatrixPerSample (float* leftData, float* rightData, int numSamples)
+{
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        auto left = static_cast<CalcType>(leftData[sample]);
+        auto right = static_cast<CalcType>(rightData[sample]);
+        const auto widthValue = nextWidth(left, right, sample);
+
+        applyMatrix(left, right, matrixForWidth(widthValue));
+
+        leftData[sample] = static_cast<float>(left);
+        rightData[sample] = static_cast<float>(right);
+    }
+}
+
+template <typename CalcType>
+void StereoImager::processStereoRamped (float* leftData, float* rightData, int numSamples)
+{
+    const bool adjustsWidth = widthGuardEnabled || numTransientWeights > 0;
+    const CalcType half = static_cast<CalcType>(0.5);
+    const CalcType one = static_cast<CalcType>(1);
+
+    for (int start = 0; start < numSamples; start += rampChunkSize)
+    {
+        const int num = juce::jmin(rampChunkSize, numSamples - start);
+        auto* left = leftData + start;
+        auto* right = rightData + start;
+
+        widthFactor.fill(widthRamp, num);
+        balance.fill(balanceRamp, num);
+        midSide.fill(midSideRamp, num);
+        crossfeed.fill(crossfeedRamp, num);
+
+        if (numTransientWeights > 0)
+            transientWidthFactor.fill(transientWidthRamp, num);
+
+        // The guard and the split follow the signal, so they stay sample by sample
+        if (adjustsWidth)
+            for (int i = 0; i < num; ++i)
+                widthRamp[i] = static_cast<float>(adjustWidth(static_cast<CalcType>(left[i]), static_cast<CalcType>(right[i]),
+                                                              static_cast<CalcType>(widthRamp[i]),
+                                                              numTransientWeights > 0 ? transientWidthRamp[i] : 0.0f, start + i));
+
+        // The same matrix as computeMatrices, rebuilt from this sample's
+        // settings and applied in factored form: width, balance, mid/side
+        // (which leaves the left channel alone) and crossfeed. Balance uses
+        // |b| rather than a branch so the loop stays vectorisable.
+        for (int i = 0; i < num; ++i)
+        {
+            const auto g = static_cast<CalcType>(widthRamp[i]);
+            const auto b = static_cast<CalcType>(balanceRamp[i]);
+            const auto k = static_cast<CalcType>(midSideRamp[i]);
+            const auto c = static_cast<CalcType>(crossfeedRamp[i]);
+
+            const CalcType leftGain = one - half * (b + std::abs(b));
+            const CalcType rightGain = one + half * (b - std::abs(b));
+
+            const auto l = static_cast<CalcType>(left[i]);
+            const auto r = static_cast<CalcType>(right[i]);
+            const CalcType widenedLeft = leftGain * (half * (one + g) * l + half * (one - g) * r);
+            const CalcType widenedRight = rightGain * (half * (one - g) * l + half * (one + g) * r);
+            const CalcType msRight = k * widenedLeft + (one - k) * widenedRight;
+
+            left[i] = static_cast<float>(widenedLeft + c * msRight);
+            right[i] = static_cast<float>(c * widenedLeft + msRight);
+        }
+    }
+}
+
+void StereoImager::processExciter (juce::dsp::AudioBlock<float>& block)
+{
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+
+    if (numTransientWeights > 0 && numSamples == numTransientWeights * exciterOversampling)
+    {
+        processExciterSplit(block);
+        return;
+    }
+
+    if (exciterAmount.isSmoothing())
+    {
+        for (int start = 0; start < numSamples; start += rampChunkSize)
+        {
+            const int num = juce::jmin(rampChunkSize, numSamples - start);
+            exciterAmount.fill(exciterRamp, num);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* channelData = block.getChannelPointer(channel) + start;
+
+                for (int i = 0; i < num; ++i)
+                    channelData[i] += exciterRamp[i] * channelData[i] * channelData[i];
+            }
+        }
+
+        return;
+    }
+
+    const float exciterEnhancerFactor = exciterAmount.getTargetValue();
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* channelData = block.getChannelPointer(channel);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            // Apply a simple harmonic excitation
+            const float sampleValue = channelData[sample];
+            channelData[sample] = sampleValue + exciterEnhancerFactor * sampleValue * sampleValue;
+        }
+    }
+}
+
+void StereoImager::processExciterSplit (juce::dsp::AudioBlock<float>& block)
+{
+    // x + a x^2 is linear in a, so the two exciters blend through their amounts
+    // too. Each weight covers `exciterOversampling` samples at the exciter's rate.
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+
+    for (int start = 0; start < numSamples; start += rampChunkSize)
+    {
+        const int num = juce::jmin(rampChunkSize, numSamples - start);
+        exciterAmount.fill(exciterRamp, num);
+        transientExciterAmount.fill(transientExciterRamp, num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const float weight = transientWeights[(start + i) / exciterOversampling];
+            exciterRamp[i] += weight * (transientExciterRamp[i] - exciterRamp[i]);
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* channelData = block.getChannelPointer(channel) + start;
+
+            for (int i = 0; i < num; ++i)
+                channelData[i] += exciterRamp[i] * channelData[i] * channelData[i];
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    StereoImager.h
+    Created: 19 Oct 2026 10:12:04am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "WidthGuard.h"
+#include "TransientSplitter.h"
+#include "ParameterRamp.h"
+
+//==============================================================================
+/*
+    The sample-level part of the imager (width, balance, mid/side, crossfeed
+    and the exciter) pulled out of processBlock, so it can be driven directly
+    on a plain block without a host, an editor or the gain stages around it.
+*/
+struct StereoImagerSettings
+{
+    float widthFactor   = 1.0f;
+    float balance       = 0.0f;
+    float midSide       = 0.0f;
+    float crossfeed     = 0.0f;
+    float exciterAmount = 0.0f;
+
+    bool widthGuard = false;
+    float widthGuardThreshold = 0.0f;
+
+    // With the split on, widthFactor and exciterAmount apply to the sustain
+    // and these to the transients
+    bool transientSplit = false;
+    float transientWidthFactor = 1.0f;
+    float transientExciterAmount = 0.0f;
+};
+
+class StereoImager
+{
+public:
+    StereoImager();
+    ~StereoImager();
+
+    // Maps the 0-100 % width parameter onto the side gain used by the kernel
+    static float widthFactorFor (float widthPercent);
+
+    static StereoImagerSettings makeSettings (float widthPercent, float balance, float midSide,
+                                              float crossfeed, float exciterPercent);
+
+    // The row-major matrix the stereo stage applies for constant settings,
+    // ignoring the width guard and the transient split
+    static std::array<double, 4> getMatrix (const StereoImagerSettings& settings);
+
+    // exciterSampleRate differs from sampleRate when the caller runs the
+    // exciter oversampled. Settings ramp per sample over smoothingSeconds, or
+    // jump at block boundaries with 0; useDoublePrecision runs the stereo
+    // matrix in doubles.
+    // transientWeightStorage holds maximumBlockSize floats and belongs to the
+    // caller (the processor's DspArena); blocks longer than that skip the
+    // transient split.
+    void prepare (double sampleRate, double exciterSampleRate, float* transientWeightStorage, int maximumBlockSize,
+                  double smoothingSeconds, bool useDoublePrecision);
+
+    // Snaps every setting to its target, e.g. after prepare or a state change
+    void reset();
+
+    void setSettings (const StereoImagerSettings& newSettings);
+    StereoImagerSettings getTargetSettings() const;
+
+    // Runs both stages; processBlock calls them separately so it can
+    // oversample around the exciter.
+    void process (const juce::dsp::ProcessContextReplacing<float>& context);
+    void processStereo (const juce::dsp::ProcessContextReplacing<float>& context);
+    void processExciter (juce::dsp::AudioBlock<float>& block);
+
+    // The width guard's strongest reduction since the last call, as a side
+    // gain factor (1 = none). Audio thread only.
+    float takeWidthGuardGain() noexcept;
+
+    // Audio needed before a given point for a fresh imager to match one that
+    // has processed everything up to it. Only the width guard and the
+    // transient split have memory.
+    double getWarmUpSeconds() const noexcept
+    {
+        return juce::jmax(widthGuardEnabled ? WidthGuard::getSettlingSeconds() : 0.0,
+                          transientSplitEnabled ? TransientSplitter::getSettlingSeconds() : 0.0);
+    }
+
+private:
+    // Settled: one precomputed matrix per block, or per sample while the
+    // guard or the transient split moves the width
+    template <typename CalcType>
+    void processStereoConstant (float* left, float* right, int numSamples);
+
+    template <typename CalcType>
+    void processStereoMatrixPerSample (float* left, float* right, int numSamples);
+
+    // Any ramp still moving: the ramps are filled a chunk at a time and the
+    // matrix is rebuilt from them for every sample
+    template <typename CalcType>
+    void processStereoRamped (float* left, float* right, int numSamples);
+
+    bool isStereoRamping() const noexcept;
+
+    void updateMatrix();
+
+    template <typename CalcType>
+    std::array<CalcType, 4> matrixForWidth (CalcType widthValue) const noexcept;
+
+    ParameterRamp widthFactor { 1.0f };
+    ParameterRamp balance;
+    ParameterRamp midSide;
+    ParameterRamp crossfeed;
+    ParameterRamp exciterAmount;
+    ParameterRamp transientWidthFactor { 1.0f };
+    ParameterRamp transientExciterAmount;
+
+    static constexpr int rampChunkSize = 64;
+
+    alignas (64) float widthRamp[rampChunkSize], balanceRamp[rampChunkSize];
+    alignas (64) float midSideRamp[rampChunkSize], crossfeedRamp[rampChunkSize];
+    alignas (64) float transientWidthRamp[rampChunkSize];
+    alignas (64) float exciterRamp[rampChunkSize], transientExciterRamp[rampChunkSize];
+
+    WidthGuard widthGuard;
+    bool widthGuardEnabled = false;
+    float widthGuardThreshold = 0.0f;
+
+    // The stereo stage stores each sample's transient weight for the
+    // exciter, which may run oversampled by exciterOversampling
+    TransientSplitter transientSplitter;
+    bool transientSplitEnabled = false;
+    float* transientWeights = nullptr;
+    int transientWeightCapacity = 0;
+    int numTransientWeights = 0;
+    int exciterOversampling = 1;
+
+    template <typename CalcType>
+    CalcType nextWidth (CalcType left, CalcType right, int sample) noexcept;
+
+    // The guard and the transient split applied to one sample's width
+    template <typename CalcType>
+    CalcType adjustWidth (CalcType left, CalcType right, CalcType widthValue, float transientWidth, int sample) noexcept;
+
+    void processExciterSplit (juce::dsp::AudioBlock<float>& block);
+
+    // Row-major stereo matrix for the target settings: fixedMatrix + width * sideMatrix.
+    // Only recomputed when balance, mid/side or crossfeed change.
+    std::array<double, 4> fixedMatrix {}, sideMatrix {};
+
+    bool doublePrecision = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoImager)
+};
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 21 Oct 2026 2:07:45am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+#if IMAGINATION_ENABLE_TRACING
+
+#include <cstdio>
+#include <tuple>
+#include <vector>
+
+std::atomic<TraceRecorder*> TraceRecorder::instance { nullptr };
+std::atomic<juce::uint32> TraceRecorder::generation { 0 };
+
+namespace
+{
+    // Each thread's buffer, tagged with the recorder it belongs to so one
+    // left over from an earlier recorder is never used
+    struct ThreadCache
+    {
+        juce::uint32 generation = 0;
+        void* buffer = nullptr;
+    };
+
+    thread_local ThreadCache threadCache;
+}
+
+TraceRecorder::TraceRecorder()
+    : originTicks (juce::Time::getHighResolutionTicks())
+{
+    if (auto path = juce::SystemStats::getEnvironmentVariable("IMAGINATION_TRACE_FILE", {}); path.isNotEmpty())
+        traceFile = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+
+    generation.fetch_add(1, std::memory_order_relaxed);
+    instance.store(this, std::memory_order_release);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    instance.store(nullptr, std::memory_order_release);
+
+    if (traceFile != juce::File())
+    {
+        if (writeChromeTrace(traceFile))
+            DBG("Trace written to " + traceFile.getFullPathName());
+        else
+            DBG("Could not write the trace to " + traceFile.getFullPathName());
+    }
+}
+
+void TraceRecorder::record (const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept
+{
+    auto* recorder = instance.load(std::memory_order_acquire);
+
+    if (recorder == nullptr)
+        return;
+
+    auto* buffer = recorder->getThreadBuffer(name);
+
+    if (buffer == nullptr)
+        return;
+
+    // Only this thread writes the buffer; the count is published last so a
+    // reader never sees an event before its fields
+    const auto index = buffer->numEvents.load(std::memory_order_relaxed);
+    auto& event = buffer->events[static_cast<size_t>(index % eventsPerThread)];
+
+    event.name.store(name, std::memory_order_relaxed);
+    event.startTicks.store(startTicks, std::memory_order_relaxed);
+    event.endTicks.store(endTicks, std::memory_order_relaxed);
+    buffer->numEvents.store(index + 1, std::memory_order_release);
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer (const char* firstSpanName) noexcept
+{
+    const auto currentGeneration = generation.load(std::memory_order_relaxed);
+
+    if (threadCache.generation == currentGeneration)
+        return static_cast<ThreadBuffer*>(threadCache.buffer);
+
+    // First span on this thread: claim the next buffer from the pool. Once
+    // they are all taken, later threads' spans are dropped.
+    threadCache.generation = currentGeneration;
+    threadCache.buffer = nullptr;
+
+    const int index = numThreadsClaimed.fetch_add(1, std::memory_order_relaxed);
+
+    if (index >= maxThreads)
+        return nullptr;
+
+    // Just enough to name the thread later; the name is only formatted
+    // when the trace is written
+    auto& buffer = threads[static_cast<size_t>(index)];
+    buffer.isMessageThread.store(juce::MessageManager::existsAndIsCurrentThread(), std::memory_order_relaxed);
+    buffer.firstSpanName.store(firstSpanName, std::memory_order_release);
+
+    threadCache.buffer = &buffer;
+    return &buffer;
+}
+
+bool TraceRecorder::writeChromeTrace (const juce::File& file) const
+{
+    juce::FileOutputStream stream(file);
+
+    if (! stream.openedOk())
+        return false;
+
+    stream.setPosition(0);
+    stream.truncate();
+
+    const auto ticksPerMicrosecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+    bool isFirst = true;
+    char line[256];
+
+    auto writeLine = [&stream, &isFirst](const char* text)
+    {
+        stream << (isFirst ? "\n" : ",\n") << text;
+        isFirst = false;
+    };
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    const int numThreads = juce::jmin(maxThreads, numThreadsClaimed.load(std::memory_order_relaxed));
+
+    for (int i = 0; i < numThreads; ++i)
+    {
+        const auto* buffer = &threads[static_cast<size_t>(i)];
+        const auto* firstSpanName = buffer->firstSpanName.load(std::memory_order_acquire);
+
+        // Claimed, but not recorded into yet
+        if (firstSpanName == nullptr)
+            continue;
+
+        if (buffer->isMessageThread.load(std::memory_order_relaxed))
+            std::snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Message thread\"}}",
+                          i + 1);
+        else
+            std::snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Thread %d (%s)\"}}",
+                          i + 1, i + 1, firstSpanName);
+
+        writeLine(line);
+
+        // The owning thread may still be recording. Copy the events it
+        // cannot have reached yet, then drop any it overwrote meanwhile.
+        const auto numEvents = buffer->numEvents.load(std::memory_order_acquire);
+        const auto first = numEvents > static_cast<juce::uint64>(eventsPerThread) ? numEvents - eventsPerThread : 0;
+
+        std::vector<std::tuple<juce::uint64, const char*, juce::int64, juce::int64>> events;
+        events.reserve(static_cast<size_t>(numEvents - first));
+
+        for (auto index = first; index < numEvents; ++index)
+        {
+            const auto& event = buffer->events[static_cast<size_t>(index % eventsPerThread)];
+            events.emplace_back(index,
+                                event.name.load(std::memory_order_relaxed),
+                                event.startTicks.load(std::memory_order_relaxed),
+                                event.endTicks.load(std::memory_order_relaxed));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto numEventsAfter = buffer->numEvents.load(std::memory_order_relaxed);
+        const auto firstIntact = numEventsAfter >= static_cast<juce::uint64>(eventsPerThread) ? numEventsAfter - eventsPerThread + 1 : 0;
+
+        for (const auto& [index, name, startTicks, endTicks] : events)
+        {
+            if (index < firstIntact || name == nullptr)
+                continue;
+
+            std::snprintf(line, sizeof(line), "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                          name, i + 1,
+                          static_cast<double>(startTicks - originTicks) / ticksPerMicrosecond,
+                          static_cast<double>(endTicks - startTicks) / ticksPerMicrosecond);
+            writeLine(line);
+        }
+    }
+
+    stream << "\n]}\n";
+    stream.flush();
+    return stream.getStatus().wasOk();
+}
+
+#endif
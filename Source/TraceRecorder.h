@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 21 Oct 2026 2:07:45am
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+
+// Build with IMAGINATION_ENABLE_TRACING=1 to record trace spans. Otherwise
+// IMAGINATION_TRACE_SCOPE expands to nothing and none of this is compiled.
+#ifndef IMAGINATION_ENABLE_TRACING
+ #define IMAGINATION_ENABLE_TRACING 0
+#endif
+
+#if IMAGINATION_ENABLE_TRACING
+
+//==============================================================================
+/*
+    Records timed spans from any thread and writes them out as Chrome trace
+    JSON, which chrome://tracing and Perfetto (ui.perfetto.dev) both load.
+
+    Each thread gets its own ring buffer the first time it records a span, so
+    recording is a few relaxed stores with no locks. The buffers are all
+    allocated and touched in the constructor (maxThreads x eventsPerThread
+    x 24 bytes, 24 MB), so a thread's first span only claims one with an
+    atomic increment: nothing on the audio thread allocates, formats or
+    page-faults. Each buffer keeps the most recent eventsPerThread spans,
+    about a minute of processBlock stages. A thread's name in the trace is
+    worked out when it is written: the message thread is named as such,
+    any other after its first span, e.g. "Thread 2 (processBlock)".
+
+    At about 80 ns per span, and 8 spans in a processBlock, that is
+    roughly 0.6 us per block: 0.006% of a 512-sample block's deadline at
+    48 kHz, and under 1% of processBlock itself for any block that takes
+    longer than 60 us.
+
+    The recorder is held through juce::SharedResourcePointer, by every
+    processor. Spans recorded while nothing holds it are dropped. With
+    IMAGINATION_TRACE_FILE set in the environment, the trace is written to
+    that file when the last holder goes away.
+
+    Span names must be string literals (or otherwise outlive the recorder),
+    and must not need escaping in JSON.
+*/
+class TraceRecorder
+{
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    static constexpr int maxThreads = 16;
+    static constexpr int eventsPerThread = 1 << 16;
+
+    // Any thread
+    static void record (const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    // Writes everything recorded so far. Not on the audio thread.
+    bool writeChromeTrace (const juce::File& file) const;
+
+private:
+    struct Event
+    {
+        std::atomic<const char*> name { nullptr };
+        std::atomic<juce::int64> startTicks { 0 }, endTicks { 0 };
+    };
+
+    struct ThreadBuffer
+    {
+        // Set by the thread that claims the buffer; null until then
+        std::atomic<const char*> firstSpanName { nullptr };
+        std::atomic<bool> isMessageThread { false };
+
+        std::atomic<juce::uint64> numEvents { 0 };
+        std::unique_ptr<Event[]> events { new Event[eventsPerThread] };
+    };
+
+    ThreadBuffer* getThreadBuffer (const char* firstSpanName) noexcept;
+
+    static std::atomic<TraceRecorder*> instance;
+    static std::atomic<juce::uint32> generation;
+
+    std::array<ThreadBuffer, maxThreads> threads;
+    std::atomic<int> numThreadsClaimed { 0 };
+    juce::int64 originTicks = 0;
+    juce::File traceFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TraceRecorder)
+};
+
+//==============================================================================
+// Times its own lifetime and records it as a span
+class TraceScope
+{
+public:
+    explicit TraceScope (const char* spanName) noexcept
+        : name (spanName), startTicks (juce::Time::getHighResolutionTicks())
+    {
+    }
+
+    ~TraceScope() noexcept
+    {
+        TraceRecorder::record(name, startTicks, juce::Time::getHighResolutionTicks());
+    }
+
+private:
+    const char* name;
+    juce::int64 startTicks;
+
+    JUCE_DECLARE_NON_COPYABLE (TraceScope)
+};
+
+ #define IMAGINATION_TRACE_SCOPE(name) const TraceScope JUCE_JOIN_MACRO (traceScope, __LINE__) (name)
+
+#else
+
+ #define IMAGINATION_TRACE_SCOPE(name)
+
+#endif
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    TransientSplitter.cpp
+    Created: 20 Oct 2026 5:10:37pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "TransientSplitter.h"
+
+namespace
+{
+    float onePoleCoefficient (double seconds, double sampleRate)
+    {
+        return static_cast<float>(1.0 - std::exp(-1.0 / (seconds * sampleRate)));
+    }
+}
+
+//==============================================================================
+TransientSplitter::TransientSplitter()
+{
+    prepare(44100.0);
+}
+
+TransientSplitter::~TransientSplitter()
+{
+}
+
+void TransientSplitter::prepare (double sampleRate)
+{
+    jassert(sampleRate > 0.0);
+
+    const float fastAttack = onePoleCoefficient(fastAttackSeconds, sampleRate);
+    const float fastRelease = onePoleCoefficient(fastReleaseSeconds, sampleRate);
+    const float slowAttack = onePoleCoefficient(slowAttackSeconds, sampleRate);
+    const float slowRelease = onePoleCoefficient(slowReleaseSeconds, sampleRate);
+
+    alignas (registerAlignment) float attack[numLanes];
+    alignas (registerAlignment) float release[numLanes];
+
+    for (int lane = 0; lane < numLanes; lane += numFollowers)
+    {
+        attack[lane] = attack[lane + 2] = fastAttack;
+        attack[lane + 1] = attack[lane + 3] = slowAttack;
+        release[lane] = release[lane + 2] = fastRelease;
+        release[lane + 1] = release[lane + 3] = slowRelease;
+    }
+
+    attackCoefficients = Lanes::fromRawArray(attack);
+    releaseCoefficients = Lanes::fromRawArray(release);
+
+    reset();
+}
+
+void TransientSplitter::reset()
+{
+    envelopes = Lanes::expand(0.0f);
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    TransientSplitter.h
+    Created: 20 Oct 2026 5:10:37pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Tells transients from sustain, one sample at a time and without
+    lookahead, so the imager can widen tails while leaving attacks alone.
+
+    A fast and a slow envelope follower run on the mid and the side signal:
+    four followers in the lanes of one SIMD register, updated together with
+    a compare-and-select instead of an attack/release branch. Registers
+    wider than four lanes (AVX) run the same four again in the spare lanes. Where the
+    fast envelope runs ahead of the slow one there is a transient; the
+    weight returned is how far ahead it is, 0 (sustain) to 1 (transient).
+    Mid is what the detection is about; side gets the same treatment so a
+    transient panned hard to one side is caught too.
+*/
+class TransientSplitter
+{
+public:
+    TransientSplitter();
+    ~TransientSplitter();
+
+    void prepare (double sampleRate);
+    void reset();
+
+    // Feeds one input sample pair and returns its transient weight, 0 to 1
+    float process (float left, float right) noexcept
+    {
+        const float mid = 0.5f * (left + right);
+        const float side = 0.5f * (left - right);
+
+        alignas (registerAlignment) float input[numLanes];
+
+        for (int lane = 0; lane < numLanes; lane += numFollowers)
+        {
+            input[lane] = input[lane + 1] = std::abs(mid);
+            input[lane + 2] = input[lane + 3] = std::abs(side);
+        }
+
+        const auto x = Lanes::fromRawArray(input);
+
+        // Attack coefficient where the input is above the envelope, release elsewhere
+        const auto rising = Lanes::greaterThan(x, envelopes);
+        const auto coefficients = releaseCoefficients + ((attackCoefficients - releaseCoefficients) & rising);
+        envelopes = envelopes + coefficients * (x - envelopes);
+
+        alignas (registerAlignment) float e[numLanes];
+        envelopes.copyToRawArray(e);
+
+        const float midWeight = juce::jmax(0.0f, e[0] - e[1]) / (e[0] + 1.0e-6f);
+        const float sideWeight = juce::jmax(0.0f, e[2] - e[3]) / (e[2] + 1.0e-6f);
+        return juce::jmin(1.0f, juce::jmax(midWeight, sideWeight));
+    }
+
+    // A dozen of the slowest follower's time constants
+    static constexpr double getSettlingSeconds() noexcept { return 12.0 * slowReleaseSeconds; }
+
+private:
+    static constexpr double fastAttackSeconds = 0.0005;
+    static constexpr double fastReleaseSeconds = 0.02;
+    static constexpr double slowAttackSeconds = 0.02;
+    static constexpr double slowReleaseSeconds = 0.2;
+
+    static constexpr int numFollowers = 4;   // fast mid, slow mid, fast side, slow side
+
+   #if JUCE_USE_SIMD
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr size_t registerAlignment = Lanes::SIMDRegisterSize;
+    static constexpr int numLanes = static_cast<int>(Lanes::SIMDNumElements);
+   #else
+    static constexpr size_t registerAlignment = 16;
+    static constexpr int numLanes = numFollowers;
+
+    // The same operations on plain floats; compilers turn the select into a blend
+    struct Lanes
+    {
+        float v[numLanes] {};
+
+        static Lanes fromRawArray (const float* a) noexcept   { Lanes r; for (int i = 0; i < numLanes; ++i) r.v[i] = a[i]; return r; }
+        static Lanes expand (float s) noexcept                { Lanes r; for (auto& x : r.v) x = s; return r; }
+        static Lanes greaterThan (Lanes a, Lanes b) noexcept  { Lanes r; for (int i = 0; i < numLanes; ++i) r.v[i] = a.v[i] > b.v[i] ? 1.0f : 0.0f; return r; }
+        void copyToRawArray (float* a) const noexcept         { for (int i = 0; i < numLanes; ++i) a[i] = v[i]; }
+
+        Lanes operator+ (Lanes o) const noexcept { Lanes r; for (int i = 0; i < numLanes; ++i) r.v[i] = v[i] + o.v[i]; return r; }
+        Lanes operator- (Lanes o) const noexcept { Lanes r; for (int i = 0; i < numLanes; ++i) r.v[i] = v[i] - o.v[i]; return r; }
+        Lanes operator* (Lanes o) const noexcept { Lanes r; for (int i = 0; i < numLanes; ++i) r.v[i] = v[i] * o.v[i]; return r; }
+        Lanes operator& (Lanes mask) const noexcept { return *this * mask; }
+    };
+   #endif
+
+    static_assert (numLanes % numFollowers == 0, "every lane runs one of the followers");
+
+    Lanes envelopes {};
+    Lanes attackCoefficients {}, releaseCoefficients {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TransientSplitter)
+};
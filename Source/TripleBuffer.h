@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 19 Oct 2026 6:14:51pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+//==============================================================================
+/*
+    Lock-free hand-over of the latest value from one writer thread to one
+    reader thread. The writer fills getWriteBuffer() and calls publish(); the
+    reader calls fetch() and, if it returns true, reads getReadBuffer().
+    Neither side ever waits, and intermediate values the reader didn't get
+    round to are simply overwritten.
+*/
+template <typename Type>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Writer side
+    Type& getWriteBuffer() noexcept { return buffers[static_cast<std::size_t>(writeIndex)]; }
+
+    void publish() noexcept
+    {
+        const auto previous = middle.exchange(writeIndex | dirtyFlag, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    // Reader side
+    bool fetch() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & dirtyFlag) == 0)
+            return false;
+
+        const auto previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        return true;
+    }
+
+    const Type& getReadBuffer() const noexcept { return buffers[static_cast<std::size_t>(readIndex)]; }
+
+    // Only for setting buffers up before either side starts using them
+    std::array<Type, 3>& getAllBuffers() noexcept { return buffers; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int dirtyFlag = 4;
+
+    std::array<Type, 3> buffers;
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle { 2 };
+};
@@ -13,39 +13,69 @@
 #include <JuceHeader.h>
 #include <vector>
 #include <deque>
+#include "SharedEditorResources.h"
+#include "ComparisonBus.h"
+#include "PolarHistogram.h"
 
 
 
 //==============================================================================
 /*
 */
-class VisualizerComponent  : public juce::Component, private juce::Timer
+class VisualizerComponent  : public juce::Component
 {
 public:
     VisualizerComponent();
     ~VisualizerComponent() override;
+
+    // Lissajous trace of the vectorscope points, or a fan of the polar
+    // histogram. The POLAR button in the corner switches between them.
+    enum class DisplayMode { lissajous, polar };
+
+    void setDisplayMode(DisplayMode newMode);
+    DisplayMode getDisplayMode() const noexcept { return displayMode; }
     
-    void setAudioData(const std::vector<float>& leftChannelData, const std::vector<float>& rightChannelData);
-    void copyAudioBuffer(const juce::AudioBuffer<float>& buffer);
+    // Takes a frame of vectorscope points normalised to the unit circle
+    // (side on x, mid on y) and schedules a repaint
+    void setStereoPoints(const std::vector<juce::Point<float>>& points);
+
+    // Takes a histogram frame for the polar display and schedules a repaint
+    void setPolarFrame(const PolarHistogram::Frame& frame);
+
+    // Overlays another instance's trace and per-band width from the
+    // comparison bus, until clearComparison() is called
+    void setComparison(const juce::String& name, const ComparisonFrame& frame);
+    void clearComparison();
 
     void paint(juce::Graphics& g) override;
     void resized() override;
     
 private:
     
-    void timerCallback() override;
     void drawGrid(juce::Graphics& g);
     void drawStereoImage(juce::Graphics& g);
     void drawLabels(juce::Graphics& g);
+    void drawComparison(juce::Graphics& g);
+    void drawPolar(juce::Graphics& g);
 
 
-    juce::CriticalSection lock;
-    std::vector<float> leftChannelData;
-    std::vector<float> rightChannelData;
+    juce::SharedResourcePointer<SharedEditorResources> sharedResources;
+
+    std::vector<juce::Point<float>> stereoPoints;
+    bool hasNewFrame = false;
 
     std::deque<juce::Path> pathHistory; // New data member to store paths
     int maxHistorySize = 20; // Maximum number of paths to store
 
+    DisplayMode displayMode = DisplayMode::lissajous;
+    juce::TextButton polarButton { "POLAR" };
+    PolarHistogram::Frame polarFrame;
+
+    bool hasComparison = false;
+    juce::String comparisonName;
+    std::vector<juce::Point<float>> comparisonPoints;
+    std::array<float, ComparisonFrame::numBands> comparisonBandWidth {};
+
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VisualizerComponent)
 };
@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "VisualizerComponent.h"
+#include "TraceRecorder.h"
 
 //==============================================================================
 VisualizerComponent::VisualizerComponent()
@@ -17,64 +18,96 @@ VisualizerComponent::VisualizerComponent()
 {
     // In your constructor, you should add any child components, and
     // initialise any special settings that your component needs.
-    startTimer(30);
-    
+    comparisonPoints.reserve(ComparisonFrame::maxPoints);
+
+    addAndMakeVisible(polarButton);
+    polarButton.setClickingTogglesState(true);
+    polarButton.onClick = [this] { setDisplayMode(polarButton.getToggleState() ? DisplayMode::polar : DisplayMode::lissajous); };
 }
 
 VisualizerComponent::~VisualizerComponent()
 {
-    stopTimer();
 }
 
-void VisualizerComponent::setAudioData(const std::vector<float>& leftChannelData, const std::vector<float>& rightChannelData)
+void VisualizerComponent::setDisplayMode(DisplayMode newMode)
 {
-    const juce::ScopedLock sl(lock);
-    this->leftChannelData = leftChannelData;
-    this->rightChannelData = rightChannelData;
+    polarButton.setToggleState(newMode == DisplayMode::polar, juce::dontSendNotification);
+
+    if (newMode == displayMode)
+        return;
+
+    displayMode = newMode;
+
+    // Neither display's history means anything to the other
+    pathHistory.clear();
+    polarFrame = {};
+    repaint();
 }
 
-void VisualizerComponent::paint (juce::Graphics& g)
+void VisualizerComponent::setPolarFrame(const PolarHistogram::Frame& frame)
 {
-    g.setImageResamplingQuality(juce::Graphics::ResamplingQuality::highResamplingQuality); // Ensure high-quality resampling
-    g.fillAll(juce::Colour(20, 20, 25).withAlpha(0.5f));
+    polarFrame = frame;
+    repaint();
+}
 
-    drawGrid(g);
-    drawStereoImage(g);
-    drawLabels(g);
+void VisualizerComponent::setStereoPoints(const std::vector<juce::Point<float>>& points)
+{
+    stereoPoints.assign(points.begin(), points.end());
+    hasNewFrame = true;
+    repaint();
 }
 
-void VisualizerComponent::resized()
+void VisualizerComponent::setComparison(const juce::String& name, const ComparisonFrame& frame)
 {
-    // This method is where you should set the bounds of any child
-    // components that your component contains..
+    comparisonName = name;
+    comparisonPoints.assign(frame.points.begin(), frame.points.begin() + frame.numPoints);
+    comparisonBandWidth = frame.bandWidth;
+    hasComparison = true;
+    repaint();
 }
 
-void VisualizerComponent::copyAudioBuffer(const juce::AudioBuffer<float>& buffer)
+void VisualizerComponent::clearComparison()
 {
-    const juce::ScopedLock sl(lock);
+    if (! hasComparison)
+        return;
 
-    int numSamples = buffer.getNumSamples();
-    int numChannels = buffer.getNumChannels();
+    hasComparison = false;
+    comparisonPoints.clear();
+    repaint();
+}
 
-    leftChannelData.resize(numSamples);
-    rightChannelData.resize(numSamples);
+void VisualizerComponent::paint (juce::Graphics& g)
+{
+    IMAGINATION_TRACE_SCOPE("visualizer paint");
+    g.setImageResamplingQuality(juce::Graphics::ResamplingQuality::highResamplingQuality); // Ensure high-quality resampling
+    g.fillAll(juce::Colour(20, 20, 25).withAlpha(0.5f));
 
-    if (numChannels > 0)
-        std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + numSamples, leftChannelData.begin());
+    drawGrid(g);
 
-    if (numChannels > 1)
-        std::copy(buffer.getReadPointer(1), buffer.getReadPointer(1) + numSamples, rightChannelData.begin());
+    if (displayMode == DisplayMode::polar)
+    {
+        drawPolar(g);
+    }
     else
-        rightChannelData.assign(numSamples, 0.0f); // Handle mono input by setting rightChannelData to 0
+    {
+        drawStereoImage(g);
+        drawComparison(g);
+    }
+
+    drawLabels(g);
 }
 
-void VisualizerComponent::timerCallback()
+void VisualizerComponent::resized()
 {
-    repaint();
+    // The stored paths are in pixel coordinates, so they don't survive a resize
+    pathHistory.clear();
+
+    polarButton.setBounds(getLocalBounds().removeFromTop(26).removeFromRight(70).reduced(6, 4));
 }
 
 void VisualizerComponent::drawGrid(juce::Graphics& g)
 {
+    IMAGINATION_TRACE_SCOPE("drawGrid");
     auto bounds = getLocalBounds().toFloat();
     auto center = bounds.getCentre();
     float radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2 + 90.0f;
@@ -115,64 +148,38 @@ void VisualizerComponent::drawGrid(juce::Graphics& g)
 
 void VisualizerComponent::drawStereoImage(juce::Graphics& g)
 {
+    IMAGINATION_TRACE_SCOPE("drawStereoImage");
     auto bounds = getLocalBounds().toFloat();
     auto center = bounds.getCentre();
     float maxRadius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f - 40.0f;
 
-    juce::Path currentPath;
-    const juce::ScopedLock sl(lock);
-
-    // Use a simple low-pass filter for smoothing instead of moving average
-    const float smoothingFactor = 0.05f;
-    std::vector<float> smoothedLeft(leftChannelData.size());
-    std::vector<float> smoothedRight(rightChannelData.size());
-
-    smoothedLeft[0] = leftChannelData[0];
-    smoothedRight[0] = rightChannelData[0];
-
-    for (size_t i = 1; i < leftChannelData.size(); ++i)
-    {
-        smoothedLeft[i] = smoothedLeft[i - 1] + smoothingFactor * (leftChannelData[i] - smoothedLeft[i - 1]);
-        smoothedRight[i] = smoothedRight[i - 1] + smoothingFactor * (rightChannelData[i] - smoothedRight[i - 1]);
-    }
-
     // Use Bezier curves for smoother paths
-    for (size_t i = 0; i < smoothedLeft.size() && i < smoothedRight.size(); i += 4)
+    if (hasNewFrame && ! stereoPoints.empty())
     {
-        float left = smoothedLeft[i];
-        float right = smoothedRight[i];
-
-        float stereoWidth = left - right;
-        float amplitude = (left + right) * 0.5f;
-
-        float x = juce::jmap(stereoWidth, -1.0f, 1.0f, -maxRadius, maxRadius);
-        float y = juce::jmap(amplitude, -1.0f, 1.0f, maxRadius, -maxRadius);
+        juce::Path currentPath;
 
-        float distance = std::sqrt(x * x + y * y);
-        if (distance > maxRadius)
+        for (size_t i = 0; i < stereoPoints.size(); ++i)
         {
-            float scale = maxRadius / distance;
-            x *= scale;
-            y *= scale;
+            const float x = center.x + stereoPoints[i].x * maxRadius;
+            const float y = center.y + stereoPoints[i].y * maxRadius;
+
+            if (i == 0)
+                currentPath.startNewSubPath(x, y);
+            else
+            {
+                auto lastPoint = currentPath.getCurrentPosition();
+                auto controlPoint = juce::Point<float>((lastPoint.getX() + x) / 2, (lastPoint.getY() + y) / 2);
+                currentPath.quadraticTo(controlPoint, { x, y });
+            }
         }
 
-        x += center.x;
-        y += center.y;
-
-        if (i == 0)
-            currentPath.startNewSubPath(x, y);
-        else
-        {
-            auto lastPoint = currentPath.getCurrentPosition();
-            auto controlPoint = juce::Point<float>((lastPoint.getX() + x) / 2, (lastPoint.getY() + y) / 2);
-            currentPath.quadraticTo(controlPoint, { x, y });
-        }
+        // Path stroke and glow
+        pathHistory.push_back(currentPath);
+        if (pathHistory.size() > maxHistorySize)
+            pathHistory.pop_front();
     }
 
-    // Path stroke and glow
-    pathHistory.push_back(currentPath);
-    if (pathHistory.size() > maxHistorySize)
-        pathHistory.pop_front();
+    hasNewFrame = false;
 
     // Dynamic stroke based on amplitude
     for (size_t i = 0; i < pathHistory.size(); ++i)
@@ -186,18 +193,139 @@ void VisualizerComponent::drawStereoImage(juce::Graphics& g)
 
 void VisualizerComponent::drawLabels(juce::Graphics& g)
 {
-    //Set Font
-    juce::Typeface::Ptr helvetica = juce::Typeface::createSystemTypefaceFor(BinaryData::HelveticaBold_woff, BinaryData::HelveticaBold_woffSize);
-    juce::Font font(*helvetica);
-    
     auto bounds = getLocalBounds().toFloat();
     auto center = bounds.getCentre();
     float radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f - 10.0f;
 
     g.setColour(juce::Colour(247, 236, 242));
+    g.setFont(sharedResources->getLabelFont());
 //    g.drawText("MONO", center.x - 30, center.y - radius - 20, 60, 20, juce::Justification::centred);
+
+    // On the fan, hard left and right are the diagonals; straight out to the sides is out of phase
+    if (displayMode == DisplayMode::polar)
+    {
+        const auto left = center.getPointOnCircumference(radius, -juce::MathConstants<float>::pi / 4.0f);
+        const auto right = center.getPointOnCircumference(radius, juce::MathConstants<float>::pi / 4.0f);
+        g.drawText("L", juce::Rectangle<float>(20.0f, 20.0f).withCentre(left.translated(-10.0f, 0.0f)), juce::Justification::centred);
+        g.drawText("R", juce::Rectangle<float>(20.0f, 20.0f).withCentre(right.translated(10.0f, 0.0f)), juce::Justification::centred);
+        return;
+    }
+
     g.drawText("L", center.x - radius - 20, center.y - 10, 20, 20, juce::Justification::centred);
     g.drawText("R", center.x + radius, center.y - 10, 20, 20, juce::Justification::centred);
-    
-    g.setFont(font);
+}
+
+void VisualizerComponent::drawComparison(juce::Graphics& g)
+{
+    if (! hasComparison)
+        return;
+
+    auto bounds = getLocalBounds().toFloat();
+    auto center = bounds.getCentre();
+    float maxRadius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f - 40.0f;
+
+    // A single thin trace, so it reads as a reference behind our own
+    juce::Path path;
+
+    for (size_t i = 0; i < comparisonPoints.size(); ++i)
+    {
+        const juce::Point<float> point { center.x + comparisonPoints[i].x * maxRadius, center.y + comparisonPoints[i].y * maxRadius };
+
+        if (i == 0)
+            path.startNewSubPath(point);
+        else
+            path.lineTo(point);
+    }
+
+    const auto colour = juce::Colour(255, 170, 60);
+    g.setColour(colour.withAlpha(0.7f));
+    g.strokePath(path, juce::PathStrokeType(1.5f));
+
+    // Name and width per band in the bottom-left corner
+    static const char* bandNames[] = { "LOW", "MID", "HIGH" };
+    juce::String text = comparisonName;
+
+    for (size_t band = 0; band < comparisonBandWidth.size(); ++band)
+        text << "   " << bandNames[band] << " " << juce::roundToInt(comparisonBandWidth[band] * 100.0f) << "%";
+
+    g.setColour(colour);
+    g.setFont(12.0f);
+    g.drawText(text, bounds.reduced(8.0f).removeFromBottom(16.0f), juce::Justification::centredLeft);
+}
+
+void VisualizerComponent::drawPolar(juce::Graphics& g)
+{
+    IMAGINATION_TRACE_SCOPE("drawPolar");
+    constexpr int numAngles = PolarHistogram::numAngleBins;
+    constexpr int numMagnitudes = PolarHistogram::numMagnitudeBins;
+    constexpr float binDegrees = 2.0f * PolarHistogram::maximumAngle / numAngles;
+
+    auto bounds = getLocalBounds().toFloat();
+    auto center = bounds.getCentre();
+    float maxRadius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f - 40.0f;
+
+    // Centre line and the hard left/right diagonals
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+
+    for (const float degrees : { -45.0f, 0.0f, 45.0f })
+        g.drawLine({ center, center.getPointOnCircumference(maxRadius, juce::degreesToRadians(degrees)) }, 1.0f);
+
+    // Blur neighbouring angles a little so the fan reads as one shape
+    std::array<float, numAngles * numMagnitudes> smoothed {};
+    float peak = 0.0f;
+
+    for (int angle = 0; angle < numAngles; ++angle)
+    {
+        for (int magnitude = 0; magnitude < numMagnitudes; ++magnitude)
+        {
+            const float before = polarFrame.get(juce::jmax(0, angle - 1), magnitude);
+            const float after = polarFrame.get(juce::jmin(numAngles - 1, angle + 1), magnitude);
+            const float value = 0.25f * before + 0.5f * polarFrame.get(angle, magnitude) + 0.25f * after;
+
+            smoothed[static_cast<size_t>(angle * numMagnitudes + magnitude)] = value;
+            peak = juce::jmax(peak, value);
+        }
+    }
+
+    if (peak <= 0.0f)
+        return;
+
+    // One wedge per angle with a radial gradient through its magnitude bins,
+    // so the cost depends only on the number of bins
+    const auto colour = juce::Colours::cyan;
+
+    for (int angle = 0; angle < numAngles; ++angle)
+    {
+        const auto* column = smoothed.data() + angle * numMagnitudes;
+
+        if (*std::max_element(column, column + numMagnitudes) <= 0.0f)
+            continue;
+
+        juce::ColourGradient gradient(colour.withAlpha(0.0f), center,
+                                      colour.withAlpha(0.0f), center.translated(maxRadius, 0.0f), true);
+
+        for (int magnitude = 0; magnitude < numMagnitudes; ++magnitude)
+            gradient.addColour((magnitude + 0.5) / numMagnitudes, colour.withAlpha(std::sqrt(column[magnitude] / peak) * 0.9f));
+
+        // Slightly overlapping wedges, so no seams show between them
+        const float from = PolarHistogram::getAngleBinCentre(angle) - 0.5f * binDegrees;
+
+        juce::Path wedge;
+        wedge.addPieSegment(center.x - maxRadius, center.y - maxRadius, 2.0f * maxRadius, 2.0f * maxRadius,
+                            juce::degreesToRadians(from - 0.1f), juce::degreesToRadians(from + binDegrees + 0.1f), 0.0f);
+
+        g.setGradientFill(gradient);
+        g.fillPath(wedge);
+    }
+
+    // Readouts in the bottom-right corner
+    const juce::String degrees(juce::CharPointer_UTF8("\xc2\xb0"));
+    const int dominant = juce::roundToInt(polarFrame.dominantAngle);
+
+    const juce::String text = "DOMINANT " + juce::String(std::abs(dominant)) + degrees + (dominant < 0 ? " L" : (dominant > 0 ? " R" : ""))
+                                + "   SPREAD " + juce::String(juce::roundToInt(polarFrame.spread)) + degrees;
+
+    g.setColour(colour);
+    g.setFont(12.0f);
+    g.drawText(text, bounds.reduced(8.0f).removeFromBottom(16.0f), juce::Justification::centredRight);
 }
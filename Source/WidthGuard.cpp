@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    WidthGuard.cpp
+    Created: 19 Oct 2026 8:41:27pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "WidthGuard.h"
+
+namespace
+{
+    float onePoleCoefficient (double seconds, double sampleRate)
+    {
+        return static_cast<float>(1.0 - std::exp(-1.0 / (seconds * sampleRate)));
+    }
+}
+
+//==============================================================================
+WidthGuard::WidthGuard()
+{
+    setThreshold(0.0f);
+}
+
+WidthGuard::~WidthGuard()
+{
+}
+
+void WidthGuard::prepare (double sampleRate)
+{
+    jassert(sampleRate > 0.0);
+
+    sumCoefficient = onePoleCoefficient(windowSeconds, sampleRate);
+    attackCoefficient = onePoleCoefficient(attackSeconds, sampleRate);
+    releaseCoefficient = onePoleCoefficient(releaseSeconds, sampleRate);
+    reset();
+}
+
+void WidthGuard::reset()
+{
+    sumProduct = sumEnergy = 0.0f;
+    gain = lowestGain = 1.0f;
+}
+
+void WidthGuard::setThreshold (float newThreshold)
+{
+    // (1 - t) / (1 + t) from solving the correlation formula for g^2; kept
+    // away from +-1 so the guard never divides by zero or pins the width
+    const float threshold = juce::jlimit(-0.99f, 0.99f, newThreshold);
+    thresholdRatio = (1.0f - threshold) / (1.0f + threshold);
+}
+
+float WidthGuard::takeLowestGain() noexcept
+{
+    const float lowest = lowestGain;
+    lowestGain = gain;
+    return lowest;
+}
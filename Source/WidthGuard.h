@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    WidthGuard.h
+    Created: 19 Oct 2026 8:41:27pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Keeps the width stage from widening a signal past the point where it
+    falls apart in mono.
+
+    Short-term L.R, L^2 and R^2 are tracked on the audio thread with one-pole
+    running sums, which gives the signal's mid and side energy. With side gain
+    g the widened signal's correlation is (M - g^2 S) / (M + g^2 S), so the
+    largest g that keeps it above the threshold follows directly, one sample
+    at a time, without waiting for the result to be measured.
+
+    The guard only takes back width that was added: the side gain it returns
+    never drops below min (requested, 1).
+*/
+class WidthGuard
+{
+public:
+    WidthGuard();
+    ~WidthGuard();
+
+    void prepare (double sampleRate);
+    void reset();
+
+    // Minimum correlation to hold, -1 to 1
+    void setThreshold (float newThreshold);
+
+    // Feeds one input sample pair and returns the side gain to apply to it
+    template <typename SampleType>
+    SampleType process (SampleType left, SampleType right, SampleType requestedWidth) noexcept
+    {
+        const auto l = static_cast<float>(left);
+        const auto r = static_cast<float>(right);
+
+        sumProduct += sumCoefficient * (l * r - sumProduct);
+        sumEnergy += sumCoefficient * (l * l + r * r - sumEnergy);
+
+        float target = 1.0f;
+        const auto requested = static_cast<float>(requestedWidth);
+
+        if (requested > 1.0f)
+        {
+            // Four times the mid and side energy; the factor cancels below
+            const float midEnergy = juce::jmax(0.0f, sumEnergy + 2.0f * sumProduct);
+            const float sideEnergy = sumEnergy - 2.0f * sumProduct;
+
+            if (sideEnergy > 1.0e-9f)
+            {
+                const float maxWidthSquared = midEnergy * thresholdRatio / sideEnergy;
+
+                if (requested * requested > maxWidthSquared)
+                    target = juce::jmax(1.0f, std::sqrt(maxWidthSquared)) / requested;
+            }
+        }
+
+        gain += (target < gain ? attackCoefficient : releaseCoefficient) * (target - gain);
+        lowestGain = juce::jmin(lowestGain, gain);
+
+        return requestedWidth * static_cast<SampleType>(gain);
+    }
+
+    // The strongest reduction (as a side gain factor, 1 = none) since the last call
+    float takeLowestGain() noexcept;
+
+    // How long a freshly reset guard takes to converge on the state of one
+    // that has been running all along (a dozen of its slowest time constants)
+    static constexpr double getSettlingSeconds() noexcept { return 12.0 * (windowSeconds > releaseSeconds ? windowSeconds : releaseSeconds); }
+
+private:
+    static constexpr double windowSeconds = 0.05;
+    static constexpr double attackSeconds = 0.005;
+    static constexpr double releaseSeconds = 0.25;
+
+    float sumCoefficient = 1.0f;
+    float attackCoefficient = 1.0f;
+    float releaseCoefficient = 1.0f;
+    float thresholdRatio = 1.0f;
+
+    float sumProduct = 0.0f, sumEnergy = 0.0f;
+    float gain = 1.0f;
+    float lowestGain = 1.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WidthGuard)
+};
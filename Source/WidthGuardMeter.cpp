@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    WidthGuardMeter.cpp
+    Created: 19 Oct 2026 8:41:27pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#include "WidthGuardMeter.h"
+#include "TraceRecorder.h"
+
+//==============================================================================
+WidthGuardMeter::WidthGuardMeter()
+{
+}
+
+WidthGuardMeter::~WidthGuardMeter()
+{
+}
+
+void WidthGuardMeter::setGain (float newGain)
+{
+    // Only repaint for changes of a tenth of a dB or more
+    const float newReduction = juce::jlimit(0.0f, rangeDecibels, -juce::Decibels::gainToDecibels(newGain, -rangeDecibels));
+
+    if (std::abs(newReduction - reductionDecibels) < 0.1f && (newReduction > 0.0f) == (reductionDecibels > 0.0f))
+        return;
+
+    reductionDecibels = newReduction;
+    repaint();
+}
+
+void WidthGuardMeter::setGuardEnabled (bool shouldBeEnabled)
+{
+    if (guardEnabled == shouldBeEnabled)
+        return;
+
+    guardEnabled = shouldBeEnabled;
+    repaint();
+}
+
+void WidthGuardMeter::paint (juce::Graphics& g)
+{
+    IMAGINATION_TRACE_SCOPE("width guard meter paint");
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour(juce::Colours::black);
+    g.fillRoundedRectangle(bounds, 2.0f);
+
+    if (! guardEnabled || reductionDecibels <= 0.0f)
+        return;
+
+    const auto barHeight = bounds.getHeight() * reductionDecibels / rangeDecibels;
+    g.setColour(juce::Colours::orange);
+    g.fillRoundedRectangle(bounds.removeFromTop(barHeight), 2.0f);
+}
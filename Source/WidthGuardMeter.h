@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    WidthGuardMeter.h
+    Created: 19 Oct 2026 8:41:27pm
+    Author:  Adam Elhamami
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    A thin bar that grows downwards with the width guard's reduction, shown
+    next to the width slider.
+*/
+class WidthGuardMeter  : public juce::Component
+{
+public:
+    WidthGuardMeter();
+    ~WidthGuardMeter() override;
+
+    // Side gain factor reported by the processor, 1 = no reduction
+    void setGain (float newGain);
+    void setGuardEnabled (bool shouldBeEnabled);
+
+    void paint (juce::Graphics& g) override;
+
+private:
+    static constexpr float rangeDecibels = 12.0f;
+
+    float reductionDecibels = 0.0f;
+    bool guardEnabled = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WidthGuardMeter)
+};
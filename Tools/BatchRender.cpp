@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    BatchRender.cpp
+    Created: 20 Oct 2026 8:47:15pm
+    Author:  Adam Elhamami
+
+    Renders one file through many parameter sets in a single pass, for
+    preset auditioning and dataset generation (see BatchImager). Each set
+    comes from a preset file or is drawn at random; every one is written
+    to its own file.
+
+    Tools/BatchRender.jucer builds it, the same way as FrameBenchmark:
+
+        Projucer --resave Tools/BatchRender.jucer
+        make -C Tools/Builds/BatchRender/LinuxMakefile CONFIG=Release
+
+    Then:
+
+        ./imagination-batch-render in.wav --output-dir out/
+                                   [--state a.imgpreset --state b.imgpreset ...]
+                                   [--random 64 --seed 1] [--compare]
+
+    Writes out/NNN-name.wav as 32-bit float. --compare also renders every
+    set serially through processBlock and prints both timings and the
+    largest difference. The width guard, the transient split and binaural
+    mode are not rendered; sets that use them are listed with a warning.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BatchImager.h"
+#include "PluginProcessor.h"
+#include "PresetLibrary.h"
+
+#include <cstdio>
+
+namespace
+{
+    struct ParameterSet
+    {
+        juce::String name;
+        juce::ValueTree state;   // invalid for the defaults
+        int seed = -1;           // >= 0 for a random set
+    };
+
+    // Random sets vary the continuous parameters only; the switches keep
+    // their defaults so every set stays renderable by the batch
+    void randomise (ImaginationAudioProcessor& processor, juce::Random& random)
+    {
+        for (auto* parameter : processor.getParameters())
+            if (dynamic_cast<juce::AudioParameterFloat*>(parameter) != nullptr)
+                parameter->setValueNotifyingHost(random.nextFloat());
+    }
+
+    std::unique_ptr<ImaginationAudioProcessor> createProcessor (const ParameterSet& set)
+    {
+        auto processor = std::make_unique<ImaginationAudioProcessor>();
+
+        if (set.state.isValid())
+            processor->apvts.replaceState(set.state.createCopy());
+
+        if (set.seed >= 0)
+        {
+            juce::Random random(set.seed);
+            randomise(*processor, random);
+        }
+
+        return processor;
+    }
+
+    double secondsSince (juce::int64 startTicks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    const auto outputDirectoryName = getOption("--output-dir");
+
+    if (args.isEmpty() || args[0].startsWith("--") || outputDirectoryName.isEmpty())
+    {
+        std::fprintf(stderr, "usage: imagination-batch-render in.wav --output-dir dir [--state preset%s ...]"
+                             " [--random N] [--seed S] [--compare]\n", PresetLibrary::fileExtension);
+        return 2;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto inputFile = cwd.getChildFile(args[0]);
+    const auto outputDirectory = cwd.getChildFile(outputDirectoryName);
+    const bool compare = args.contains("--compare");
+
+    std::vector<ParameterSet> sets;
+
+    // Presets store the parameter state as XML, the same tree the plugin saves
+    for (int i = 0; i < args.size() - 1; ++i)
+    {
+        if (args[i] != "--state")
+            continue;
+
+        const auto file = cwd.getChildFile(args[i + 1]);
+        const auto xml = juce::parseXMLIfTagMatches(file, "ImaginationPreset");
+        const auto* parameters = xml != nullptr ? xml->getFirstChildElement() : nullptr;
+
+        if (parameters == nullptr)
+        {
+            std::fprintf(stderr, "could not read %s\n", args[i + 1].toRawUTF8());
+            return 2;
+        }
+
+        sets.push_back({ file.getFileNameWithoutExtension(), juce::ValueTree::fromXml(*parameters) });
+    }
+
+    const int numRandom = juce::jmax(0, getOption("--random").getIntValue());
+    const int seed = getOption("--seed").getIntValue();
+
+    for (int i = 0; i < numRandom; ++i)
+        sets.push_back({ "random-" + juce::String(seed + i), {}, seed + i });
+
+    if (sets.empty())
+        sets.push_back({ "default", {} });
+
+    // Resolve every set through a processor, so the batch sees exactly what
+    // processBlock would: the same parameter ranges and the same settings
+    std::vector<BatchImager::Configuration> configurations;
+
+    for (const auto& set : sets)
+    {
+        auto processor = createProcessor(set);
+        configurations.push_back({ processor->getImagerSettings(), processor->getStaticGain() });
+
+        if (BatchImager::hasUnsupportedStages(configurations.back().settings) || processor->getBinauralParam()->get())
+            std::fprintf(stderr, "warning: %s uses the width guard, transient split or binaural mode;"
+                                 " those stages are not rendered\n", set.name.toRawUTF8());
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(inputFile));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+    {
+        std::fprintf(stderr, "could not read %s\n", inputFile.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    const int numSamples = static_cast<int>(reader->lengthInSamples);
+    const double sampleRate = reader->sampleRate;
+
+    // Mono files feed both sides, as a host would on a stereo insert
+    juce::AudioBuffer<float> input(2, numSamples);
+    reader->read(&input, 0, numSamples, 0, true, true);
+
+    std::vector<juce::AudioBuffer<float>> outputs(sets.size());
+    for (auto& output : outputs)
+        output.setSize(2, numSamples);
+
+    BatchImager batch(configurations);
+    const auto batchStart = juce::Time::getHighResolutionTicks();
+    batch.process(input.getReadPointer(0), input.getReadPointer(1), numSamples, outputs);
+    const double batchSeconds = secondsSince(batchStart);
+
+    if (! outputDirectory.createDirectory())
+    {
+        std::fprintf(stderr, "could not create %s\n", outputDirectory.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    juce::WavAudioFormat wav;
+
+    for (size_t i = 0; i < sets.size(); ++i)
+    {
+        const auto file = outputDirectory.getChildFile(juce::String(static_cast<int>(i)).paddedLeft('0', 3) + "-"
+                                                       + juce::File::createLegalFileName(sets[i].name) + ".wav");
+        file.deleteFile();
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(file.createOutputStream().release(), sampleRate, 2, 32, {}, 0));
+
+        if (writer == nullptr || ! writer->writeFromAudioSampleBuffer(outputs[i], 0, numSamples))
+        {
+            std::fprintf(stderr, "could not write %s\n", file.getFullPathName().toRawUTF8());
+            return 2;
+        }
+    }
+
+    std::printf("%d set(s), %d samples: batch %.3f s\n", static_cast<int>(sets.size()), numSamples, batchSeconds);
+
+    if (! compare)
+        return 0;
+
+    // Serial reference: one realtime processor per set, in host-sized blocks,
+    // held at the full quality tier however long the blocks take
+    constexpr int blockSize = 512;
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer midi;
+    double serialSeconds = 0.0;
+    float maxDifference = 0.0f;
+
+    for (size_t i = 0; i < sets.size(); ++i)
+    {
+        auto processor = createProcessor(sets[i]);
+        processor->setAdaptiveQualityEnabled(false);
+        processor->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const int num = juce::jmin(blockSize, numSamples - start);
+            block.setSize(2, num, false, false, true);
+
+            for (int channel = 0; channel < 2; ++channel)
+                block.copyFrom(channel, 0, input, channel, start, num);
+
+            const auto blockStart = juce::Time::getHighResolutionTicks();
+            processor->processBlock(block, midi);
+            serialSeconds += secondsSince(blockStart);
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                const auto* expected = block.getReadPointer(channel);
+                const auto* actual = outputs[i].getReadPointer(channel, start);
+
+                for (int n = 0; n < num; ++n)
+                    maxDifference = juce::jmax(maxDifference, std::abs(expected[n] - actual[n]));
+            }
+        }
+
+        processor->releaseResources();
+    }
+
+    std::printf("serial processBlock %.3f s, %.1fx; max difference %.3g\n", serialSeconds,
+                batchSeconds > 0.0 ? serialSeconds / batchSeconds : 0.0, static_cast<double>(maxDifference));
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+    CaptureReplay.cpp
+    Created: 20 Oct 2026 4:02:19pm
+    Author:  Adam Elhamami
+
+    Plays a capture written by ProcessCapture back through a fresh
+    ImaginationAudioProcessor: the same prepare calls, the same block sizes
+    and the same parameter values, block for block. Run it under a profiler
+    to reproduce a spike seen in production.
+
+    Tools/CaptureReplay.jucer builds it, the same way as FrameBenchmark:
+
+        Projucer --resave Tools/CaptureReplay.jucer
+        make -C Tools/Builds/CaptureReplay/LinuxMakefile CONFIG=Release
+
+    Then:
+
+        ./imagination-capture-replay capture.imgcap [--output out.wav]
+                                     [--realtime] [--adaptive] [--repeat 10] [--memory]
+
+    --realtime paces blocks by their recorded timestamps instead of running
+    flat out. The quality governor is pinned to the full tier, so every
+    replay does the same work whatever the machine; --adaptive lets it step
+    down under load the way it does in a host. Prints per-block processing time percentiles and the slowest
+    blocks with their position in the capture. --memory also prints the
+    processor's memory report after the first run.
+
+    Built with IMAGINATION_ENABLE_TRACING=1 and run with
+    IMAGINATION_TRACE_FILE=trace.json, it also writes each processBlock
+    stage's spans as a Chrome trace, for chrome://tracing or ui.perfetto.dev.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "ProcessCapture.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct BlockTime
+    {
+        int block;
+        double ms;
+    };
+
+    struct ReplayResult
+    {
+        std::vector<BlockTime> times;
+        int numDropped = 0;
+        bool ok = true;
+        juce::String memoryReport;
+    };
+
+    ReplayResult replay (const juce::File& file, bool realtime, bool adaptive, juce::AudioFormatWriter* output)
+    {
+        ReplayResult result;
+        CaptureReader reader;
+
+        if (! reader.open(file))
+        {
+            result.ok = false;
+            return result;
+        }
+
+        ImaginationAudioProcessor processor;
+        processor.setAdaptiveQualityEnabled(adaptive);
+
+        // Capture order is getParameters() order, but map by ID in case the
+        // capture came from a different build
+        std::vector<juce::RangedAudioParameter*> parameters;
+
+        for (const auto& id : reader.getParameterIDs())
+        {
+            parameters.push_back(processor.apvts.getParameter(id));
+
+            if (parameters.back() == nullptr)
+                std::fprintf(stderr, "warning: parameter %s is not in this build\n", id.toRawUTF8());
+        }
+
+        CaptureReader::Record record;
+        juce::MidiBuffer midi;
+        bool prepared = false;
+        int blockIndex = 0;
+
+        const auto replayStart = juce::Time::getHighResolutionTicks();
+
+        while (reader.readNext(record))
+        {
+            if (record.type == CaptureReader::Record::Type::prepare)
+            {
+                processor.setNonRealtime(record.nonRealtime);
+                processor.setPlayConfigDetails(2, 2, record.sampleRate, record.maximumBlockSize);
+                processor.prepareToPlay(record.sampleRate, record.maximumBlockSize);
+                prepared = true;
+                continue;
+            }
+
+            if (record.type == CaptureReader::Record::Type::dropped)
+            {
+                result.numDropped += record.numDropped;
+                continue;
+            }
+
+            if (! prepared)
+                continue;
+
+            for (const auto& [index, value] : record.changes)
+                if (auto* parameter = parameters[static_cast<size_t>(index)])
+                    parameter->setValueNotifyingHost(value);
+
+            if (realtime)
+            {
+                const auto due = juce::Time::secondsToHighResolutionTicks(static_cast<double>(record.microseconds) * 1.0e-6);
+
+                while (juce::Time::getHighResolutionTicks() - replayStart < due)
+                    std::this_thread::yield();
+            }
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            processor.processBlock(record.audio, midi);
+            const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+
+            result.times.push_back({ blockIndex++, juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1000.0 });
+
+            if (output != nullptr)
+                output->writeFromAudioSampleBuffer(record.audio, 0, record.audio.getNumSamples());
+        }
+
+        result.memoryReport = processor.getMemoryReport();
+        processor.releaseResources();
+        return result;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+   #if IMAGINATION_ENABLE_TRACING
+    // One trace for the whole run, however many processors it creates
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;
+   #endif
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    if (args.isEmpty() || args[0].startsWith("--"))
+    {
+        std::fprintf(stderr, "usage: imagination-capture-replay capture%s [--output out.wav] [--realtime] [--adaptive] [--repeat N] [--memory]\n",
+                     ProcessCapture::fileExtension);
+        return 2;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto captureFile = cwd.getChildFile(args[0]);
+    const bool realtime = args.contains("--realtime");
+    const bool adaptive = args.contains("--adaptive");
+    const int repeats = getOption("--repeat").isNotEmpty() ? juce::jmax(1, getOption("--repeat").getIntValue()) : 1;
+
+    std::vector<BlockTime> allTimes;
+
+    for (int run = 0; run < repeats; ++run)
+    {
+        // Only the first run is written out; the rest are for the profiler
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+
+        if (auto path = getOption("--output"); path.isNotEmpty() && run == 0)
+        {
+            CaptureReader peek;
+            CaptureReader::Record first;
+
+            if (peek.open(captureFile) && peek.readNext(first) && first.type == CaptureReader::Record::Type::prepare)
+            {
+                const auto outputFile = cwd.getChildFile(path);
+                outputFile.deleteFile();
+                juce::WavAudioFormat wav;
+                writer.reset(wav.createWriterFor(outputFile.createOutputStream().release(), first.sampleRate, 2, 32, {}, 0));
+            }
+
+            if (writer == nullptr)
+            {
+                std::fprintf(stderr, "could not create %s\n", path.toRawUTF8());
+                return 2;
+            }
+        }
+
+        const auto result = replay(captureFile, realtime, adaptive, writer.get());
+
+        if (! result.ok)
+        {
+            std::fprintf(stderr, "could not read %s\n", captureFile.getFullPathName().toRawUTF8());
+            return 2;
+        }
+
+        if (run == 0 && result.numDropped > 0)
+            std::printf("warning: %d block(s) were dropped while capturing; output after the first gap will differ\n", result.numDropped);
+
+        if (run == 0 && args.contains("--memory"))
+            std::printf("%s", result.memoryReport.toRawUTF8());
+
+        allTimes.insert(allTimes.end(), result.times.begin(), result.times.end());
+    }
+
+    if (allTimes.empty())
+    {
+        std::printf("no blocks in capture\n");
+        return 0;
+    }
+
+    auto sorted = allTimes;
+    std::sort(sorted.begin(), sorted.end(), [](const BlockTime& a, const BlockTime& b) { return a.ms < b.ms; });
+
+    auto at = [&sorted](double p) { return sorted[static_cast<size_t>(juce::roundToInt(p * static_cast<double>(sorted.size() - 1)))].ms; };
+
+    std::printf("%zu blocks: p50 %.3f ms  p90 %.3f ms  p99 %.3f ms  max %.3f ms\n",
+                sorted.size(), at(0.5), at(0.9), at(0.99), sorted.back().ms);
+
+    std::printf("slowest blocks:\n");
+
+    for (size_t i = 0; i < juce::jmin<size_t>(10, sorted.size()); ++i)
+    {
+        const auto& slow = sorted[sorted.size() - 1 - i];
+        std::printf("  block %8d  %.3f ms\n", slow.block, slow.ms);
+    }
+
+    return 0;
+}
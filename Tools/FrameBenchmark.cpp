@@ -0,0 +1,326 @@
+/*
+  ==============================================================================
+
+    FrameBenchmark.cpp
+    Created: 19 Oct 2026 10:48:12pm
+    Author:  Adam Elhamami
+
+    Headless frame-time benchmark for the editor and its meters. Renders the
+    full ImaginationAudioProcessorEditor, the VisualizerComponent (in both
+    display modes) and the PhaseCorrelationMeter into offscreen software
+    images, at several sizes
+    and scale factors, while recorded audio runs through the same analysis
+    path the editor uses. Needs no display, so it runs on a Linux CI box.
+
+    Tools/FrameBenchmark.jucer builds it: a Projucer console app with the
+    plugin's JUCE modules, its sources and BinaryData, and the plugin
+    macros the processor reads. Each tool has its own .jucer and its own
+    folder under Tools/Builds. From the repository root:
+
+        Projucer --resave Tools/FrameBenchmark.jucer
+        make -C Tools/Builds/FrameBenchmark/LinuxMakefile CONFIG=Release
+        (or open Tools/Builds/FrameBenchmark/MacOSX in Xcode)
+
+        ./imagination-frame-benchmark [--input mix.wav] [--frames 300]
+                                      [--baseline Tools/FrameBenchmarkBaseline.json] [--tolerance 0.2]
+                                      [--write-baseline Tools/FrameBenchmarkBaseline.json]
+
+    Prints ms/frame percentiles per component and configuration. With
+    --baseline, exits with 1 if any median is more than `tolerance` slower
+    than the stored one. Frame times only compare on the same machine, so
+    the baseline is written on the machine that runs the check and
+    committed as Tools/FrameBenchmarkBaseline.json; rewrite it there
+    whenever the editor's drawing changes on purpose.
+
+    Built with IMAGINATION_ENABLE_TRACING=1 and run with
+    IMAGINATION_TRACE_FILE=trace.json, it also writes every paint routine's
+    spans as a Chrome trace, for chrome://tracing or ui.perfetto.dev.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "EditorAnalysis.h"
+#include "StereoAnalysisModel.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int warmUpFrames = 10;
+
+    struct Configuration
+    {
+        int width, height;
+        float scale;
+    };
+
+    const Configuration configurations[] = {
+        { 800, 500, 1.0f }, { 800, 500, 2.0f }, { 1200, 750, 1.0f }, { 1200, 750, 2.0f }
+    };
+
+    enum class Target { editor, visualizer, polar, meter };
+
+    const char* getTargetName (Target target)
+    {
+        switch (target)
+        {
+            case Target::editor:     return "editor";
+            case Target::visualizer: return "visualizer";
+            case Target::polar:      return "polar";
+            case Target::meter:      return "meter";
+        }
+
+        return "";
+    }
+
+    struct Percentiles
+    {
+        double p50 = 0.0, p90 = 0.0, p99 = 0.0;
+    };
+
+    Percentiles getPercentiles (std::vector<double> timesMs)
+    {
+        std::sort(timesMs.begin(), timesMs.end());
+
+        auto at = [&timesMs](double p) { return timesMs[static_cast<size_t>(juce::roundToInt(p * static_cast<double>(timesMs.size() - 1)))]; };
+        return { at(0.5), at(0.9), at(0.99) };
+    }
+
+    // A few seconds of material with moving width and level, for runs without --input
+    juce::AudioBuffer<float> makeTestSignal()
+    {
+        const int numSamples = juce::roundToInt(sampleRate * 10.0);
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        juce::Random random(1234);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = i / sampleRate;
+            const auto mid = static_cast<float>(0.5 * std::sin(2.0 * juce::MathConstants<double>::pi * 220.0 * t));
+            const auto side = static_cast<float>(0.3 * std::sin(2.0 * juce::MathConstants<double>::pi * 0.25 * t)) * (random.nextFloat() - 0.5f);
+            buffer.setSample(0, i, mid + side);
+            buffer.setSample(1, i, mid - side);
+        }
+
+        return buffer;
+    }
+
+    bool loadInput (const juce::File& file, juce::AudioBuffer<float>& buffer)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            return false;
+
+        const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(reader->lengthInSamples, std::numeric_limits<int>::max()));
+        buffer.setSize(2, numSamples);
+        reader->read(&buffer, 0, numSamples, 0, true, true);
+        return true;
+    }
+
+    //==============================================================================
+    // Renders one target for `numFrames` frames of one configuration. Each run
+    // starts the audio from the top with fresh analysis state, so every
+    // target sees the same sequence of frames.
+    std::vector<double> runTarget (ImaginationAudioProcessorEditor& editor, Target target, const Configuration& config,
+                                   const juce::AudioBuffer<float>& audio, int numFrames)
+    {
+        editor.setSize(config.width, config.height);
+
+        juce::Component* component = &editor;
+
+        if (target == Target::visualizer || target == Target::polar)
+            component = &editor.visualizer;
+        else if (target == Target::meter)
+            component = &editor.phaseCorrelationMeter;
+
+        StereoAnalysisModel model;
+        model.setSampleRate(sampleRate);
+        EditorAnalysis analysis(model, PhaseCorrelationMeter::readingsPerSecond, false);
+
+        const bool polar = target == Target::polar;
+        editor.visualizer.setDisplayMode(polar ? VisualizerComponent::DisplayMode::polar : VisualizerComponent::DisplayMode::lissajous);
+        analysis.setPolarEnabled(polar);
+
+        std::vector<juce::Point<float>> points;
+        PolarHistogram::Frame polarFrame;
+        std::array<float, 64> readings {};
+
+        juce::Image image(juce::Image::ARGB,
+                          juce::jmax(1, juce::roundToInt(component->getWidth() * config.scale)),
+                          juce::jmax(1, juce::roundToInt(component->getHeight() * config.scale)),
+                          true, juce::SoftwareImageType());
+
+        const int samplesPerFrame = juce::roundToInt(sampleRate / PhaseCorrelationMeter::readingsPerSecond);
+        int position = 0;
+
+        std::vector<double> timesMs;
+        timesMs.reserve(static_cast<size_t>(numFrames));
+
+        for (int frame = 0; frame < warmUpFrames + numFrames; ++frame)
+        {
+            // Feed one editor frame's worth of audio and collect the results,
+            // exactly as the editor's timer would
+            const int numSamples = juce::jmin(samplesPerFrame, audio.getNumSamples() - position);
+            model.pushSamples(audio.getReadPointer(0, position), audio.getReadPointer(1, position), numSamples);
+            position = (position + samplesPerFrame >= audio.getNumSamples()) ? 0 : position + samplesPerFrame;
+
+            analysis.runAnalysis(AnalysisScheduler::Priority::focused);
+
+            if (analysis.fetchVectorscope(points))
+                editor.visualizer.setStereoPoints(points);
+
+            if (analysis.fetchPolar(polarFrame))
+                editor.visualizer.setPolarFrame(polarFrame);
+
+            for (;;)
+            {
+                const int numReadings = analysis.fetchCorrelations(readings.data(), static_cast<int>(readings.size()));
+
+                if (numReadings == 0)
+                    break;
+
+                editor.phaseCorrelationMeter.addReadings(readings.data(), numReadings);
+            }
+
+            image.clear(image.getBounds());
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            {
+                juce::Graphics g(image);
+                g.addTransform(juce::AffineTransform::scale(config.scale));
+                component->paintEntireComponent(g, true);
+            }
+            const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+
+            // The first frames fill the shared image caches and are not counted
+            if (frame >= warmUpFrames)
+                timesMs.push_back(juce::Time::highResolutionTicksToSeconds(elapsedTicks) * 1000.0);
+        }
+
+        return timesMs;
+    }
+
+    juce::String getResultKey (Target target, const Configuration& config)
+    {
+        return juce::String(getTargetName(target)) + " " + juce::String(config.width) + "x" + juce::String(config.height)
+                 + "@" + juce::String(config.scale, 1);
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+   #if IMAGINATION_ENABLE_TRACING
+    // One trace for the whole run, however many processors it creates
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;
+   #endif
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    const int numFrames = getOption("--frames").isNotEmpty() ? juce::jmax(10, getOption("--frames").getIntValue()) : 300;
+    const double tolerance = getOption("--tolerance").isNotEmpty() ? getOption("--tolerance").getDoubleValue() : 0.2;
+
+    juce::AudioBuffer<float> audio;
+
+    if (auto input = getOption("--input"); input.isNotEmpty())
+    {
+        if (! loadInput(juce::File::getCurrentWorkingDirectory().getChildFile(input), audio))
+        {
+            std::fprintf(stderr, "could not read %s\n", input.toRawUTF8());
+            return 2;
+        }
+    }
+    else
+    {
+        audio = makeTestSignal();
+    }
+
+    auto results = std::make_unique<juce::DynamicObject>();
+
+    {
+        ImaginationAudioProcessor processor;
+        ImaginationAudioProcessorEditor editor(processor);
+
+        std::printf("%-28s %10s %10s %10s\n", "", "p50 ms", "p90 ms", "p99 ms");
+
+        for (const auto& config : configurations)
+        {
+            for (auto target : { Target::editor, Target::visualizer, Target::polar, Target::meter })
+            {
+                const auto p = getPercentiles(runTarget(editor, target, config, audio, numFrames));
+                const auto key = getResultKey(target, config);
+
+                std::printf("%-28s %10.3f %10.3f %10.3f\n", key.toRawUTF8(), p.p50, p.p90, p.p99);
+
+                auto entry = std::make_unique<juce::DynamicObject>();
+                entry->setProperty("p50", p.p50);
+                entry->setProperty("p90", p.p90);
+                entry->setProperty("p99", p.p99);
+                results->setProperty(key, juce::var(entry.release()));
+            }
+        }
+    }
+
+    const juce::var resultsVar(results.release());
+
+    if (auto path = getOption("--write-baseline"); path.isNotEmpty())
+        juce::File::getCurrentWorkingDirectory().getChildFile(path).replaceWithText(juce::JSON::toString(resultsVar));
+
+    if (auto path = getOption("--baseline"); path.isNotEmpty())
+    {
+        const auto baseline = juce::JSON::parse(juce::File::getCurrentWorkingDirectory().getChildFile(path));
+
+        if (! baseline.isObject())
+        {
+            std::fprintf(stderr, "could not read baseline %s\n", path.toRawUTF8());
+            return 2;
+        }
+
+        // Medians only: the tails are too noisy on shared machines to gate on
+        bool regressed = false;
+
+        for (const auto& property : resultsVar.getDynamicObject()->getProperties())
+        {
+            const auto stored = baseline[property.name];
+
+            if (! stored.isObject())
+                continue;
+
+            const double before = stored["p50"];
+            const double now = property.value["p50"];
+
+            if (before > 0.0 && now > before * (1.0 + tolerance))
+            {
+                std::printf("REGRESSION %s: p50 %.3f ms -> %.3f ms\n", property.name.toString().toRawUTF8(), before, now);
+                regressed = true;
+            }
+        }
+
+        return regressed ? 1 : 0;
+    }
+
+    return 0;
+}
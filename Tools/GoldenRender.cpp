@@ -0,0 +1,522 @@
+/*
+  ==============================================================================
+
+    GoldenRender.cpp
+    Created: 21 Oct 2026 3:12:40am
+    Author:  Adam Elhamami
+
+    Null test against stored reference renders. A fixed synthetic corpus
+    (sines, noise, impulses, an inverted-polarity pair and a mono-summed
+    pair) runs through a grid of parameter sets on three targets: the
+    StereoImager kernel on its own, ImaginationAudioProcessor in realtime
+    mode and ImaginationAudioProcessor in its offline configuration. Each
+    output is compared with its reference in Tools/GoldenRenders. The
+    realtime target has its quality governor pinned to the full tier, so a
+    loaded machine cannot change what it renders.
+
+    Tools/GoldenRender.jucer builds it, the same way as FrameBenchmark:
+
+        Projucer --resave Tools/GoldenRender.jucer
+        make -C Tools/Builds/GoldenRender/LinuxMakefile CONFIG=Release
+
+    Then, from the repository root:
+
+        ./imagination-golden-render [--references Tools/GoldenRenders]
+                                    [--target imager|processor|processor-offline]
+                                    [--bit-exact] [--tolerance -120] [--seed 1]
+                                    [--report report.txt] [--write]
+
+    By default every case runs in randomly sized blocks (1 to 1024 samples,
+    from --seed) and passes if the largest difference from its reference is
+    at or below --tolerance dBFS. --bit-exact instead runs the fixed
+    512-sample blocks the references were written with and fails on any
+    difference. Prints the null depth of every case and exits with 1 if
+    any case fails or has no reference.
+
+    Only the imager references are committed so far. A target with no
+    references at all is skipped with a note, unless it was asked for
+    with --target, in which case that is a failure; write its references
+    with --write --target <name> on the reference machine.
+
+    --write renders the references (in 512-sample blocks) for the selected
+    targets. The corpus comes from a generator of its own rather than
+    juce::Random, so it does not change with JUCE. References are written
+    on x86-64; other architectures may round differently (e.g. fused
+    multiply-adds), which shows up as a null depth far below the default
+    tolerance rather than as a failure.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "StereoImager.h"
+#include "Param.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 8192;
+    constexpr int referenceBlockSize = 512;
+    constexpr int maximumBlockSize = 1024;
+    constexpr double smoothingSeconds = 0.02;
+
+    // xorshift32, so the corpus and the block sizes are the same on every platform
+    struct Generator
+    {
+        explicit Generator (juce::uint32 seed) : state (seed != 0 ? seed : 1u) {}
+
+        juce::uint32 next() noexcept
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        // -1 to 1
+        float nextBipolar() noexcept   { return static_cast<float>(static_cast<double>(next()) / 2147483648.0 - 1.0); }
+
+        juce::uint32 state;
+    };
+
+    //==============================================================================
+    struct Signal
+    {
+        const char* name;
+        juce::AudioBuffer<float> audio;
+    };
+
+    std::vector<Signal> makeCorpus()
+    {
+        auto sine = [](double frequency, double phase, int i)
+        {
+            return static_cast<float>(0.5 * std::sin(2.0 * juce::MathConstants<double>::pi * frequency * i / sampleRate + phase));
+        };
+
+        std::vector<Signal> corpus;
+
+        auto add = [&corpus](const char* name) -> juce::AudioBuffer<float>&
+        {
+            corpus.push_back({ name, juce::AudioBuffer<float>(2, numSamples) });
+            corpus.back().audio.clear();
+            return corpus.back().audio;
+        };
+
+        auto& sines = add("sines");
+        for (int i = 0; i < numSamples; ++i)
+        {
+            sines.setSample(0, i, sine(440.0, 0.0, i));
+            sines.setSample(1, i, sine(1000.0, 0.3, i));
+        }
+
+        auto& noise = add("noise");
+        Generator noiseGenerator(1);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            noise.setSample(0, i, 0.5f * noiseGenerator.nextBipolar());
+            noise.setSample(1, i, 0.5f * noiseGenerator.nextBipolar());
+        }
+
+        // Left, right and both in turn
+        auto& impulses = add("impulses");
+        for (int i = 0, n = 0; i < numSamples; i += 1024, ++n)
+        {
+            if (n % 3 != 1) impulses.setSample(0, i, 0.9f);
+            if (n % 3 != 0) impulses.setSample(1, i, 0.9f);
+        }
+
+        auto& inverted = add("inverted");
+        Generator invertedGenerator(2);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = 0.5f * invertedGenerator.nextBipolar();
+            inverted.setSample(0, i, x);
+            inverted.setSample(1, i, -x);
+        }
+
+        auto& mono = add("mono");
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = 0.5f * (sine(440.0, 0.0, i) + sine(1000.0, 0.3, i));
+            mono.setSample(0, i, x);
+            mono.setSample(1, i, x);
+        }
+
+        return corpus;
+    }
+
+    //==============================================================================
+    // Plain parameter values by ID; anything not listed keeps its default
+    using Parameters = std::map<juce::String, float>;
+
+    struct ParameterSet
+    {
+        const char* name;
+        Parameters parameters;
+        Parameters automation;       // applied at automationSample, if any
+        bool processorOnly = false;  // stages the imager does not have
+    };
+
+    constexpr int automationSample = numSamples / 2;
+
+    std::vector<ParameterSet> makeGrid()
+    {
+        using namespace ParamIDs;
+
+        return {
+            { "neutral",   {} },
+            { "narrow",    { { width, 0.0f } } },
+            { "wide",      { { width, 100.0f } } },
+            { "balance-ms", { { width, 70.0f }, { balance, -0.4f }, { midSide, 0.3f } } },
+            { "crossfeed-exciter", { { crossfeed, 0.4f }, { exciterEnhancer, 40.0f } } },
+            { "guard",     { { width, 100.0f }, { widthGuard, 1.0f }, { widthGuardThreshold, 0.2f } } },
+            { "split",     { { width, 80.0f }, { exciterEnhancer, 10.0f }, { transientSplit, 1.0f },
+                             { transientWidth, 20.0f }, { transientExciter, 30.0f } } },
+            { "automation", {}, { { width, 90.0f }, { balance, 0.3f }, { midSide, -0.2f },
+                                  { crossfeed, 0.2f }, { exciterEnhancer, 25.0f } } },
+            { "binaural",  { { binaural, 1.0f }, { binauralAngle, 45.0f } }, {}, true }
+        };
+    }
+
+    float getValue (const Parameters& parameters, const char* id, float defaultValue)
+    {
+        const auto found = parameters.find(id);
+        return found != parameters.end() ? found->second : defaultValue;
+    }
+
+    // What ImaginationAudioProcessor::getImagerSettings makes of these values,
+    // without the parameters' own rounding to their intervals
+    StereoImagerSettings getImagerSettings (const Parameters& parameters)
+    {
+        using namespace ParamIDs;
+
+        auto settings = StereoImager::makeSettings(getValue(parameters, width, 50.0f), getValue(parameters, balance, 0.0f),
+                                                   getValue(parameters, midSide, 0.0f), getValue(parameters, crossfeed, 0.0f),
+                                                   getValue(parameters, exciterEnhancer, 0.0f));
+        settings.widthGuard = getValue(parameters, widthGuard, 0.0f) > 0.5f;
+        settings.widthGuardThreshold = getValue(parameters, widthGuardThreshold, 0.0f);
+        settings.transientSplit = getValue(parameters, transientSplit, 0.0f) > 0.5f;
+        settings.transientWidthFactor = StereoImager::widthFactorFor(getValue(parameters, transientWidth, 50.0f));
+        settings.transientExciterAmount = getValue(parameters, transientExciter, 0.0f) * 0.01f;
+        return settings;
+    }
+
+    void setParameters (ImaginationAudioProcessor& processor, const Parameters& parameters)
+    {
+        for (const auto& [id, value] : parameters)
+            if (auto* parameter = processor.apvts.getParameter(id))
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    //==============================================================================
+    enum class Target { imager, processor, processorOffline };
+
+    const char* getTargetName (Target target)
+    {
+        switch (target)
+        {
+            case Target::imager:           return "imager";
+            case Target::processor:        return "processor";
+            case Target::processorOffline: return "processor-offline";
+        }
+
+        return "";
+    }
+
+    // Block sizes for one render: fixed, or random from the seed. Blocks never
+    // straddle the automation point, so it lands on the same sample either way.
+    std::vector<int> makeBlockSizes (bool randomSizes, juce::uint32 seed)
+    {
+        std::vector<int> sizes;
+        Generator generator(seed);
+
+        for (int position = 0; position < numSamples;)
+        {
+            int size = randomSizes ? 1 + static_cast<int>(generator.next() % maximumBlockSize) : referenceBlockSize;
+            size = juce::jmin(size, numSamples - position);
+
+            if (position < automationSample)
+                size = juce::jmin(size, automationSample - position);
+
+            sizes.push_back(size);
+            position += size;
+        }
+
+        return sizes;
+    }
+
+    juce::AudioBuffer<float> render (Target target, const juce::AudioBuffer<float>& input, const ParameterSet& set,
+                                     const std::vector<int>& blockSizes)
+    {
+        juce::AudioBuffer<float> output(input);
+        int position = 0;
+
+        if (target == Target::imager)
+        {
+            std::vector<float> transientWeights(maximumBlockSize);
+            StereoImager imager;
+            imager.prepare(sampleRate, sampleRate, transientWeights.data(), maximumBlockSize, smoothingSeconds, false);
+            imager.setSettings(getImagerSettings(set.parameters));
+            imager.reset();
+
+            for (const int size : blockSizes)
+            {
+                if (position == automationSample && ! set.automation.empty())
+                {
+                    auto changed = set.parameters;
+
+                    for (const auto& [id, value] : set.automation)
+                        changed[id] = value;
+
+                    imager.setSettings(getImagerSettings(changed));
+                }
+
+                juce::dsp::AudioBlock<float> block(output.getArrayOfWritePointers(), 2, static_cast<size_t>(position), static_cast<size_t>(size));
+                imager.process(juce::dsp::ProcessContextReplacing<float>(block));
+                position += size;
+            }
+
+            return output;
+        }
+
+        ImaginationAudioProcessor processor;
+        setParameters(processor, set.parameters);
+        processor.setNonRealtime(target == Target::processorOffline);
+        processor.setAdaptiveQualityEnabled(false);
+        processor.setPlayConfigDetails(2, 2, sampleRate, maximumBlockSize);
+        processor.prepareToPlay(sampleRate, maximumBlockSize);
+
+        // Offline renders are delayed by the oversampler; the reference
+        // includes that delay, so nothing is compensated here
+        juce::MidiBuffer midi;
+
+        for (const int size : blockSizes)
+        {
+            if (position == automationSample)
+                setParameters(processor, set.automation);
+
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), 2, position, size);
+            processor.processBlock(block, midi);
+            position += size;
+        }
+
+        processor.releaseResources();
+        return output;
+    }
+
+    //==============================================================================
+    bool readReference (const juce::File& file, juce::AudioBuffer<float>& reference)
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+
+        if (reader == nullptr || reader->numChannels != 2 || reader->lengthInSamples != numSamples)
+            return false;
+
+        reference.setSize(2, numSamples);
+        return reader->read(&reference, 0, numSamples, 0, true, true);
+    }
+
+    bool writeReference (const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        file.deleteFile();
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(file.createOutputStream().release(), sampleRate, 2, 32, {}, 0));
+        return writer != nullptr && writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+    }
+
+    struct Difference
+    {
+        float maximum = 0.0f;
+        int numDiffering = 0;
+        int firstDiffering = -1;
+
+        // Peak of the difference signal, dBFS
+        double getNullDepth() const { return maximum > 0.0f ? 20.0 * std::log10(static_cast<double>(maximum)) : -std::numeric_limits<double>::infinity(); }
+    };
+
+    Difference compare (const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& output)
+    {
+        Difference difference;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            bool differs = false;
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                const float a = reference.getSample(channel, i);
+                const float b = output.getSample(channel, i);
+
+                if (a != b)
+                {
+                    differs = true;
+                    difference.maximum = juce::jmax(difference.maximum, std::abs(a - b));
+                }
+            }
+
+            if (differs && difference.numDiffering++ == 0)
+                difference.firstDiffering = i;
+        }
+
+        return difference;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto referenceDirectory = cwd.getChildFile(getOption("--references").isNotEmpty() ? getOption("--references") : "Tools/GoldenRenders");
+    const bool write = args.contains("--write");
+    const bool bitExact = args.contains("--bit-exact");
+    const double tolerance = getOption("--tolerance").isNotEmpty() ? getOption("--tolerance").getDoubleValue() : -120.0;
+    const auto seed = static_cast<juce::uint32>(getOption("--seed").isNotEmpty() ? getOption("--seed").getIntValue() : 1);
+    const auto targetName = getOption("--target");
+
+    std::vector<Target> targets;
+
+    for (auto target : { Target::imager, Target::processor, Target::processorOffline })
+        if (targetName.isEmpty() || targetName == getTargetName(target))
+            targets.push_back(target);
+
+    if (targets.empty())
+    {
+        std::fprintf(stderr, "usage: imagination-golden-render [--references dir] [--target imager|processor|processor-offline]"
+                             " [--bit-exact] [--tolerance dB] [--seed N] [--report file] [--write]\n");
+        return 2;
+    }
+
+    if (write && ! referenceDirectory.createDirectory())
+    {
+        std::fprintf(stderr, "could not create %s\n", referenceDirectory.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    // A target nobody has written references for yet says so once, rather
+    // than failing every one of its cases
+    int numSkippedTargets = 0;
+
+    if (! write)
+    {
+        targets.erase(std::remove_if(targets.begin(), targets.end(), [&](Target target)
+        {
+            const auto pattern = juce::String(getTargetName(target)) + "_*.wav";
+
+            if (targetName.isNotEmpty() || referenceDirectory.getNumberOfChildFiles(juce::File::findFiles, pattern) > 0)
+                return false;
+
+            std::printf("skipping %s: no references in %s (write them with --write --target %s)\n", getTargetName(target),
+                        referenceDirectory.getFullPathName().toRawUTF8(), getTargetName(target));
+            ++numSkippedTargets;
+            return true;
+        }), targets.end());
+
+        if (targets.empty())
+        {
+            std::fprintf(stderr, "nothing to compare: %s has no references\n", referenceDirectory.getFullPathName().toRawUTF8());
+            return 1;
+        }
+    }
+
+    const auto corpus = makeCorpus();
+    const auto grid = makeGrid();
+
+    juce::String report;
+    report << juce::String::formatted("%-18s %-10s %-18s %12s %10s %10s  %s\n",
+                                      "TARGET", "SIGNAL", "PARAMETERS", "NULL dBFS", "DIFFERING", "FIRST", "RESULT");
+
+    int numCases = 0, numFailed = 0, numMissing = 0;
+    juce::uint32 caseIndex = 0;
+
+    for (const auto target : targets)
+    {
+        for (const auto& signal : corpus)
+        {
+            for (const auto& set : grid)
+            {
+                if (set.processorOnly && target == Target::imager)
+                    continue;
+
+                ++caseIndex;
+                const auto file = referenceDirectory.getChildFile(juce::String(getTargetName(target)) + "_" + signal.name + "_" + set.name + ".wav");
+
+                if (write)
+                {
+                    if (! writeReference(file, render(target, signal.audio, set, makeBlockSizes(false, 0))))
+                    {
+                        std::fprintf(stderr, "could not write %s\n", file.getFullPathName().toRawUTF8());
+                        return 2;
+                    }
+
+                    ++numCases;
+                    continue;
+                }
+
+                ++numCases;
+                juce::AudioBuffer<float> reference;
+
+                if (! readReference(file, reference))
+                {
+                    ++numMissing;
+                    report << juce::String::formatted("%-18s %-10s %-18s %12s %10s %10s  %s\n", getTargetName(target), signal.name, set.name,
+                                                      "-", "-", "-", "NO REFERENCE");
+                    continue;
+                }
+
+                // Each case gets its own block sizes, reproducible from the seed
+                const auto blockSizes = makeBlockSizes(! bitExact, seed * 7919u + caseIndex);
+                const auto difference = compare(reference, render(target, signal.audio, set, blockSizes));
+                const bool passed = bitExact ? difference.numDiffering == 0 : difference.getNullDepth() <= tolerance;
+
+                if (! passed)
+                    ++numFailed;
+
+                const auto depth = difference.numDiffering == 0 ? juce::String("exact") : juce::String(difference.getNullDepth(), 1);
+                report << juce::String::formatted("%-18s %-10s %-18s %12s %10d %10d  %s\n", getTargetName(target), signal.name, set.name,
+                                                  depth.toRawUTF8(), difference.numDiffering, difference.firstDiffering,
+                                                  passed ? "ok" : "FAILED");
+            }
+        }
+    }
+
+    if (write)
+    {
+        std::printf("wrote %d reference(s) to %s\n", numCases, referenceDirectory.getFullPathName().toRawUTF8());
+        return 0;
+    }
+
+    report << juce::String::formatted("\n%d case(s), %s blocks: %d failed, %d without a reference (%s)\n", numCases,
+                                      bitExact ? "512-sample" : "random", numFailed, numMissing,
+                                      bitExact ? "bit-exact" : (juce::String("tolerance ") + juce::String(tolerance, 1) + " dBFS").toRawUTF8());
+
+    if (numSkippedTargets > 0)
+        report << numSkippedTargets << " target(s) skipped for want of references" << juce::newLine;
+
+    std::printf("%s", report.toRawUTF8());
+
+    if (auto path = getOption("--report"); path.isNotEmpty())
+        cwd.getChildFile(path).replaceWithText(report);
+
+    return (numFailed > 0 || numMissing > 0) ? 1 : 0;
+}
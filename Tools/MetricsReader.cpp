@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    MetricsReader.cpp
+    Created: 19 Oct 2026 4:26:10pm
+    Author:  Adam Elhamami
+
+    Lists every live plugin instance publishing into the shared metrics
+    segment. Plain POSIX, no JUCE:
+
+        c++ -std=c++17 -O2 -I Source Tools/MetricsReader.cpp -o imagination-metrics
+        ./imagination-metrics [--watch]
+
+    (add -lrt on older Linux toolchains)
+
+  ==============================================================================
+*/
+
+#include "MetricsSegment.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+using namespace ImaginationMetrics;
+
+static std::uint64_t nowMs()
+{
+    using namespace std::chrono;
+    return static_cast<std::uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+static float toDecibels(float gain)
+{
+    return gain > 0.0f ? 20.0f * std::log10(gain) : -100.0f;
+}
+
+// Matches QualityGovernor::getTierName, which this tool cannot include
+static const char* getQualityTierName(std::uint32_t tier)
+{
+    static const char* const names[] = { "FULL", "REDUCED", "MINIMAL" };
+    return tier < 3 ? names[tier] : "?";
+}
+
+static bool isProcessAlive(std::int32_t pid)
+{
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+static void printInstances(Segment& segment)
+{
+    const auto now = nowMs();
+    segment.header.lastReaderPollMs.store(now, std::memory_order_relaxed);
+
+    std::printf("%-8s %-24s %8s %7s %8s %9s %7s %8s %8s %9s %9s\n",
+                "PID", "INSTANCE", "RATE", "CPU%", "QUALITY", "OVERRUNS", "CORR", "PEAK L", "PEAK R", "RMS L", "RMS R");
+
+    int numLive = 0, numStale = 0;
+
+    for (auto& slot : segment.slots)
+    {
+        if (slot.state.load(std::memory_order_acquire) != slotLive)
+            continue;
+
+        const auto pid = slot.ownerPid.load(std::memory_order_relaxed);
+        char name[maxNameLength + 1] = {};
+        std::memcpy(name, slot.name, maxNameLength);
+
+        Payload p;
+
+        if (! readPayload(slot, p))
+            continue;
+
+        if (! isProcessAlive(pid))
+        {
+            ++numStale;
+            std::printf("%-8d %-24s (stale: owning process has exited; the next instance reclaims it)\n", pid, name);
+            continue;
+        }
+
+        ++numLive;
+
+        const bool isIdle = p.timestampMs == 0 || now - p.timestampMs > readerTimeoutMs;
+
+        std::printf("%-8d %-24s %8.0f %7.1f %8s %9llu %7.2f %8.1f %8.1f %9.1f %9.1f%s\n",
+                    pid, name, p.sampleRate, p.cpuLoad * 100.0f,
+                    getQualityTierName(p.qualityTier), static_cast<unsigned long long>(p.numOverruns), p.correlation,
+                    toDecibels(p.peakLeft), toDecibels(p.peakRight),
+                    toDecibels(p.rmsLeft), toDecibels(p.rmsRight),
+                    isIdle ? "  (idle)" : "");
+    }
+
+    std::printf("%d instance(s), %d stale slot(s)\n\n", numLive, numStale);
+}
+
+// Returns false on an error worth stopping for; segment stays nullptr if
+// no instance has created one
+static bool openSegment(Segment*& segment)
+{
+    segment = nullptr;
+    const int fd = shm_open(segmentName, O_RDWR, 0);
+
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+            return true;
+
+        std::fprintf(stderr, "%s: %s\n", segmentName, std::strerror(errno));
+        return false;
+    }
+
+    struct stat info {};
+
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Segment)))
+    {
+        std::fprintf(stderr, "%s has an unexpected size\n", segmentName);
+        close(fd);
+        return false;
+    }
+
+    auto* address = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (address == MAP_FAILED)
+    {
+        std::perror("mmap");
+        return false;
+    }
+
+    auto* mapped = static_cast<Segment*>(address);
+
+    if (mapped->header.magic.load(std::memory_order_acquire) != segmentMagic
+         || mapped->header.version != segmentVersion)
+    {
+        std::fprintf(stderr, "%s was written by an incompatible plugin version\n", segmentName);
+        munmap(address, sizeof(Segment));
+        return false;
+    }
+
+    // The first poll only wakes the writers up, so give them a moment to fill in levels
+    mapped->header.lastReaderPollMs.store(nowMs(), std::memory_order_relaxed);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    segment = mapped;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    const bool watch = argc > 1 && std::strcmp(argv[1], "--watch") == 0;
+
+    Segment* segment = nullptr;
+
+    if (! openSegment(segment))
+        return 1;
+
+    for (;;)
+    {
+        // The last instance to unload removed the segment; a new one is
+        // created when the next instance loads
+        if (segment != nullptr && segment->header.unlinked.load(std::memory_order_relaxed) != 0)
+        {
+            munmap(segment, sizeof(Segment));
+
+            if (! openSegment(segment))
+                return 1;
+        }
+
+        if (segment != nullptr)
+            printInstances(*segment);
+        else
+            std::printf("No instances running (%s not found)\n\n", segmentName);
+
+        if (! watch)
+            break;
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        if (segment == nullptr && ! openSegment(segment))
+            return 1;
+    }
+
+    if (segment != nullptr)
+        munmap(segment, sizeof(Segment));
+
+    return 0;
+}
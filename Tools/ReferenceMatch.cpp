@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+
+    ReferenceMatch.cpp
+    Created: 21 Oct 2026 1:02:19am
+    Author:  Adam Elhamami
+
+    Analyses a reference and a target (files or folders of them, e.g. two
+    versions of an album) and saves a user preset whose width and mid/side
+    move the target's stereo image toward the reference's (see
+    ReferenceMatcher). The preset shows up in the plugin's browser.
+
+    Tools/ReferenceMatch.jucer builds it, the same way as FrameBenchmark:
+
+        Projucer --resave Tools/ReferenceMatch.jucer
+        make -C Tools/Builds/ReferenceMatch/LinuxMakefile CONFIG=Release
+
+    Then:
+
+        ./imagination-reference-match --reference master/ --target mix/
+                                      [--name "Match Master"] [--state base.imgpreset]
+                                      [--threads N] [--dry-run]
+
+    --reference and --target can be repeated. Prints each band's image
+    before and after, and the width each band would want on its own.
+    --state takes balance, crossfeed and the rest from a preset; --dry-run
+    prints the match without saving it.
+
+        ./imagination-reference-match --self-check [--minutes 60] [--threads N]
+
+    runs a reproducible check instead. It writes a stand-in album of noise
+    to the temp folder, where the target is the reference with half its
+    side level, and matches the two. Then it prints the analysis time and
+    checks the match: width 100 % (side gain 2) and no mid/side. The error
+    before matching must be 6.02 dB from neutral settings, and 2.50 dB
+    from a base at width 75 %. The error after must be about zero. Exits
+    with 1 if any of that is off.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "ReferenceMatcher.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    // Folders contribute every audio file in them, in name order
+    bool collectFiles (const juce::StringArray& args, const char* option, const juce::String& wildcard, juce::Array<juce::File>& files)
+    {
+        const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+        for (int i = 0; i < args.size() - 1; ++i)
+        {
+            if (args[i] != option)
+                continue;
+
+            const auto path = cwd.getChildFile(args[i + 1]);
+
+            if (path.isDirectory())
+            {
+                auto found = path.findChildFiles(juce::File::findFiles, false, wildcard);
+                found.sort();
+                files.addArray(found);
+            }
+            else if (path.existsAsFile())
+            {
+                files.add(path);
+            }
+            else
+            {
+                std::fprintf(stderr, "%s does not exist\n", path.getFullPathName().toRawUTF8());
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void setParameter (juce::AudioParameterFloat& parameter, float value)
+    {
+        parameter.setValueNotifyingHost(parameter.convertTo0to1(value));
+    }
+
+    //==============================================================================
+    // --self-check's album: uncorrelated mid and side noise, with the side
+    // at sideGain. The same seed gives the same mid and side on both sides.
+    bool writeNoiseTrack (const juce::File& file, int seed, float sideGain, int numSamples, double sampleRate)
+    {
+        file.deleteFile();
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(file.createOutputStream().release(), sampleRate, 2, 24, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        juce::Random random(seed);
+        juce::AudioBuffer<float> block(2, 4096);
+
+        for (int start = 0; start < numSamples; start += block.getNumSamples())
+        {
+            const int num = juce::jmin(block.getNumSamples(), numSamples - start);
+
+            for (int i = 0; i < num; ++i)
+            {
+                const float mid = 0.4f * (random.nextFloat() - 0.5f);
+                const float side = sideGain * 0.4f * (random.nextFloat() - 0.5f);
+                block.setSample(0, i, mid + side);
+                block.setSample(1, i, mid - side);
+            }
+
+            if (! writer->writeFromAudioSampleBuffer(block, 0, num))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool isNear (double value, double expected, double tolerance)
+    {
+        return std::abs(value - expected) <= tolerance;
+    }
+
+    int runSelfCheck (double minutes, const ReferenceMatcher::Options& options)
+    {
+        constexpr int numTracks = 4;
+        constexpr double trackSeconds = 30.0;
+        constexpr double sampleRate = 48000.0;
+
+        const auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("imagination-reference-self-check");
+        folder.deleteRecursively();
+
+        if (! folder.createDirectory())
+        {
+            std::fprintf(stderr, "could not create %s\n", folder.getFullPathName().toRawUTF8());
+            return 2;
+        }
+
+        // A long album lists the same few tracks over and over, so it costs
+        // little disk; every listing is still read and analysed in full
+        juce::Array<juce::File> referenceTracks, targetTracks;
+
+        for (int track = 0; track < numTracks; ++track)
+        {
+            const auto reference = folder.getChildFile("reference-" + juce::String(track) + ".wav");
+            const auto target = folder.getChildFile("target-" + juce::String(track) + ".wav");
+            const int numSamples = static_cast<int>(trackSeconds * sampleRate);
+
+            if (! writeNoiseTrack(reference, track + 1, 0.5f, numSamples, sampleRate)
+                 || ! writeNoiseTrack(target, track + 1, 0.25f, numSamples, sampleRate))
+            {
+                std::fprintf(stderr, "could not write the self-check tracks to %s\n", folder.getFullPathName().toRawUTF8());
+                folder.deleteRecursively();
+                return 2;
+            }
+
+            referenceTracks.add(reference);
+            targetTracks.add(target);
+        }
+
+        juce::Array<juce::File> referenceFiles, targetFiles;
+        const int numListings = juce::jmax(1, juce::roundToInt(minutes * 60.0 / trackSeconds));
+
+        for (int i = 0; i < numListings; ++i)
+        {
+            referenceFiles.add(referenceTracks[i % numTracks]);
+            targetFiles.add(targetTracks[i % numTracks]);
+        }
+
+        juce::WavAudioFormat wav;
+
+        auto openFile = [&wav](const juce::File& file)
+        {
+            return std::unique_ptr<juce::AudioFormatReader>(wav.createReaderFor(file.createInputStream().release(), true));
+        };
+
+        ReferenceMatcher matcher(options);
+        const auto result = matcher.analyse(referenceFiles, targetFiles, openFile, StereoImagerSettings());
+        folder.deleteRecursively();
+
+        if (! result.succeeded)
+        {
+            std::fprintf(stderr, "analysis failed: %s\n", result.error.toRawUTF8());
+            return 2;
+        }
+
+        const auto audioSeconds = result.reference.seconds + result.target.seconds;
+        std::printf("reference and target: %.1f min each, analysed in %.2f s (%.0fx realtime)\n",
+                    result.reference.seconds / 60.0, result.elapsedSeconds,
+                    result.elapsedSeconds > 0.0 ? audioSeconds / result.elapsedSeconds : 0.0);
+
+        // The same profiles from a base that is already partly wide: the
+        // match must not move, and "before" must start from the base
+        const auto widerBase = StereoImager::makeSettings(75.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        const auto fromWiderBase = ReferenceMatcher::match(result.reference, result.target, widerBase);
+
+        bool passed = true;
+
+        auto check = [&passed](const char* name, const ReferenceMatcher::Match& match, double expectedBefore)
+        {
+            const bool ok = isNear(match.widthPercent, 100.0, 0.25) && isNear(match.midSide, 0.0, 0.01)
+                             && isNear(match.errorBeforeDecibels, expectedBefore, 0.05) && match.errorAfterDecibels <= 0.05;
+
+            std::printf("%-16s width %.2f %%, mid/side %.2f: side/mid error %.2f dB -> %.2f dB (expected 100 %%, 0, %.2f dB -> 0) %s\n",
+                        name, static_cast<double>(match.widthPercent), static_cast<double>(match.midSide),
+                        match.errorBeforeDecibels, match.errorAfterDecibels, expectedBefore, ok ? "ok" : "FAILED");
+
+            passed = passed && ok;
+        };
+
+        check("neutral base", result.match, 20.0 * std::log10(2.0));
+        check("base width 75 %", fromWiderBase, 20.0 * std::log10(2.0 / 1.5));
+
+        return passed ? 0 : 1;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    if (args.contains("--self-check"))
+    {
+        ReferenceMatcher::Options options;
+
+        if (auto value = getOption("--threads"); value.isNotEmpty())
+            options.numThreads = juce::jmax(1, value.getIntValue());
+
+        const auto minutes = getOption("--minutes").isNotEmpty() ? juce::jmax(0.5, getOption("--minutes").getDoubleValue()) : 60.0;
+        return runSelfCheck(minutes, options);
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    juce::Array<juce::File> referenceFiles, targetFiles;
+
+    if (! collectFiles(args, "--reference", formats.getWildcardForAllFormats(), referenceFiles)
+         || ! collectFiles(args, "--target", formats.getWildcardForAllFormats(), targetFiles))
+        return 2;
+
+    if (referenceFiles.isEmpty() || targetFiles.isEmpty())
+    {
+        std::fprintf(stderr, "usage: imagination-reference-match --reference file-or-dir --target file-or-dir"
+                             " [--name name] [--state preset%s] [--threads N] [--dry-run]\n"
+                             "       imagination-reference-match --self-check [--minutes M] [--threads N]\n", PresetLibrary::fileExtension);
+        return 2;
+    }
+
+    auto processor = std::make_unique<ImaginationAudioProcessor>();
+
+    // Presets store the parameter state as XML, the same tree the plugin saves
+    if (auto path = getOption("--state"); path.isNotEmpty())
+    {
+        const auto xml = juce::parseXMLIfTagMatches(juce::File::getCurrentWorkingDirectory().getChildFile(path), "ImaginationPreset");
+        const auto* parameters = xml != nullptr ? xml->getFirstChildElement() : nullptr;
+
+        if (parameters == nullptr)
+        {
+            std::fprintf(stderr, "could not read %s\n", path.toRawUTF8());
+            return 2;
+        }
+
+        processor->apvts.replaceState(juce::ValueTree::fromXml(*parameters));
+    }
+
+    ReferenceMatcher::Options options;
+
+    if (auto value = getOption("--threads"); value.isNotEmpty())
+        options.numThreads = juce::jmax(1, value.getIntValue());
+
+    auto openFile = [&formats](const juce::File& file)
+    {
+        return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+    };
+
+    ReferenceMatcher matcher(options);
+    const auto result = matcher.analyse(referenceFiles, targetFiles, openFile, processor->getImagerSettings());
+
+    if (! result.succeeded)
+    {
+        std::fprintf(stderr, "analysis failed: %s\n", result.error.toRawUTF8());
+        return 2;
+    }
+
+    std::printf("reference: %d file(s), %.1f s; target: %d file(s), %.1f s; analysed in %.2f s\n\n",
+                result.reference.numFiles, result.reference.seconds, result.target.numFiles, result.target.seconds,
+                result.elapsedSeconds);
+
+    std::printf("    band   side/mid dB: reference  target  matched   correlation: reference  target  matched   own width\n");
+
+    for (size_t band = 0; band < static_cast<size_t>(ReferenceMatcher::numBands); ++band)
+    {
+        const auto& r = result.reference.bands[band];
+        const auto& t = result.target.bands[band];
+        const auto& m = result.match.matched.bands[band];
+
+        std::printf("%6.0f Hz %21.1f %7.1f %8.1f %23.2f %7.2f %8.2f %10.1f %%%s\n",
+                    ReferenceMatcher::bandStarts[band], r.getSideToMidDecibels(), t.getSideToMidDecibels(), m.getSideToMidDecibels(),
+                    r.getCorrelation(), t.getCorrelation(), m.getCorrelation(),
+                    static_cast<double>(result.match.bandWidthPercent[band]), result.match.bandCounts[band] ? "" : "  (too quiet, ignored)");
+    }
+
+    std::printf("\nwidth %.2f %%, mid/side %.2f: side/mid error %.2f dB -> %.2f dB RMS\n",
+                static_cast<double>(result.match.widthPercent), static_cast<double>(result.match.midSide),
+                result.match.errorBeforeDecibels, result.match.errorAfterDecibels);
+
+    if (args.contains("--dry-run"))
+        return 0;
+
+    setParameter(*processor->getWidthParam(), result.match.widthPercent);
+    setParameter(*processor->getMidSideParam(), result.match.midSide);
+
+    auto name = getOption("--name");
+
+    if (name.isEmpty())
+        name = "Match " + (referenceFiles.size() == 1 ? referenceFiles.getFirst().getFileNameWithoutExtension()
+                                                      : referenceFiles.getFirst().getParentDirectory().getFileName());
+
+    if (! processor->getPresetLibrary().savePreset(name, "reference match", processor->apvts.copyState()))
+    {
+        std::fprintf(stderr, "could not save the preset \"%s\"\n", name.toRawUTF8());
+        return 2;
+    }
+
+    std::printf("saved \"%s\" to %s\n", name.toRawUTF8(), processor->getPresetLibrary().getUserDirectory().getFullPathName().toRawUTF8());
+    return 0;
+}
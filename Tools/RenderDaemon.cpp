@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    RenderDaemon.cpp
+    Created: 20 Oct 2026 11:48:36pm
+    Author:  Adam Elhamami
+
+    Runs the imager as a local service (see RenderServer): other processes
+    open audio streams through RenderClient and get them processed by their
+    own ImaginationAudioProcessor, with no plugin host involved. Linux only.
+
+    Tools/RenderDaemon.jucer builds it, the same way as FrameBenchmark:
+
+        Projucer --resave Tools/RenderDaemon.jucer
+        make -C Tools/Builds/RenderDaemon/LinuxMakefile CONFIG=Release
+
+    Then:
+
+        ./imagination-render-daemon [--socket path] [--workers N]
+                                    [--pool 16] [--max-streams 1024]
+
+    Listens on $XDG_RUNTIME_DIR/imagination-render.sock by default (or in
+    /tmp) and runs until SIGINT or SIGTERM. Tools/RenderLoadTest.cpp drives
+    it with many concurrent streams.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RenderServer.h"
+
+#include <csignal>
+#include <cstdio>
+#include <pthread.h>
+#include <thread>
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    RenderServer::Options options;
+    options.socketPath = getOption("--socket");
+
+    if (auto value = getOption("--workers"); value.isNotEmpty())
+        options.numWorkers = juce::jmax(1, value.getIntValue());
+
+    if (auto value = getOption("--pool"); value.isNotEmpty())
+        options.poolSize = juce::jmax(0, value.getIntValue());
+
+    if (auto value = getOption("--max-streams"); value.isNotEmpty())
+        options.maxStreams = juce::jmax(1, value.getIntValue());
+
+    // Every thread started from here inherits the mask, so only the waiter below sees the signals
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    RenderServer server(options);
+    juce::String error;
+
+    if (! server.start(error))
+    {
+        std::fprintf(stderr, "%s\n", error.toRawUTF8());
+        return 2;
+    }
+
+    std::printf("listening on %s\n", options.socketPath.isNotEmpty() ? options.socketPath.toRawUTF8()
+                                                                    : ImaginationRender::getDefaultSocketPath().c_str());
+    std::fflush(stdout);
+
+    std::thread signalWaiter([&signals]
+    {
+        int received = 0;
+        sigwait(&signals, &received);
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    });
+
+    // Processors are created and destroyed under the message manager lock,
+    // so the main thread has to keep dispatching messages
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    signalWaiter.join();
+
+    std::printf("%d stream(s) open at exit, %llu blocks processed\n", server.getNumStreams(),
+                static_cast<unsigned long long>(server.getNumBlocksProcessed()));
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    RenderLoadTest.cpp
+    Created: 20 Oct 2026 11:59:04pm
+    Author:  Adam Elhamami
+
+    Load generator for the render daemon (Tools/RenderDaemon.cpp): opens
+    many concurrent streams through RenderClient and checks that every one
+    keeps up. Plain POSIX, no JUCE:
+
+        c++ -std=c++17 -O2 -pthread -I Source Source/RenderClient.cpp \
+            Tools/RenderLoadTest.cpp -o imagination-render-loadtest
+        ./imagination-render-loadtest [--streams 256] [--seconds 10]
+                                      [--block 256] [--rate 48000] [--slots 4]
+                                      [--threads 8] [--max-p99-ms 5.33]
+                                      [--unpaced] [--socket path]
+
+    Paced (the default), each stream submits one block per block period, as
+    a realtime source would. Latency is the round trip from submitting a
+    block to the client having it back. The run fails if any block is lost,
+    comes back non-finite, or the 99th percentile is over --max-p99-ms (one
+    block period unless given). With --unpaced every stream submits as fast
+    as the daemon returns blocks, which measures the machine's capacity in
+    realtime streams.
+
+  ==============================================================================
+*/
+
+#include "RenderClient.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadOptions
+{
+    int numStreams = 256;
+    double seconds = 10.0;
+    int blockSize = 256;
+    double sampleRate = 48000.0;
+    int numSlots = 4;
+    int numThreads = 0;
+    double maxP99Ms = 0.0;
+    bool paced = true;
+    std::string socketPath = ImaginationRender::getDefaultSocketPath();
+};
+
+struct DriverResult
+{
+    std::vector<float> latenciesMs;
+    long long numBlocks = 0;
+    long long numLost = 0;
+    long long numNonFinite = 0;
+    long long numLateTicks = 0;
+};
+
+struct LoadStream
+{
+    RenderClient client;
+    double phase = 0.0;
+    double increment = 0.0;
+    Clock::time_point submitted;
+};
+
+static double millisecondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// A sine per stream at its own frequency, so a block handed to the wrong stream would show
+static void fillBlock(LoadStream& stream, float* const* channels, int blockSize)
+{
+    for (int i = 0; i < blockSize; ++i)
+    {
+        const auto value = static_cast<float>(0.25 * std::sin(stream.phase));
+        channels[0][i] = value;
+        channels[1][i] = 0.5f * value;
+        stream.phase += stream.increment;
+    }
+
+    stream.phase = std::fmod(stream.phase, 2.0 * M_PI);
+}
+
+static bool isFinite(const float* const* channels, int blockSize)
+{
+    for (int channel = 0; channel < ImaginationRender::numChannels; ++channel)
+        for (int i = 0; i < blockSize; ++i)
+            if (! std::isfinite(channels[channel][i]))
+                return false;
+
+    return true;
+}
+
+static void runDriver(std::vector<LoadStream*> streams, const LoadOptions& options,
+                      Clock::time_point start, DriverResult& result)
+{
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.blockSize / options.sampleRate));
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+    auto nextTick = start;
+
+    result.latenciesMs.reserve(streams.size() * static_cast<size_t>(options.seconds * options.sampleRate / options.blockSize + 1));
+
+    while (Clock::now() < end)
+    {
+        if (options.paced)
+            std::this_thread::sleep_until(nextTick);
+
+        // Submit everyone's block first, so the daemon sees the whole tick at once
+        for (auto* stream : streams)
+        {
+            if (auto* const* channels = stream->client.beginBlock())
+            {
+                fillBlock(*stream, channels, options.blockSize);
+                stream->submitted = Clock::now();
+                stream->client.submitBlock();
+            }
+        }
+
+        for (auto* stream : streams)
+        {
+            if (stream->client.getNumBlocksInFlight() == 0)
+                continue;
+
+            const auto* const* processed = stream->client.waitForBlock(1000);
+
+            if (processed == nullptr)
+            {
+                ++result.numLost;
+                continue;
+            }
+
+            result.latenciesMs.push_back(static_cast<float>(millisecondsBetween(stream->submitted, Clock::now())));
+
+            if (! isFinite(processed, options.blockSize))
+                ++result.numNonFinite;
+
+            stream->client.releaseBlock();
+            ++result.numBlocks;
+        }
+
+        if (options.paced)
+        {
+            nextTick += period;
+
+            if (Clock::now() > nextTick)
+                ++result.numLateTicks;
+        }
+    }
+}
+
+static double percentile(const std::vector<float>& sorted, double fraction)
+{
+    if (sorted.empty())
+        return 0.0;
+
+    const auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+int main(int argc, char* argv[])
+{
+    LoadOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg == "--unpaced")                      options.paced = false;
+        else if (value == nullptr)                   { std::fprintf(stderr, "%s needs a value\n", arg.c_str()); return 2; }
+        else if (arg == "--streams")                 options.numStreams = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seconds")                 options.seconds = std::max(0.1, std::atof(argv[++i]));
+        else if (arg == "--block")                   options.blockSize = std::atoi(argv[++i]);
+        else if (arg == "--rate")                    options.sampleRate = std::atof(argv[++i]);
+        else if (arg == "--slots")                   options.numSlots = std::atoi(argv[++i]);
+        else if (arg == "--threads")                 options.numThreads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--max-p99-ms")              options.maxP99Ms = std::atof(argv[++i]);
+        else if (arg == "--socket")                  options.socketPath = argv[++i];
+        else                                         { std::fprintf(stderr, "unknown option %s\n", arg.c_str()); return 2; }
+    }
+
+    const double blockMs = 1000.0 * options.blockSize / options.sampleRate;
+
+    if (options.maxP99Ms <= 0.0)
+        options.maxP99Ms = blockMs;
+
+    if (options.numThreads <= 0)
+        options.numThreads = std::max(1, std::min(options.numStreams, static_cast<int>(std::thread::hardware_concurrency()) / 2));
+
+    // Open everything up front; the first few take processors from the daemon's pool, the rest are built
+    std::vector<std::unique_ptr<LoadStream>> streams;
+    const auto openStart = Clock::now();
+
+    for (int i = 0; i < options.numStreams; ++i)
+    {
+        auto stream = std::make_unique<LoadStream>();
+        stream->increment = 2.0 * M_PI * (110.0 + 7.0 * i) / options.sampleRate;
+
+        RenderClient::Options clientOptions;
+        clientOptions.socketPath = options.socketPath;
+        clientOptions.sampleRate = options.sampleRate;
+        clientOptions.blockSize = options.blockSize;
+        clientOptions.numSlots = options.numSlots;
+
+        std::string error;
+
+        if (! stream->client.open(clientOptions, error))
+        {
+            std::fprintf(stderr, "stream %d: %s\n", i + 1, error.c_str());
+            return 2;
+        }
+
+        streams.push_back(std::move(stream));
+    }
+
+    std::printf("opened %d stream(s) in %.1f ms; %d driver thread(s), %d-sample blocks (%.2f ms), %s\n",
+                options.numStreams, millisecondsBetween(openStart, Clock::now()), options.numThreads,
+                options.blockSize, blockMs, options.paced ? "paced" : "unpaced");
+
+    std::vector<DriverResult> results(static_cast<size_t>(options.numThreads));
+    std::vector<std::thread> drivers;
+    const auto start = Clock::now();
+
+    for (int t = 0; t < options.numThreads; ++t)
+    {
+        std::vector<LoadStream*> assigned;
+
+        for (int i = t; i < options.numStreams; i += options.numThreads)
+            assigned.push_back(streams[static_cast<size_t>(i)].get());
+
+        drivers.emplace_back(runDriver, std::move(assigned), std::cref(options), start, std::ref(results[static_cast<size_t>(t)]));
+    }
+
+    for (auto& driver : drivers)
+        driver.join();
+
+    const double elapsedSeconds = millisecondsBetween(start, Clock::now()) / 1000.0;
+
+    DriverResult total;
+
+    for (auto& result : results)
+    {
+        total.latenciesMs.insert(total.latenciesMs.end(), result.latenciesMs.begin(), result.latenciesMs.end());
+        total.numBlocks += result.numBlocks;
+        total.numLost += result.numLost;
+        total.numNonFinite += result.numNonFinite;
+        total.numLateTicks += result.numLateTicks;
+    }
+
+    std::sort(total.latenciesMs.begin(), total.latenciesMs.end());
+
+    const double p50 = percentile(total.latenciesMs, 0.5);
+    const double p99 = percentile(total.latenciesMs, 0.99);
+    const double worst = total.latenciesMs.empty() ? 0.0 : total.latenciesMs.back();
+    const double audioSeconds = static_cast<double>(total.numBlocks) * options.blockSize / options.sampleRate;
+    const double realtimeStreams = audioSeconds / elapsedSeconds;
+
+    std::printf("%lld blocks in %.2f s: %.1f streams' worth of realtime audio\n",
+                total.numBlocks, elapsedSeconds, realtimeStreams);
+    std::printf("round trip ms: p50 %.3f  p99 %.3f  max %.3f  (limit %.3f)\n", p50, p99, worst, options.maxP99Ms);
+    std::printf("lost %lld, non-finite %lld, late ticks %lld\n", total.numLost, total.numNonFinite, total.numLateTicks);
+
+    bool passed = total.numLost == 0 && total.numNonFinite == 0 && total.numBlocks > 0;
+
+    if (options.paced)
+        passed = passed && p99 <= options.maxP99Ms;
+
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    SegmentRender.cpp
+    Created: 20 Oct 2026 11:52:03am
+    Author:  Adam Elhamami
+
+    Offline render of one long file through the plugin, split into segments
+    that run in parallel on separate processor instances (see
+    SegmentRenderer). The result matches a serial render: seams are checked
+    against it, and the tool says so if any are not within tolerance.
+
+    Tools/SegmentRender.jucer builds it, the same way as FrameBenchmark:
+
+        Projucer --resave Tools/SegmentRender.jucer
+        make -C Tools/Builds/SegmentRender/LinuxMakefile CONFIG=Release
+
+    Then:
+
+        ./imagination-segment-render in.wav out.wav [--state preset.imgpreset]
+                                     [--segments 8] [--warm-up 0.5]
+                                     [--tolerance 1e-5]
+
+    Writes 32-bit float WAV. Exits with 1 if a seam could not be verified.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SegmentRenderer.h"
+#include "PresetLibrary.h"
+
+#include <cstdio>
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    auto getOption = [&args](const char* name) -> juce::String
+    {
+        const int index = args.indexOf(name);
+        return (index >= 0 && index + 1 < args.size()) ? args[index + 1] : juce::String();
+    };
+
+    if (args.size() < 2 || args[0].startsWith("--") || args[1].startsWith("--"))
+    {
+        std::fprintf(stderr, "usage: imagination-segment-render in.wav out.wav [--state preset%s] [--segments N]"
+                             " [--warm-up seconds] [--tolerance 1e-5]\n", PresetLibrary::fileExtension);
+        return 2;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto inputFile = cwd.getChildFile(args[0]);
+    const auto outputFile = cwd.getChildFile(args[1]);
+
+    SegmentRenderer::Options options;
+
+    if (auto value = getOption("--segments"); value.isNotEmpty())
+        options.numSegments = juce::jmax(1, value.getIntValue());
+
+    if (auto value = getOption("--warm-up"); value.isNotEmpty())
+        options.extraWarmUpSeconds = juce::jmax(0.0, value.getDoubleValue());
+
+    if (auto value = getOption("--tolerance"); value.isNotEmpty())
+        options.seamTolerance = value.getFloatValue();
+
+    // Presets store the parameter state as XML, the same tree the plugin saves
+    juce::ValueTree state;
+
+    if (auto path = getOption("--state"); path.isNotEmpty())
+    {
+        const auto xml = juce::parseXMLIfTagMatches(cwd.getChildFile(path), "ImaginationPreset");
+        const auto* parameters = xml != nullptr ? xml->getFirstChildElement() : nullptr;
+
+        if (parameters == nullptr)
+        {
+            std::fprintf(stderr, "could not read %s\n", path.toRawUTF8());
+            return 2;
+        }
+
+        state = juce::ValueTree::fromXml(*parameters);
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    auto openInput = [&formats, &inputFile]
+    {
+        return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(inputFile));
+    };
+
+    double sampleRate = 0.0;
+
+    if (auto reader = openInput())
+        sampleRate = reader->sampleRate;
+
+    if (sampleRate <= 0.0)
+    {
+        std::fprintf(stderr, "could not read %s\n", inputFile.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    outputFile.deleteFile();
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(outputFile.createOutputStream().release(), sampleRate, 2, 32, {}, 0));
+
+    if (writer == nullptr)
+    {
+        std::fprintf(stderr, "could not create %s\n", outputFile.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    SegmentRenderer renderer(state, options);
+    const auto result = renderer.render(openInput, *writer);
+    writer.reset();
+
+    if (! result.succeeded)
+    {
+        std::fprintf(stderr, "render failed: %s\n", result.error.toRawUTF8());
+        return 2;
+    }
+
+    for (const auto& seam : result.seams)
+        std::printf("seam at %10lld: max error %.3g, warm-up %d samples %s\n", static_cast<long long>(seam.position),
+                    static_cast<double>(seam.maxError), seam.warmUpSamples, seam.passed ? "ok" : "FAILED");
+
+    std::printf("%d segment(s) in %.2f s\n", static_cast<int>(result.seams.size()) + 1, result.elapsedSeconds);
+    return result.seamsVerified ? 0 : 1;
+}
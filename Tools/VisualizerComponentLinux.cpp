@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    VisualizerComponentLinux.cpp
+    Created: 21 Oct 2026 3:40:06am
+    Author:  Adam Elhamami
+
+    The Projucer's Linux exporter only compiles C and C++ files, and the
+    visualizer lives in a .mm for the plugin's Xcode build. It has no
+    Objective-C in it, so the tool projects that need it on Linux compile
+    it from here. On the Mac the .mm itself is compiled.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#if ! JUCE_MAC
+ #include "../Source/VisualizerComponent.mm"
+#endif